@@ -41,6 +41,57 @@ bool ST_AVCodecContext::OpenCodec(const AVCodec* codec, AVDictionary** options)
     return true;
 }
 
+void ST_AVCodecContext::SetThreadPolicy(const ST_DecodeThreadPolicy& policy)
+{
+    if (!m_pCodecContext)
+    {
+        return;
+    }
+
+    m_pCodecContext->thread_count = policy.m_threadCount > 0 ? policy.m_threadCount : 0;
+    if (policy.m_bLowLatency)
+    {
+        // 帧级并行会按线程数缓存帧，低延迟模式只允许片级并行
+        m_pCodecContext->thread_type = FF_THREAD_SLICE;
+        m_pCodecContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+        return;
+    }
+
+    switch (policy.m_threadType)
+    {
+        case EM_DecodeThreadType::Frame:
+            m_pCodecContext->thread_type = FF_THREAD_FRAME;
+            break;
+        case EM_DecodeThreadType::Slice:
+            m_pCodecContext->thread_type = FF_THREAD_SLICE;
+            break;
+        default:
+            m_pCodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+            break;
+    }
+}
+
+void ST_AVCodecContext::SetQualityHints(const AVCodec* codec, const ST_DecodeQualityHints& hints)
+{
+    if (!m_pCodecContext)
+    {
+        return;
+    }
+
+    int maxLowres = codec ? codec->max_lowres : 0;
+    m_pCodecContext->lowres = hints.m_lowres < 0 ? 0 : (hints.m_lowres > maxLowres ? maxLowres : hints.m_lowres);
+    m_pCodecContext->skip_loop_filter = hints.m_bSkipLoopFilter ? AVDISCARD_ALL : AVDISCARD_DEFAULT;
+    m_pCodecContext->skip_idct = hints.m_bSkipNonRefIDCT ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+    if (hints.m_bFastDecode)
+    {
+        m_pCodecContext->flags2 |= AV_CODEC_FLAG2_FAST;
+    }
+    else
+    {
+        m_pCodecContext->flags2 &= ~AV_CODEC_FLAG2_FAST;
+    }
+}
+
 void ST_AVCodecContext::FlushBuffer()
 {
     avcodec_flush_buffers(m_pCodecContext);
@@ -6,6 +6,37 @@ extern "C" {
 #include "libavcodec/codec_par.h"
 }
 
+/// <summary>
+/// 解码器多线程方式
+/// </summary>
+enum class EM_DecodeThreadType
+{
+    Auto,  /// 帧级和片级并行均允许，由解码器选择
+    Frame, /// 帧级并行：吞吐最高，每增加一个线程增加一帧解码延迟
+    Slice  /// 片级并行：不增加延迟，加速取决于码流的分片数
+};
+
+/// <summary>
+/// 解码器线程策略，需在打开解码器前设置
+/// </summary>
+struct ST_DecodeThreadPolicy
+{
+    int m_threadCount{0};                                        /// 线程数，0表示按CPU核数自动选择
+    EM_DecodeThreadType m_threadType{EM_DecodeThreadType::Auto}; /// 多线程方式
+    bool m_bLowLatency{false};                                   /// 低延迟模式：只使用片级并行并启用AV_CODEC_FLAG_LOW_DELAY，用于拖动预览和实时流
+};
+
+/// <summary>
+/// 解码降质选项，用于预览窗口等不需要完整画质的场景，需在打开解码器前设置
+/// </summary>
+struct ST_DecodeQualityHints
+{
+    int m_lowres{0};                  /// 降分辨率解码级别，每级宽高减半，超过解码器支持的级别时截断（H.264/HEVC等解码器不支持）
+    bool m_bSkipLoopFilter{false};    /// 跳过环路滤波（去块效应），H.264/HEVC解码提速明显，画面有块效应
+    bool m_bSkipNonRefIDCT{false};    /// 非参考帧跳过IDCT
+    bool m_bFastDecode{false};        /// 允许不符合规范的快速解码（AV_CODEC_FLAG2_FAST）
+};
+
 /// <summary>
 /// 音频编解码器上下文封装类
 /// </summary>
@@ -25,6 +56,19 @@ class ST_AVCodecContext
     /// 打开编解码器
     /// </summary>
     bool OpenCodec(const AVCodec* codec, AVDictionary** options = nullptr);
+
+    /// <summary>
+    /// 设置解码线程策略（需在OpenCodec之前调用）
+    /// </summary>
+    /// <param name="policy">线程策略</param>
+    void SetThreadPolicy(const ST_DecodeThreadPolicy& policy);
+
+    /// <summary>
+    /// 设置解码降质选项（需在OpenCodec之前调用）
+    /// </summary>
+    /// <param name="codec">解码器，用于确定支持的降分辨率级别</param>
+    /// <param name="hints">降质选项</param>
+    void SetQualityHints(const AVCodec* codec, const ST_DecodeQualityHints& hints);
     /// <summary>
     /// 获取剩余数据
     /// </summary>
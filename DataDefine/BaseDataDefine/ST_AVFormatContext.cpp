@@ -1,43 +1,115 @@
 ﻿#pragma once
 #include "ST_AVFormatContext.h"
 
+#include <QFileInfo>
 #include "LogSystem/LogSystem.h"
 #include "TimeSystem/TimeSystem.h"
 
+std::atomic<EM_InputIOMode> ST_AVFormatContext::s_defaultInputIOMode{EM_InputIOMode::Auto};
+
 ST_AVFormatContext::~ST_AVFormatContext()
+{
+    CloseInput();
+}
+
+ST_AVFormatContext::ST_AVFormatContext(ST_AVFormatContext&& other) noexcept
+    : m_pFormatCtx(other.m_pFormatCtx)
+    , m_readAheadIO(std::move(other.m_readAheadIO))
+    , m_mappedIO(std::move(other.m_mappedIO))
+{
+    other.m_pFormatCtx = nullptr;
+}
+
+void ST_AVFormatContext::CloseInput()
 {
     if (m_pFormatCtx)
     {
         avformat_close_input(&m_pFormatCtx);
         m_pFormatCtx = nullptr;
     }
+    // 自定义IO不会随格式上下文关闭，最后释放
+    m_readAheadIO.reset();
+    m_mappedIO.reset();
 }
 
-ST_AVFormatContext::ST_AVFormatContext(ST_AVFormatContext&& other) noexcept
-    : m_pFormatCtx(other.m_pFormatCtx)
+void ST_AVFormatContext::SetDefaultInputIOMode(EM_InputIOMode ioMode)
 {
-    other.m_pFormatCtx = nullptr;
+    s_defaultInputIOMode.store(ioMode);
 }
 
-ST_AVFormatContext& ST_AVFormatContext::operator=(ST_AVFormatContext&& other) noexcept
+EM_InputIOMode ST_AVFormatContext::GetDefaultInputIOMode()
 {
-    if (this != &other)
+    return s_defaultInputIOMode.load();
+}
+
+void ST_AVFormatContext::AttachCustomIO(const QString& filePath, EM_InputIOMode ioMode)
+{
+    if (ioMode == EM_InputIOMode::Auto)
+    {
+        ioMode = s_defaultInputIOMode.load();
+    }
+    if (ioMode == EM_InputIOMode::Auto)
     {
-        if (m_pFormatCtx)
+        // 网络驱动器、可移动介质上的映射缺页会阻塞读取线程且无法预读，只有本地固定磁盘使用内存映射，其余改用后台预读
+        ioMode = ST_MappedFileIO::IsLocalFixedDisk(filePath) ? EM_InputIOMode::MemoryMapped : EM_InputIOMode::ReadAhead;
+    }
+
+    AVIOContext* ioCtx = nullptr;
+    if (ioMode == EM_InputIOMode::MemoryMapped)
+    {
+        auto mappedIO = std::make_unique<ST_MappedFileIO>();
+        if (mappedIO->Open(filePath))
+        {
+            ioCtx = mappedIO->GetRawContext();
+            m_mappedIO = std::move(mappedIO);
+        }
+    }
+    else if (ioMode == EM_InputIOMode::ReadAhead && ST_ReadAheadIO::GetDefaultBufferSize() > 0)
+    {
+        auto readAheadIO = std::make_unique<ST_ReadAheadIO>(ST_ReadAheadIO::GetDefaultBufferSize());
+        if (readAheadIO->Open(filePath))
         {
-            avformat_close_input(&m_pFormatCtx);
+            ioCtx = readAheadIO->GetRawContext();
+            m_readAheadIO = std::move(readAheadIO);
         }
+    }
+
+    // 自定义IO创建失败时回退到FFmpeg默认的file协议
+    if (ioCtx)
+    {
+        m_pFormatCtx = avformat_alloc_context();
+        m_pFormatCtx->pb = ioCtx;
+        m_pFormatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+    }
+}
+
+ST_AVFormatContext& ST_AVFormatContext::operator=(ST_AVFormatContext&& other) noexcept
+{
+    if (this != &other)
+    {
+        CloseInput();
         m_pFormatCtx = other.m_pFormatCtx;
+        m_readAheadIO = std::move(other.m_readAheadIO);
+        m_mappedIO = std::move(other.m_mappedIO);
         other.m_pFormatCtx = nullptr;
     }
     return *this;
 }
 
-bool ST_AVFormatContext::OpenInputFilePath(const char* url, const AVInputFormat* fmt, AVDictionary** options)
+bool ST_AVFormatContext::OpenInputFilePath(const char* url, const AVInputFormat* fmt, AVDictionary** options, EM_InputIOMode ioMode)
 {
+    // 文件通过内存映射或后台预读读取，不经过read系统调用或不阻塞解码线程；设备和非文件地址仍由FFmpeg自行打开
+    if (!m_pFormatCtx && ioMode != EM_InputIOMode::FFmpegDefault && !(fmt && (fmt->flags & AVFMT_NOFILE)) && QFileInfo(QString::fromUtf8(url)).isFile())
+    {
+        AttachCustomIO(QString::fromUtf8(url), ioMode);
+    }
+
     int ret = avformat_open_input(&m_pFormatCtx, url, fmt, options);
     if (ret < 0)
     {
+        // 打开失败时格式上下文已被释放
+        m_readAheadIO.reset();
+        m_mappedIO.reset();
         char errbuf[1024] = {0};
         av_strerror(ret, errbuf, sizeof(errbuf));
         LOG_WARN("Failed to open device:" + std::string(errbuf));
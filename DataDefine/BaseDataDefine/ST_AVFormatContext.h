@@ -1,10 +1,25 @@
 ﻿#pragma once
+#include <atomic>
+#include <memory>
 #include <QString>
+#include "ST_MappedFileIO.h"
+#include "ST_ReadAheadIO.h"
 
 extern "C" {
 #include <libavformat/avformat.h>
 #include "libavutil/time.h"
 }
+
+/// <summary>
+/// 本地文件的输入IO方式
+/// </summary>
+enum class EM_InputIOMode
+{
+    Auto,          /// 使用全局设置；全局设置也为Auto时，网络路径使用预读，本地路径使用内存映射
+    FFmpegDefault, /// FFmpeg默认的file协议
+    ReadAhead,     /// 后台线程预读
+    MemoryMapped   /// 内存映射
+};
     /// <summary>
 /// 音频格式上下文封装类
 /// </summary>
@@ -23,13 +38,25 @@ class ST_AVFormatContext
     ST_AVFormatContext &operator=(ST_AVFormatContext &&other) noexcept;
 
     /// <summary>
-    /// 打开输入文件
+    /// 打开输入文件，本地文件通过带后台预读的AVIOContext读取
     /// </summary>
     /// <param name="url">文件路径</param>
     /// <param name="fmt">输入格式</param>
     /// <param name="options">选项字典</param>
+    /// <param name="ioMode">本地文件的输入IO方式</param>
     /// <returns>成功返回0，失败返回负值</returns>
-    bool OpenInputFilePath(const char* url, const AVInputFormat* fmt = nullptr, AVDictionary** options = nullptr);
+    bool OpenInputFilePath(const char* url, const AVInputFormat* fmt = nullptr, AVDictionary** options = nullptr, EM_InputIOMode ioMode = EM_InputIOMode::Auto);
+
+    /// <summary>
+    /// 设置本地文件默认的输入IO方式
+    /// </summary>
+    /// <param name="ioMode">输入IO方式</param>
+    static void SetDefaultInputIOMode(EM_InputIOMode ioMode);
+
+    /// <summary>
+    /// 获取本地文件默认的输入IO方式
+    /// </summary>
+    static EM_InputIOMode GetDefaultInputIOMode();
 
     /// <summary>
     /// 打开输出文件
@@ -79,6 +106,14 @@ class ST_AVFormatContext
         return m_pFormatCtx;
     }
 
+    /// <summary>
+    /// 获取预读IO上下文，用于读取统计；未使用预读时返回nullptr
+    /// </summary>
+    ST_ReadAheadIO *GetReadAheadIO() const
+    {
+        return m_readAheadIO.get();
+    }
+
     /// <summary>
     /// 打开文件
     /// </summary>
@@ -106,5 +141,22 @@ class ST_AVFormatContext
     /// <returns></returns>
     bool WriteFrame(AVPacket* packet);
 private:
+    /// <summary>
+    /// 释放格式上下文和自定义IO上下文
+    /// </summary>
+    void CloseInput();
+
+    /// <summary>
+    /// 为本地文件创建自定义IO上下文并分配使用它的格式上下文
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="ioMode">输入IO方式</param>
+    void AttachCustomIO(const QString& filePath, EM_InputIOMode ioMode);
+
+private:
+    static std::atomic<EM_InputIOMode> s_defaultInputIOMode; /// 本地文件默认的输入IO方式
+
     AVFormatContext *m_pFormatCtx = nullptr;
+    std::unique_ptr<ST_ReadAheadIO> m_readAheadIO; /// 本地文件的预读IO上下文，需在格式上下文关闭后释放
+    std::unique_ptr<ST_MappedFileIO> m_mappedIO;   /// 本地文件的内存映射IO上下文，需在格式上下文关闭后释放
 };
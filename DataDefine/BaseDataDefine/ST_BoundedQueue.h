@@ -0,0 +1,153 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/// <summary>
+/// 有界阻塞队列，用于流水线各阶段之间传递数据包和视频帧
+/// 队列满时生产者等待、队列空时消费者等待，等待均带超时，便于调用方在等待间隙处理seek和停止请求
+/// </summary>
+/// <typeparam name="T">元素类型，需支持移动</typeparam>
+template <typename T>
+class ST_BoundedQueue
+{
+  public:
+    /// <summary>
+    /// 构造函数
+    /// </summary>
+    /// <param name="capacity">容量（元素个数），至少为1</param>
+    explicit ST_BoundedQueue(size_t capacity = 1) : m_capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+
+    ~ST_BoundedQueue() = default;
+
+    ST_BoundedQueue(const ST_BoundedQueue &) = delete;
+    ST_BoundedQueue &operator=(const ST_BoundedQueue &) = delete;
+
+    /// <summary>
+    /// 设置容量，缩小时已有元素保留，直到被取走后才按新容量限制写入
+    /// </summary>
+    /// <param name="capacity">容量（元素个数），至少为1</param>
+    void SetCapacity(size_t capacity)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_capacity = capacity > 0 ? capacity : 1;
+        }
+        m_notFull.notify_all();
+    }
+
+    /// <summary>
+    /// 写入元素，队列满时最多等待timeoutMs毫秒
+    /// </summary>
+    /// <param name="item">元素，写入成功时被移入队列，失败时保持不变</param>
+    /// <param name="timeoutMs">等待超时（毫秒）</param>
+    /// <returns>是否写入成功，超时或队列已中止时返回false</returns>
+    bool Push(T &item, int timeoutMs)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            bool bReady = m_notFull.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]()
+            {
+                return m_bAborted || m_items.size() < m_capacity;
+            });
+            if (!bReady || m_bAborted)
+            {
+                return false;
+            }
+            m_items.push_back(std::move(item));
+        }
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    /// <summary>
+    /// 取出元素，队列空时最多等待timeoutMs毫秒
+    /// </summary>
+    /// <param name="item">输出元素</param>
+    /// <param name="timeoutMs">等待超时（毫秒），0表示不等待</param>
+    /// <returns>是否取到元素，超时或队列已中止时返回false</returns>
+    bool Pop(T &item, int timeoutMs)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            bool bReady = m_notEmpty.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]()
+            {
+                return m_bAborted || !m_items.empty();
+            });
+            if (!bReady || m_bAborted)
+            {
+                return false;
+            }
+            item = std::move(m_items.front());
+            m_items.pop_front();
+        }
+        m_notFull.notify_one();
+        return true;
+    }
+
+    /// <summary>
+    /// 清空队列并唤醒等待写入的生产者
+    /// </summary>
+    void Clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_items.clear();
+        }
+        m_notFull.notify_all();
+    }
+
+    /// <summary>
+    /// 中止队列：唤醒所有等待方，之后的Push/Pop立即返回false，直到调用Reset
+    /// </summary>
+    void Abort()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bAborted = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    /// <summary>
+    /// 清空队列并解除中止状态
+    /// </summary>
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_items.clear();
+        m_bAborted = false;
+    }
+
+    /// <summary>
+    /// 获取当前元素个数
+    /// </summary>
+    size_t GetSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.size();
+    }
+
+    /// <summary>
+    /// 获取容量
+    /// </summary>
+    size_t GetCapacity() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+  private:
+    mutable std::mutex m_mutex;            /// 队列互斥锁
+    std::condition_variable m_notFull;     /// 队列有空位
+    std::condition_variable m_notEmpty;    /// 队列有元素
+    std::deque<T> m_items;                 /// 队列元素
+    size_t m_capacity{1};                  /// 容量（元素个数）
+    bool m_bAborted{false};                /// 是否已中止
+};
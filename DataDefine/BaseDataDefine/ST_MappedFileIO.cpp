@@ -0,0 +1,192 @@
+#include "ST_MappedFileIO.h"
+
+#include <algorithm>
+#include <cstring>
+#include <QDir>
+#include <QFileInfo>
+#include <QStorageInfo>
+#include "LogSystem/LogSystem.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+extern "C"
+{
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+ST_MappedFileIO::~ST_MappedFileIO()
+{
+    Close();
+}
+
+bool ST_MappedFileIO::IsLocalFixedDisk(const QString &filePath)
+{
+    const QString absolutePath = QFileInfo(filePath).absoluteFilePath();
+#ifdef _WIN32
+    // 取文件所在卷的根路径（盘符、挂载点或UNC共享根），只有DRIVE_FIXED是本地固定磁盘
+    const std::wstring nativePath = QDir::toNativeSeparators(absolutePath).toStdWString();
+    wchar_t volumePath[MAX_PATH]{0};
+    if (!GetVolumePathNameW(nativePath.c_str(), volumePath, MAX_PATH))
+    {
+        return false;
+    }
+    return GetDriveTypeW(volumePath) == DRIVE_FIXED;
+#else
+    // NFS、CIFS等网络文件系统的设备名不是块设备路径
+    const QStorageInfo storage(absolutePath);
+    return storage.isValid() && storage.device().startsWith("/dev/");
+#endif
+}
+
+bool ST_MappedFileIO::Open(const QString &filePath)
+{
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        LOG_WARN("ST_MappedFileIO::Open() : Failed to open file: " + filePath.toStdString());
+        return false;
+    }
+
+    m_fileSize = m_file.size();
+    m_mapped = (m_fileSize > 0) ? m_file.map(0, m_fileSize) : nullptr;
+    if (!m_mapped)
+    {
+        LOG_WARN("ST_MappedFileIO::Open() : Failed to map file: " + filePath.toStdString());
+        Close();
+        return false;
+    }
+
+#ifndef _WIN32
+    // 解复用基本按顺序读取，提示内核加大预读
+    madvise(m_mapped, static_cast<size_t>(m_fileSize), MADV_SEQUENTIAL);
+#endif
+    AdviseWillNeed(0, WILLNEED_WINDOW_SIZE);
+
+    auto *ioBuffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
+    if (!ioBuffer)
+    {
+        Close();
+        return false;
+    }
+    m_ioCtx = avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 0, this, &ST_MappedFileIO::ReadPacket, nullptr, &ST_MappedFileIO::SeekPacket);
+    if (!m_ioCtx)
+    {
+        av_free(ioBuffer);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ST_MappedFileIO::Close()
+{
+    if (m_ioCtx)
+    {
+        av_freep(&m_ioCtx->buffer);
+        avio_context_free(&m_ioCtx);
+    }
+    if (m_mapped)
+    {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+}
+
+int ST_MappedFileIO::ReadPacket(void *opaque, uint8_t *buf, int bufSize)
+{
+    return static_cast<ST_MappedFileIO *>(opaque)->Read(buf, bufSize);
+}
+
+int64_t ST_MappedFileIO::SeekPacket(void *opaque, int64_t offset, int whence)
+{
+    return static_cast<ST_MappedFileIO *>(opaque)->Seek(offset, whence);
+}
+
+int ST_MappedFileIO::Read(uint8_t *buf, int bufSize)
+{
+    if (m_position >= m_fileSize)
+    {
+        return AVERROR_EOF;
+    }
+
+    // 读取位置进入已请求范围的后半段时，请求调入下一个窗口
+    if (m_position + WILLNEED_WINDOW_SIZE / 2 >= m_adviseEnd)
+    {
+        AdviseWillNeed(m_adviseEnd, WILLNEED_WINDOW_SIZE);
+    }
+
+    const int bytes = static_cast<int>(std::min<int64_t>(bufSize, m_fileSize - m_position));
+    memcpy(buf, m_mapped + m_position, static_cast<size_t>(bytes));
+    m_position += bytes;
+    return bytes;
+}
+
+int64_t ST_MappedFileIO::Seek(int64_t offset, int whence)
+{
+    if (whence & AVSEEK_SIZE)
+    {
+        return m_fileSize;
+    }
+
+    int64_t target = offset;
+    switch (whence & ~AVSEEK_FORCE)
+    {
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        target = m_position + offset;
+        break;
+    case SEEK_END:
+        target = m_fileSize + offset;
+        break;
+    default:
+        return AVERROR(EINVAL);
+    }
+
+    if (target < 0)
+    {
+        return AVERROR(EINVAL);
+    }
+
+    // 跳出已请求范围时，提前调入目标附近的页面，避免seek后首次读取逐页缺页
+    if (target < m_adviseEnd - WILLNEED_WINDOW_SIZE || target >= m_adviseEnd)
+    {
+        const int64_t adviseStart = std::max<int64_t>(target - SEEK_BACK_MARGIN, 0);
+        m_adviseEnd = adviseStart;
+        AdviseWillNeed(adviseStart, WILLNEED_WINDOW_SIZE);
+    }
+    m_position = target;
+    return target;
+}
+
+void ST_MappedFileIO::AdviseWillNeed(int64_t offset, int64_t length)
+{
+    if (offset >= m_fileSize || length <= 0)
+    {
+        return;
+    }
+
+    const int64_t end = std::min(offset + length, m_fileSize);
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = m_mapped + offset;
+    range.NumberOfBytes = static_cast<SIZE_T>(end - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // madvise要求起始地址按页对齐，映射起始地址本身按页对齐
+    static const int64_t pageSize = sysconf(_SC_PAGESIZE);
+    const int64_t alignedOffset = offset - offset % pageSize;
+    madvise(m_mapped + alignedOffset, static_cast<size_t>(end - alignedOffset), MADV_WILLNEED);
+#endif
+    m_adviseEnd = end;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <QFile>
+#include <QString>
+
+extern "C"
+{
+#include <libavformat/avio.h>
+}
+
+/// <summary>
+/// 基于内存映射的文件AVIOContext
+/// 整个文件映射到地址空间，读取只是从映射区拷贝到AVIOContext缓冲区，没有read系统调用；
+/// 按顺序访问提示内核预读，并在读取位置前方和seek目标附近提前请求调入页面
+/// </summary>
+class ST_MappedFileIO
+{
+  public:
+    ST_MappedFileIO() = default;
+
+    /// <summary>
+    /// 析构函数，释放AVIOContext并取消映射
+    /// </summary>
+    ~ST_MappedFileIO();
+
+    ST_MappedFileIO(const ST_MappedFileIO &) = delete;
+    ST_MappedFileIO &operator=(const ST_MappedFileIO &) = delete;
+
+    /// <summary>
+    /// 打开并映射文件，创建AVIOContext
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <returns>是否成功</returns>
+    bool Open(const QString &filePath);
+
+    /// <summary>
+    /// 判断文件是否位于本地固定磁盘；映射网络驱动器、UNC共享、可移动介质等缺页会长时间阻塞读取线程，不适合内存映射
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <returns>是否位于本地固定磁盘，无法判断时返回false</returns>
+    static bool IsLocalFixedDisk(const QString &filePath);
+
+    /// <summary>
+    /// 获取AVIOContext，供格式上下文以AVFMT_FLAG_CUSTOM_IO方式使用
+    /// </summary>
+    AVIOContext *GetRawContext() const
+    {
+        return m_ioCtx;
+    }
+
+  private:
+    /// <summary>
+    /// AVIOContext读取回调
+    /// </summary>
+    static int ReadPacket(void *opaque, uint8_t *buf, int bufSize);
+
+    /// <summary>
+    /// AVIOContext定位回调
+    /// </summary>
+    static int64_t SeekPacket(void *opaque, int64_t offset, int whence);
+
+    /// <summary>
+    /// 从映射区拷贝数据，读取位置接近已请求调入的范围末尾时请求下一个窗口
+    /// </summary>
+    int Read(uint8_t *buf, int bufSize);
+
+    /// <summary>
+    /// 定位读取位置并请求调入目标附近的页面
+    /// </summary>
+    int64_t Seek(int64_t offset, int whence);
+
+    /// <summary>
+    /// 请求内核提前调入指定范围的页面，按页对齐
+    /// </summary>
+    /// <param name="offset">起始偏移</param>
+    /// <param name="length">长度（字节）</param>
+    void AdviseWillNeed(int64_t offset, int64_t length);
+
+    /// <summary>
+    /// 释放AVIOContext并取消映射
+    /// </summary>
+    void Close();
+
+  private:
+    static const int IO_BUFFER_SIZE{64 * 1024};             /// AVIOContext内部缓冲区大小
+    static const int64_t WILLNEED_WINDOW_SIZE{4 * 1024 * 1024}; /// 每次请求调入的窗口大小
+    static const int64_t SEEK_BACK_MARGIN{64 * 1024};       /// seek时目标之前一并调入的字节数（解复用常回退读取索引）
+
+    QFile m_file;                                           /// 映射的文件
+    uchar *m_mapped{nullptr};                               /// 映射起始地址
+    int64_t m_fileSize{0};                                  /// 文件大小
+    int64_t m_position{0};                                  /// 读取位置
+    int64_t m_adviseEnd{0};                                 /// 已请求调入范围的末尾
+    AVIOContext *m_ioCtx{nullptr};                          /// AVIOContext
+};
@@ -0,0 +1,110 @@
+#include "ST_PCMRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+void ST_PCMRingBuffer::Init(size_t capacity)
+{
+    if (m_buffer.size() != capacity)
+    {
+        m_buffer.assign(capacity, 0);
+    }
+    Clear();
+}
+
+size_t ST_PCMRingBuffer::Write(const uint8_t *data, size_t size)
+{
+    const size_t capacity = m_buffer.size();
+    if (!data || size == 0 || capacity == 0)
+    {
+        return 0;
+    }
+
+    const size_t writePos = m_writePos.load(std::memory_order_relaxed);
+    const size_t readPos = m_readPos.load(std::memory_order_acquire);
+    const size_t toWrite = std::min(size, capacity - (writePos - readPos));
+    if (toWrite == 0)
+    {
+        return 0;
+    }
+
+    // 环形写入，必要时分两段拷贝
+    const size_t offset = writePos % capacity;
+    const size_t firstPart = std::min(toWrite, capacity - offset);
+    memcpy(m_buffer.data() + offset, data, firstPart);
+    if (toWrite > firstPart)
+    {
+        memcpy(m_buffer.data(), data + firstPart, toWrite - firstPart);
+    }
+
+    m_writePos.store(writePos + toWrite, std::memory_order_release);
+    return toWrite;
+}
+
+uint8_t *ST_PCMRingBuffer::GetWriteSpan(size_t &contiguousBytes)
+{
+    const size_t capacity = m_buffer.size();
+    if (capacity == 0)
+    {
+        contiguousBytes = 0;
+        return nullptr;
+    }
+
+    const size_t writePos = m_writePos.load(std::memory_order_relaxed);
+    const size_t readPos = m_readPos.load(std::memory_order_acquire);
+    const size_t offset = writePos % capacity;
+    contiguousBytes = std::min(capacity - (writePos - readPos), capacity - offset);
+    return m_buffer.data() + offset;
+}
+
+void ST_PCMRingBuffer::CommitWrite(size_t size)
+{
+    m_writePos.store(m_writePos.load(std::memory_order_relaxed) + size, std::memory_order_release);
+}
+
+size_t ST_PCMRingBuffer::Read(uint8_t *data, size_t size)
+{
+    const size_t capacity = m_buffer.size();
+    if (!data || size == 0 || capacity == 0)
+    {
+        return 0;
+    }
+
+    const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+    const size_t writePos = m_writePos.load(std::memory_order_acquire);
+    const size_t toRead = std::min(size, writePos - readPos);
+    if (toRead == 0)
+    {
+        return 0;
+    }
+
+    // 环形读取，必要时分两段拷贝
+    const size_t offset = readPos % capacity;
+    const size_t firstPart = std::min(toRead, capacity - offset);
+    memcpy(data, m_buffer.data() + offset, firstPart);
+    if (toRead > firstPart)
+    {
+        memcpy(data + firstPart, m_buffer.data(), toRead - firstPart);
+    }
+
+    m_readPos.store(readPos + toRead, std::memory_order_release);
+    return toRead;
+}
+
+void ST_PCMRingBuffer::Clear()
+{
+    m_readPos.store(0, std::memory_order_release);
+    m_writePos.store(0, std::memory_order_release);
+}
+
+size_t ST_PCMRingBuffer::GetReadableBytes() const
+{
+    // 先读取消费位置，保证差值不会为负
+    const size_t readPos = m_readPos.load(std::memory_order_acquire);
+    return m_writePos.load(std::memory_order_acquire) - readPos;
+}
+
+size_t ST_PCMRingBuffer::GetWritableBytes() const
+{
+    return m_buffer.size() - GetReadableBytes();
+}
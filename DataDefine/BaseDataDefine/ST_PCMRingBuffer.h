@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 单生产者/单消费者无锁PCM环形缓冲区
+/// 生产者（解码线程）只调用Write，消费者（SDL音频回调）只调用Read，两端均不加锁、不分配内存
+/// </summary>
+class ST_PCMRingBuffer
+{
+  public:
+    ST_PCMRingBuffer() = default;
+    ~ST_PCMRingBuffer() = default;
+
+    ST_PCMRingBuffer(const ST_PCMRingBuffer &) = delete;
+    ST_PCMRingBuffer &operator=(const ST_PCMRingBuffer &) = delete;
+
+    /// <summary>
+    /// 预分配缓冲区，容量不变时复用已有内存（需在生产者和消费者均未运行时调用）
+    /// </summary>
+    /// <param name="capacity">容量（字节）</param>
+    void Init(size_t capacity);
+
+    /// <summary>
+    /// 写入数据（仅生产者线程调用）
+    /// </summary>
+    /// <param name="data">数据指针</param>
+    /// <param name="size">数据长度（字节）</param>
+    /// <returns>实际写入的字节数，空间不足时可能小于size</returns>
+    size_t Write(const uint8_t *data, size_t size);
+
+    /// <summary>
+    /// 获取写入位置起的连续可写空间，供调用方直接写入后用CommitWrite提交（仅生产者线程调用）
+    /// </summary>
+    /// <param name="contiguousBytes">连续可写的字节数，到缓冲区末尾回绕处为止</param>
+    /// <returns>写入位置的指针</returns>
+    uint8_t *GetWriteSpan(size_t &contiguousBytes);
+
+    /// <summary>
+    /// 提交直接写入GetWriteSpan空间的数据（仅生产者线程调用）
+    /// </summary>
+    /// <param name="size">写入的字节数，不超过GetWriteSpan返回的连续可写字节数</param>
+    void CommitWrite(size_t size);
+
+    /// <summary>
+    /// 读取数据（仅消费者线程调用）
+    /// </summary>
+    /// <param name="data">输出缓冲区</param>
+    /// <param name="size">期望读取的字节数</param>
+    /// <returns>实际读取的字节数</returns>
+    size_t Read(uint8_t *data, size_t size);
+
+    /// <summary>
+    /// 清空缓冲区（需保证生产者和消费者此时均未访问缓冲区）
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 获取可读字节数
+    /// </summary>
+    size_t GetReadableBytes() const;
+
+    /// <summary>
+    /// 获取可写字节数
+    /// </summary>
+    size_t GetWritableBytes() const;
+
+    /// <summary>
+    /// 获取累计读取位置（字节），Clear后归零
+    /// </summary>
+    size_t GetReadPosition() const
+    {
+        return m_readPos.load(std::memory_order_acquire);
+    }
+
+    /// <summary>
+    /// 获取累计写入位置（字节），Clear后归零
+    /// </summary>
+    size_t GetWritePosition() const
+    {
+        return m_writePos.load(std::memory_order_acquire);
+    }
+
+    /// <summary>
+    /// 获取缓冲区容量（字节）
+    /// </summary>
+    size_t GetCapacity() const
+    {
+        return m_buffer.size();
+    }
+
+  private:
+    std::vector<uint8_t> m_buffer;         /// 数据存储
+    std::atomic<size_t> m_readPos{0};      /// 累计读取位置（仅消费者写）
+    std::atomic<size_t> m_writePos{0};     /// 累计写入位置（仅生产者写）
+};
@@ -0,0 +1,261 @@
+#include "ST_ReadAheadIO.h"
+
+#include <algorithm>
+#include <cstring>
+#include "CoreServerGlobal.h"
+#include "LogSystem/LogSystem.h"
+
+extern "C"
+{
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+std::atomic<size_t> ST_ReadAheadIO::s_defaultBufferSize{8 * 1024 * 1024};
+
+ST_ReadAheadIO::ST_ReadAheadIO(size_t bufferSize)
+{
+    m_buffer.resize(bufferSize < MIN_BUFFER_SIZE ? static_cast<size_t>(MIN_BUFFER_SIZE) : bufferSize);
+}
+
+ST_ReadAheadIO::~ST_ReadAheadIO()
+{
+    Close();
+}
+
+bool ST_ReadAheadIO::Open(const QString &filePath)
+{
+    m_filePath = filePath;
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        LOG_WARN("Read-ahead IO failed to open file: " + filePath.toStdString());
+        return false;
+    }
+    m_fileSize = m_file.size();
+
+    auto *ioBuffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
+    if (!ioBuffer)
+    {
+        return false;
+    }
+    m_ioCtx = avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 0, this, &ST_ReadAheadIO::ReadPacket, nullptr, &ST_ReadAheadIO::SeekPacket);
+    if (!m_ioCtx)
+    {
+        av_free(ioBuffer);
+        return false;
+    }
+
+    m_threadId = CoreServerGlobal::Instance().GetThreadPool().CreateDedicatedThread("ReadAheadIOThread", [this]()
+    {
+        PrefetchLoop();
+    });
+    m_bHasThread = true;
+    return true;
+}
+
+void ST_ReadAheadIO::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop.store(true);
+    }
+    m_dataCond.notify_all();
+    m_spaceCond.notify_all();
+    if (m_bHasThread)
+    {
+        CoreServerGlobal::Instance().GetThreadPool().StopDedicatedThread(m_threadId);
+        m_bHasThread = false;
+    }
+
+    if (m_ioCtx)
+    {
+        av_freep(&m_ioCtx->buffer);
+        avio_context_free(&m_ioCtx);
+        LOG_INFO("Read-ahead IO closed: " + m_filePath.toStdString() + ", bytes read: " + std::to_string(GetBytesRead()) + ", stalls: " + std::to_string(GetStallCount()) + ", hit ratio: " + std::to_string(GetHitRatio()) + ", seek invalidations: " + std::to_string(m_seekInvalidations.load()));
+    }
+    m_file.close();
+}
+
+double ST_ReadAheadIO::GetHitRatio() const
+{
+    const uint64_t readCount = m_readCount.load();
+    if (readCount == 0)
+    {
+        return 1.0;
+    }
+    return static_cast<double>(readCount - m_stallCount.load()) / readCount;
+}
+
+void ST_ReadAheadIO::SetDefaultBufferSize(size_t bufferSize)
+{
+    s_defaultBufferSize.store(bufferSize);
+    LOG_INFO("Read-ahead IO buffer size set to " + std::to_string(bufferSize) + " bytes");
+}
+
+size_t ST_ReadAheadIO::GetDefaultBufferSize()
+{
+    return s_defaultBufferSize.load();
+}
+
+int ST_ReadAheadIO::ReadPacket(void *opaque, uint8_t *buf, int bufSize)
+{
+    return static_cast<ST_ReadAheadIO *>(opaque)->Read(buf, bufSize);
+}
+
+int64_t ST_ReadAheadIO::SeekPacket(void *opaque, int64_t offset, int whence)
+{
+    return static_cast<ST_ReadAheadIO *>(opaque)->Seek(offset, whence);
+}
+
+int ST_ReadAheadIO::Read(uint8_t *buf, int bufSize)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_readCount;
+    if (m_bufferedBytes == 0 && !m_bEOF && !m_bError)
+    {
+        // 缓冲区已取空，解复用需要等待文件读取
+        ++m_stallCount;
+        m_dataCond.wait(lock, [this]()
+        {
+            return m_bStop.load() || m_bufferedBytes > 0 || m_bEOF || m_bError;
+        });
+    }
+
+    if (m_bufferedBytes == 0)
+    {
+        if (m_bStop.load())
+        {
+            return AVERROR_EXIT;
+        }
+        return m_bError ? AVERROR(EIO) : AVERROR_EOF;
+    }
+
+    // 环形缓冲区可能在结尾处回绕，分两段拷贝
+    const size_t bytes = std::min(m_bufferedBytes, static_cast<size_t>(bufSize));
+    const size_t firstPart = std::min(bytes, m_buffer.size() - m_bufferHead);
+    memcpy(buf, m_buffer.data() + m_bufferHead, firstPart);
+    memcpy(buf + firstPart, m_buffer.data(), bytes - firstPart);
+    Discard(bytes);
+    lock.unlock();
+
+    m_spaceCond.notify_one();
+    return static_cast<int>(bytes);
+}
+
+int64_t ST_ReadAheadIO::Seek(int64_t offset, int whence)
+{
+    if (whence & AVSEEK_SIZE)
+    {
+        return m_fileSize;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    int64_t target = offset;
+    switch (whence & ~AVSEEK_FORCE)
+    {
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        target = m_readPosition + offset;
+        break;
+    case SEEK_END:
+        target = m_fileSize + offset;
+        break;
+    default:
+        return AVERROR(EINVAL);
+    }
+
+    if (target < 0)
+    {
+        return AVERROR(EINVAL);
+    }
+
+    if (target >= m_readPosition && target <= m_readPosition + static_cast<int64_t>(m_bufferedBytes))
+    {
+        // 目标已在缓冲范围内，丢弃之前的数据即可
+        Discard(static_cast<size_t>(target - m_readPosition));
+    }
+    else
+    {
+        // 超出缓冲范围：清空缓冲区，IO线程从新位置重新预读，正在进行的读取结果作废
+        ++m_fetchGeneration;
+        ++m_seekInvalidations;
+        m_bufferHead = 0;
+        m_bufferedBytes = 0;
+        m_readPosition = target;
+        m_fetchPosition = target;
+        m_bEOF = target >= m_fileSize;
+        m_bError = false;
+    }
+    lock.unlock();
+
+    m_spaceCond.notify_one();
+    return target;
+}
+
+void ST_ReadAheadIO::Discard(size_t bytes)
+{
+    m_bufferHead = (m_bufferHead + bytes) % m_buffer.size();
+    m_bufferedBytes -= bytes;
+    m_readPosition += static_cast<int64_t>(bytes);
+}
+
+void ST_ReadAheadIO::PrefetchLoop()
+{
+    std::vector<uint8_t> chunk(PREFETCH_CHUNK_SIZE);
+    while (!m_bStop.load())
+    {
+        int64_t fetchPosition = 0;
+        uint64_t fetchGeneration = 0;
+        size_t bytesToRead = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_spaceCond.wait(lock, [this]()
+            {
+                return m_bStop.load() || (!m_bEOF && !m_bError && m_buffer.size() - m_bufferedBytes >= PREFETCH_CHUNK_SIZE);
+            });
+            if (m_bStop.load())
+            {
+                break;
+            }
+            fetchPosition = m_fetchPosition;
+            fetchGeneration = m_fetchGeneration;
+            bytesToRead = chunk.size();
+        }
+
+        // 文件读取不持有锁，读取方可同时从缓冲区取数据
+        qint64 bytesRead = -1;
+        if (m_file.pos() == fetchPosition || m_file.seek(fetchPosition))
+        {
+            bytesRead = m_file.read(reinterpret_cast<char *>(chunk.data()), static_cast<qint64>(bytesToRead));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (fetchGeneration != m_fetchGeneration)
+            {
+                continue;
+            }
+
+            if (bytesRead < 0)
+            {
+                LOG_WARN("Read-ahead IO failed to read file: " + m_filePath.toStdString() + ", " + m_file.errorString().toStdString());
+                m_bError = true;
+            }
+            else
+            {
+                const size_t bytes = static_cast<size_t>(bytesRead);
+                const size_t tail = (m_bufferHead + m_bufferedBytes) % m_buffer.size();
+                const size_t firstPart = std::min(bytes, m_buffer.size() - tail);
+                memcpy(m_buffer.data() + tail, chunk.data(), firstPart);
+                memcpy(m_buffer.data(), chunk.data() + firstPart, bytes - firstPart);
+                m_bufferedBytes += bytes;
+                m_fetchPosition += bytesRead;
+                m_bytesRead += bytes;
+                m_bEOF = bytesRead == 0 || m_fetchPosition >= m_fileSize;
+            }
+        }
+        m_dataCond.notify_one();
+    }
+}
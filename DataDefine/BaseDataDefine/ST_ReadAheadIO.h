@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <QFile>
+#include <QString>
+
+extern "C"
+{
+#include <libavformat/avio.h>
+}
+
+/// <summary>
+/// 带后台预读的文件AVIOContext
+/// 后台IO线程按顺序把文件读入环形缓冲区，解复用只从内存取数据；seek落在已缓冲范围内时直接前移，否则清空并从新位置重新预读
+/// </summary>
+class ST_ReadAheadIO
+{
+  public:
+    /// <summary>
+    /// 构造函数
+    /// </summary>
+    /// <param name="bufferSize">预读缓冲区大小（字节），不足MIN_BUFFER_SIZE时按MIN_BUFFER_SIZE分配</param>
+    explicit ST_ReadAheadIO(size_t bufferSize);
+
+    /// <summary>
+    /// 析构函数，停止IO线程并释放AVIOContext
+    /// </summary>
+    ~ST_ReadAheadIO();
+
+    ST_ReadAheadIO(const ST_ReadAheadIO &) = delete;
+    ST_ReadAheadIO &operator=(const ST_ReadAheadIO &) = delete;
+
+    /// <summary>
+    /// 打开文件、创建AVIOContext并启动IO线程
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <returns>是否成功</returns>
+    bool Open(const QString &filePath);
+
+    /// <summary>
+    /// 获取AVIOContext，供格式上下文以AVFMT_FLAG_CUSTOM_IO方式使用
+    /// </summary>
+    AVIOContext *GetRawContext() const
+    {
+        return m_ioCtx;
+    }
+
+    /// <summary>
+    /// 获取从文件读取的字节数
+    /// </summary>
+    uint64_t GetBytesRead() const
+    {
+        return m_bytesRead.load();
+    }
+
+    /// <summary>
+    /// 获取读取时缓冲区为空、需要等待IO线程的次数
+    /// </summary>
+    uint64_t GetStallCount() const
+    {
+        return m_stallCount.load();
+    }
+
+    /// <summary>
+    /// 获取读取命中率：无需等待即可从缓冲区取到数据的读取次数占比
+    /// </summary>
+    double GetHitRatio() const;
+
+    /// <summary>
+    /// 设置新打开文件的预读缓冲区大小（字节），0表示不使用预读
+    /// </summary>
+    /// <param name="bufferSize">缓冲区大小</param>
+    static void SetDefaultBufferSize(size_t bufferSize);
+
+    /// <summary>
+    /// 获取新打开文件的预读缓冲区大小（字节）
+    /// </summary>
+    static size_t GetDefaultBufferSize();
+
+  private:
+    /// <summary>
+    /// AVIOContext读取回调
+    /// </summary>
+    static int ReadPacket(void *opaque, uint8_t *buf, int bufSize);
+
+    /// <summary>
+    /// AVIOContext定位回调
+    /// </summary>
+    static int64_t SeekPacket(void *opaque, int64_t offset, int whence);
+
+    /// <summary>
+    /// 从环形缓冲区读取数据，缓冲区为空时等待IO线程
+    /// </summary>
+    /// <param name="buf">输出缓冲区</param>
+    /// <param name="bufSize">期望读取的字节数</param>
+    /// <returns>读取的字节数，文件结束返回AVERROR_EOF</returns>
+    int Read(uint8_t *buf, int bufSize);
+
+    /// <summary>
+    /// 定位读取位置，目标不在已缓冲范围内时清空缓冲区并通知IO线程从新位置预读
+    /// </summary>
+    /// <returns>新的读取位置，AVSEEK_SIZE时返回文件大小</returns>
+    int64_t Seek(int64_t offset, int whence);
+
+    /// <summary>
+    /// 丢弃缓冲区开头的数据（调用方需持有m_mutex）
+    /// </summary>
+    /// <param name="bytes">丢弃的字节数</param>
+    void Discard(size_t bytes);
+
+    /// <summary>
+    /// IO线程循环：缓冲区有空闲时从文件读取下一块
+    /// </summary>
+    void PrefetchLoop();
+
+    /// <summary>
+    /// 停止IO线程、释放AVIOContext并输出统计
+    /// </summary>
+    void Close();
+
+  private:
+    static const size_t PREFETCH_CHUNK_SIZE{256 * 1024}; /// IO线程单次读取的字节数
+    static const size_t MIN_BUFFER_SIZE{4 * PREFETCH_CHUNK_SIZE}; /// 预读缓冲区下限
+    static const int IO_BUFFER_SIZE{64 * 1024};          /// AVIOContext内部缓冲区大小
+    static std::atomic<size_t> s_defaultBufferSize;      /// 新打开文件的预读缓冲区大小
+
+    QFile m_file;                                        /// 文件（仅IO线程读取）
+    QString m_filePath;                                  /// 文件路径
+    int64_t m_fileSize{0};                               /// 文件大小
+    AVIOContext *m_ioCtx{nullptr};                       /// AVIOContext
+
+    std::mutex m_mutex;                                  /// 缓冲区互斥锁
+    std::condition_variable m_dataCond;                  /// 有新数据、文件结束或停止时通知读取方
+    std::condition_variable m_spaceCond;                 /// 有空闲空间、seek或停止时通知IO线程
+    std::vector<uint8_t> m_buffer;                       /// 环形缓冲区
+    size_t m_bufferHead{0};                              /// 读取位置在环形缓冲区中的下标
+    size_t m_bufferedBytes{0};                           /// 已缓冲的字节数
+    int64_t m_readPosition{0};                           /// 读取位置（文件偏移）
+    int64_t m_fetchPosition{0};                          /// IO线程下一次读取的文件偏移
+    uint64_t m_fetchGeneration{0};                       /// 预读序号，seek清空缓冲区时递增，丢弃过期的读取结果
+    bool m_bEOF{false};                                  /// IO线程是否已读到文件结尾
+    bool m_bError{false};                                /// IO线程是否读取失败
+    std::atomic<bool> m_bStop{false};                    /// 是否停止IO线程
+
+    size_t m_threadId{0};                                /// IO线程ID
+    bool m_bHasThread{false};                            /// 是否已创建IO线程
+
+    std::atomic<uint64_t> m_bytesRead{0};                /// 从文件读取的字节数
+    std::atomic<uint64_t> m_readCount{0};                /// 读取次数
+    std::atomic<uint64_t> m_stallCount{0};               /// 需要等待IO线程的读取次数
+    std::atomic<uint64_t> m_seekInvalidations{0};        /// seek超出缓冲范围而清空缓冲区的次数
+};
@@ -0,0 +1,345 @@
+#include "ST_StreamInfoCache.h"
+
+#include <algorithm>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+#include "CoreServerGlobal.h"
+#include "LogSystem/LogSystem.h"
+
+extern "C"
+{
+#include <libavutil/channel_layout.h>
+}
+
+ST_StreamInfoCache& ST_StreamInfoCache::Instance()
+{
+    static ST_StreamInfoCache instance;
+    return instance;
+}
+
+ST_StreamInfoCache::ST_StreamInfoCache()
+{
+    m_cacheFilePath = QCoreApplication::applicationDirPath() + "/cache/stream_info_cache.json";
+    Load();
+
+    // 退出前写入尚未写盘的修改
+    if (QCoreApplication::instance())
+    {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [this]()
+        {
+            Flush();
+        });
+    }
+}
+
+ST_StreamInfoCache::~ST_StreamInfoCache()
+{
+    Flush();
+}
+
+bool ST_StreamInfoCache::Find(const QString& filePath, ST_StreamProbeInfo& probeInfo)
+{
+    QFileInfo fileInfo(filePath);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(filePath);
+    if (it == m_entries.end() || !fileInfo.exists() || it->m_fileSize != fileInfo.size() || it->m_lastModified != fileInfo.lastModified().toMSecsSinceEpoch())
+    {
+        ++m_missCount;
+        return false;
+    }
+
+    // 访问时间随下一次写盘或退出时一并保存，重启后仍按最近使用淘汰；命中本身不安排写盘
+    it->m_lastAccess = QDateTime::currentMSecsSinceEpoch();
+    m_bDirty = true;
+    probeInfo = *it;
+    ++m_hitCount;
+    LOG_DEBUG("Stream info cache hit: " + filePath.toStdString() + " (hits: " + std::to_string(m_hitCount.load()) + ", misses: " + std::to_string(m_missCount.load()) + ")");
+    return true;
+}
+
+void ST_StreamInfoCache::Store(const QString& filePath, const AVFormatContext* formatCtx)
+{
+    QFileInfo fileInfo(filePath);
+    if (!formatCtx || !formatCtx->iformat || !fileInfo.exists())
+    {
+        return;
+    }
+
+    ST_StreamProbeInfo probeInfo;
+    probeInfo.m_fileSize = fileInfo.size();
+    probeInfo.m_lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    probeInfo.m_lastAccess = QDateTime::currentMSecsSinceEpoch();
+    probeInfo.m_formatName = QString::fromUtf8(formatCtx->iformat->name);
+    probeInfo.m_duration = formatCtx->duration;
+    probeInfo.m_bitRate = formatCtx->bit_rate;
+    probeInfo.m_bestAudioStream = av_find_best_stream(const_cast<AVFormatContext*>(formatCtx), AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+    probeInfo.m_bestVideoStream = av_find_best_stream(const_cast<AVFormatContext*>(formatCtx), AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+    {
+        const AVCodecParameters* codecpar = formatCtx->streams[i]->codecpar;
+        ST_CachedStreamInfo streamInfo;
+        streamInfo.m_codecType = codecpar->codec_type;
+        streamInfo.m_codecId = codecpar->codec_id;
+        streamInfo.m_format = codecpar->format;
+        streamInfo.m_sampleRate = codecpar->sample_rate;
+        streamInfo.m_channels = codecpar->ch_layout.nb_channels;
+        streamInfo.m_width = codecpar->width;
+        streamInfo.m_height = codecpar->height;
+        streamInfo.m_bitRate = codecpar->bit_rate;
+        probeInfo.m_streams.push_back(streamInfo);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.insert(filePath, probeInfo);
+    EvictToLimit();
+    // 只有首次打开的文件才会修改缓存，播放已知文件不产生磁盘写入
+    MarkDirty();
+}
+
+void ST_StreamInfoCache::Remove(const QString& filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.remove(filePath) > 0)
+    {
+        MarkDirty();
+    }
+}
+
+void ST_StreamInfoCache::Flush()
+{
+    std::lock_guard<std::mutex> saveLock(m_saveMutex);
+    QJsonDocument document;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bFlushScheduled = false;
+        if (!m_bDirty)
+        {
+            return;
+        }
+        m_bDirty = false;
+        document = ToJson();
+    }
+    Save(document);
+}
+
+void ST_StreamInfoCache::MarkDirty()
+{
+    m_bDirty = true;
+    if (m_bFlushScheduled || !QCoreApplication::instance())
+    {
+        return;
+    }
+    m_bFlushScheduled = true;
+
+    // 定时器在主线程启动，到期后在线程池中写盘，不阻塞探测线程和UI线程
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [this]()
+    {
+        QTimer::singleShot(FLUSH_DELAY_MS, QCoreApplication::instance(), [this]()
+        {
+            CoreServerGlobal::Instance().GetThreadPool().Submit([this]()
+            {
+                Flush();
+            }, EM_TaskPriority::Normal);
+        });
+    }, Qt::QueuedConnection);
+}
+
+const AVInputFormat* ST_StreamInfoCache::GetFastOpenParams(const ST_StreamProbeInfo& probeInfo, AVDictionary** options)
+{
+    // 已知文件只需读取文件头，流参数由缓存补全
+    av_dict_set_int(options, "probesize", FAST_PROBE_SIZE, 0);
+    av_dict_set_int(options, "analyzeduration", FAST_ANALYZE_DURATION_US, 0);
+
+    // 格式名称可能是逗号分隔的别名列表，取第一个即可定位到同一个解复用器
+    QString shortName = probeInfo.m_formatName.section(',', 0, 0);
+    if (shortName.isEmpty())
+    {
+        return nullptr;
+    }
+    return av_find_input_format(shortName.toUtf8().constData());
+}
+
+bool ST_StreamInfoCache::ApplyToContext(const ST_StreamProbeInfo& probeInfo, AVFormatContext* formatCtx)
+{
+    if (!formatCtx || formatCtx->nb_streams != probeInfo.m_streams.size())
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+    {
+        const ST_CachedStreamInfo& streamInfo = probeInfo.m_streams[i];
+        AVCodecParameters* codecpar = formatCtx->streams[i]->codecpar;
+        if (codecpar->codec_type != streamInfo.m_codecType || (codecpar->codec_id != AV_CODEC_ID_NONE && codecpar->codec_id != streamInfo.m_codecId))
+        {
+            return false;
+        }
+    }
+
+    // 布局一致，补全最小探测未能得到的参数
+    for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+    {
+        const ST_CachedStreamInfo& streamInfo = probeInfo.m_streams[i];
+        AVCodecParameters* codecpar = formatCtx->streams[i]->codecpar;
+        if (codecpar->codec_id == AV_CODEC_ID_NONE)
+        {
+            codecpar->codec_id = streamInfo.m_codecId;
+        }
+        if (codecpar->format < 0)
+        {
+            codecpar->format = streamInfo.m_format;
+        }
+        if (codecpar->bit_rate <= 0)
+        {
+            codecpar->bit_rate = streamInfo.m_bitRate;
+        }
+
+        if (codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
+        {
+            if (codecpar->sample_rate <= 0)
+            {
+                codecpar->sample_rate = streamInfo.m_sampleRate;
+            }
+            if (codecpar->ch_layout.nb_channels <= 0 && streamInfo.m_channels > 0)
+            {
+                av_channel_layout_default(&codecpar->ch_layout, streamInfo.m_channels);
+            }
+        }
+        else if (codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+        {
+            if (codecpar->width <= 0 || codecpar->height <= 0)
+            {
+                codecpar->width = streamInfo.m_width;
+                codecpar->height = streamInfo.m_height;
+            }
+        }
+    }
+
+    if (formatCtx->duration == AV_NOPTS_VALUE)
+    {
+        formatCtx->duration = probeInfo.m_duration;
+    }
+    if (formatCtx->bit_rate <= 0)
+    {
+        formatCtx->bit_rate = probeInfo.m_bitRate;
+    }
+    return true;
+}
+
+void ST_StreamInfoCache::Load()
+{
+    QFile cacheFile(m_cacheFilePath);
+    if (!cacheFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonDocument document = QJsonDocument::fromJson(cacheFile.readAll());
+    if (!document.isObject())
+    {
+        LOG_WARN("Invalid stream info cache file: " + m_cacheFilePath.toStdString());
+        return;
+    }
+
+    QJsonObject root = document.object();
+    for (auto it = root.begin(); it != root.end(); ++it)
+    {
+        QJsonObject entryObject = it.value().toObject();
+        ST_StreamProbeInfo probeInfo;
+        probeInfo.m_fileSize = static_cast<qint64>(entryObject["size"].toDouble());
+        probeInfo.m_lastModified = static_cast<qint64>(entryObject["mtime"].toDouble());
+        probeInfo.m_lastAccess = static_cast<qint64>(entryObject["access"].toDouble());
+        probeInfo.m_formatName = entryObject["format"].toString();
+        probeInfo.m_duration = static_cast<int64_t>(entryObject["duration"].toDouble(static_cast<double>(AV_NOPTS_VALUE)));
+        probeInfo.m_bitRate = static_cast<int64_t>(entryObject["bitRate"].toDouble());
+        probeInfo.m_bestAudioStream = entryObject["bestAudio"].toInt(-1);
+        probeInfo.m_bestVideoStream = entryObject["bestVideo"].toInt(-1);
+        for (const QJsonValue& streamValue : entryObject["streams"].toArray())
+        {
+            QJsonObject streamObject = streamValue.toObject();
+            ST_CachedStreamInfo streamInfo;
+            streamInfo.m_codecType = static_cast<AVMediaType>(streamObject["type"].toInt(AVMEDIA_TYPE_UNKNOWN));
+            streamInfo.m_codecId = static_cast<AVCodecID>(streamObject["codec"].toInt(AV_CODEC_ID_NONE));
+            streamInfo.m_format = streamObject["format"].toInt(-1);
+            streamInfo.m_sampleRate = streamObject["sampleRate"].toInt();
+            streamInfo.m_channels = streamObject["channels"].toInt();
+            streamInfo.m_width = streamObject["width"].toInt();
+            streamInfo.m_height = streamObject["height"].toInt();
+            streamInfo.m_bitRate = static_cast<int64_t>(streamObject["bitRate"].toDouble());
+            probeInfo.m_streams.push_back(streamInfo);
+        }
+        m_entries.insert(it.key(), probeInfo);
+    }
+
+    LOG_INFO("Stream info cache loaded: " + std::to_string(m_entries.size()) + " entries");
+}
+
+QJsonDocument ST_StreamInfoCache::ToJson() const
+{
+    QJsonObject root;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        const ST_StreamProbeInfo& probeInfo = it.value();
+        QJsonArray streamArray;
+        for (const ST_CachedStreamInfo& streamInfo : probeInfo.m_streams)
+        {
+            QJsonObject streamObject;
+            streamObject["type"] = static_cast<int>(streamInfo.m_codecType);
+            streamObject["codec"] = static_cast<int>(streamInfo.m_codecId);
+            streamObject["format"] = streamInfo.m_format;
+            streamObject["sampleRate"] = streamInfo.m_sampleRate;
+            streamObject["channels"] = streamInfo.m_channels;
+            streamObject["width"] = streamInfo.m_width;
+            streamObject["height"] = streamInfo.m_height;
+            streamObject["bitRate"] = static_cast<double>(streamInfo.m_bitRate);
+            streamArray.append(streamObject);
+        }
+
+        QJsonObject entryObject;
+        entryObject["size"] = static_cast<double>(probeInfo.m_fileSize);
+        entryObject["mtime"] = static_cast<double>(probeInfo.m_lastModified);
+        entryObject["access"] = static_cast<double>(probeInfo.m_lastAccess);
+        entryObject["format"] = probeInfo.m_formatName;
+        entryObject["duration"] = static_cast<double>(probeInfo.m_duration);
+        entryObject["bitRate"] = static_cast<double>(probeInfo.m_bitRate);
+        entryObject["bestAudio"] = probeInfo.m_bestAudioStream;
+        entryObject["bestVideo"] = probeInfo.m_bestVideoStream;
+        entryObject["streams"] = streamArray;
+        root[it.key()] = entryObject;
+    }
+    return QJsonDocument(root);
+}
+
+void ST_StreamInfoCache::Save(const QJsonDocument& document) const
+{
+    QDir().mkpath(QFileInfo(m_cacheFilePath).absolutePath());
+    // 先写临时文件再替换，写入中途退出不会损坏已有缓存
+    QSaveFile cacheFile(m_cacheFilePath);
+    if (!cacheFile.open(QIODevice::WriteOnly))
+    {
+        LOG_WARN("Failed to write stream info cache: " + m_cacheFilePath.toStdString());
+        return;
+    }
+    cacheFile.write(document.toJson(QJsonDocument::Compact));
+    cacheFile.commit();
+}
+
+void ST_StreamInfoCache::EvictToLimit()
+{
+    while (m_entries.size() > MAX_ENTRIES)
+    {
+        auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](const ST_StreamProbeInfo& left, const ST_StreamProbeInfo& right)
+        {
+            return left.m_lastAccess < right.m_lastAccess;
+        });
+        m_entries.erase(oldest);
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <QHash>
+#include <QJsonDocument>
+#include <QString>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+}
+
+/// <summary>
+/// 缓存的单个流参数
+/// </summary>
+struct ST_CachedStreamInfo
+{
+    AVMediaType m_codecType{AVMEDIA_TYPE_UNKNOWN}; /// 流类型
+    AVCodecID m_codecId{AV_CODEC_ID_NONE};         /// 编码ID
+    int m_format{-1};                              /// 采样格式或像素格式
+    int m_sampleRate{0};                           /// 采样率
+    int m_channels{0};                             /// 声道数
+    int m_width{0};                                /// 视频宽度
+    int m_height{0};                               /// 视频高度
+    int64_t m_bitRate{0};                          /// 码率
+};
+
+/// <summary>
+/// 缓存的文件探测结果：容器格式、流布局、编码参数、时长和最佳流索引
+/// </summary>
+struct ST_StreamProbeInfo
+{
+    qint64 m_fileSize{0};                          /// 文件大小
+    qint64 m_lastModified{0};                      /// 文件修改时间（毫秒）
+    qint64 m_lastAccess{0};                        /// 最近使用时间（毫秒），用于淘汰
+    QString m_formatName;                          /// 容器格式名称
+    int64_t m_duration{AV_NOPTS_VALUE};            /// 时长（AV_TIME_BASE）
+    int64_t m_bitRate{0};                          /// 整体码率
+    int m_bestAudioStream{-1};                     /// 最佳音频流索引
+    int m_bestVideoStream{-1};                     /// 最佳视频流索引
+    std::vector<ST_CachedStreamInfo> m_streams;    /// 各流参数
+};
+
+/// <summary>
+/// 文件流信息缓存
+/// 按路径、大小和修改时间记录avformat_find_stream_info的结果并持久化到磁盘，
+/// 已知文件只需以最小探测量打开，媒体类型检测无需打开文件；线程安全
+/// 修改只标记为脏，延迟合并后在线程池中写盘，程序退出时写入剩余修改
+/// </summary>
+class ST_StreamInfoCache
+{
+public:
+    /// <summary>
+    /// 获取单例
+    /// </summary>
+    static ST_StreamInfoCache& Instance();
+
+    /// <summary>
+    /// 查找文件的探测结果，文件大小或修改时间变化视为未命中
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="probeInfo">探测结果</param>
+    /// <returns>是否命中</returns>
+    bool Find(const QString& filePath, ST_StreamProbeInfo& probeInfo);
+
+    /// <summary>
+    /// 记录完整探测后的格式上下文，延迟写入磁盘
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="formatCtx">已执行avformat_find_stream_info的格式上下文</param>
+    void Store(const QString& filePath, const AVFormatContext* formatCtx);
+
+    /// <summary>
+    /// 移除文件的探测结果
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    void Remove(const QString& filePath);
+
+    /// <summary>
+    /// 有未写盘的修改时立即写入磁盘（不持有缓存锁写文件）
+    /// </summary>
+    void Flush();
+
+    /// <summary>
+    /// 以最小探测量打开时的打开参数：容器格式和探测选项
+    /// </summary>
+    /// <param name="probeInfo">探测结果</param>
+    /// <param name="options">输出的格式选项字典，由调用方释放</param>
+    /// <returns>缓存的输入格式，找不到时返回nullptr由FFmpeg自行探测</returns>
+    static const AVInputFormat* GetFastOpenParams(const ST_StreamProbeInfo& probeInfo, AVDictionary** options);
+
+    /// <summary>
+    /// 检查最小探测得到的流布局是否与缓存一致，一致时补全探测不足而缺失的参数
+    /// </summary>
+    /// <param name="probeInfo">探测结果</param>
+    /// <param name="formatCtx">以最小探测量打开的格式上下文</param>
+    /// <returns>流布局是否一致</returns>
+    static bool ApplyToContext(const ST_StreamProbeInfo& probeInfo, AVFormatContext* formatCtx);
+
+    /// <summary>
+    /// 获取命中次数
+    /// </summary>
+    uint64_t GetHitCount() const
+    {
+        return m_hitCount.load();
+    }
+
+    /// <summary>
+    /// 获取未命中次数
+    /// </summary>
+    uint64_t GetMissCount() const
+    {
+        return m_missCount.load();
+    }
+
+private:
+    ST_StreamInfoCache();
+    ~ST_StreamInfoCache();
+    ST_StreamInfoCache(const ST_StreamInfoCache&) = delete;
+    ST_StreamInfoCache& operator=(const ST_StreamInfoCache&) = delete;
+
+    /// <summary>
+    /// 从磁盘加载缓存
+    /// </summary>
+    void Load();
+
+    /// <summary>
+    /// 标记有未写盘的修改，尚未安排写盘时在FLUSH_DELAY_MS后写盘（调用方需持有m_mutex）
+    /// </summary>
+    void MarkDirty();
+
+    /// <summary>
+    /// 将缓存序列化为JSON（调用方需持有m_mutex）
+    /// </summary>
+    QJsonDocument ToJson() const;
+
+    /// <summary>
+    /// 将JSON写入缓存文件（调用方需持有m_saveMutex）
+    /// </summary>
+    /// <param name="document">缓存内容</param>
+    void Save(const QJsonDocument& document) const;
+
+    /// <summary>
+    /// 超出条目上限时淘汰最久未使用的条目（调用方需持有m_mutex）
+    /// </summary>
+    void EvictToLimit();
+
+private:
+    static const int MAX_ENTRIES{4096};             /// 缓存条目上限
+    static const int FAST_PROBE_SIZE{32768};        /// 命中时的探测字节数
+    static const int FAST_ANALYZE_DURATION_US{100000}; /// 命中时的分析时长（微秒）
+    static const int FLUSH_DELAY_MS{5000};          /// 修改后延迟写盘的时间（毫秒），合并连续探测产生的写入
+
+    mutable std::mutex m_mutex;                     /// 缓存互斥锁
+    std::mutex m_saveMutex;                         /// 写盘互斥锁，保证按修改顺序写入
+    bool m_bDirty{false};                           /// 是否有未写盘的修改（包括只更新访问时间）
+    bool m_bFlushScheduled{false};                  /// 是否已安排延迟写盘
+    QHash<QString, ST_StreamProbeInfo> m_entries;   /// 按文件路径索引的探测结果
+    QString m_cacheFilePath;                        /// 缓存文件路径
+    std::atomic<uint64_t> m_hitCount{0};            /// 命中次数
+    std::atomic<uint64_t> m_missCount{0};           /// 未命中次数
+};
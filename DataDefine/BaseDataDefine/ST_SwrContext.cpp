@@ -18,6 +18,16 @@ int ST_SwrContext::SwrContextInit()
     return m_swrCtx ? swr_init(m_swrCtx) : -1;
 }
 
+int ST_SwrContext::SwrContextReset()
+{
+    if (!m_swrCtx)
+    {
+        return -1;
+    }
+    swr_close(m_swrCtx);
+    return swr_init(m_swrCtx);
+}
+
 int ST_SwrContext::SwrConvert(uint8_t* const* out, int out_count,const uint8_t* const* in, int in_count)
 {
     int realOutSamples = swr_convert(m_swrCtx, out, out_count, in, in_count);
@@ -37,4 +47,9 @@ int ST_SwrContext::SwrConvert(uint8_t* const* out, int out_count,const uint8_t*
 int ST_SwrContext::GetDelayData(int sampleRate)
 {
     return swr_get_delay(m_swrCtx, sampleRate);
+}
+
+int ST_SwrContext::GetOutSamples(int inCount)
+{
+    return m_swrCtx ? swr_get_out_samples(m_swrCtx, inCount) : -1;
 }
\ No newline at end of file
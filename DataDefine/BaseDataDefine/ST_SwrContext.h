@@ -18,6 +18,10 @@ class ST_SwrContext
     /// </summary>
     int SwrContextInit();
     /// <summary>
+    /// 重置重采样上下文，丢弃内部缓存的样本，保留已设置的参数
+    /// </summary>
+    int SwrContextReset();
+    /// <summary>
     /// 重采样转换
     /// </summary>
     /// <param name="out"></param>
@@ -32,6 +36,12 @@ class ST_SwrContext
     /// <param name="sampleRate"></param>
     /// <returns></returns>
     int GetDelayData(int sampleRate);
+    /// <summary>
+    /// 获取输入指定样本数时输出样本数的上限（含内部缓存的样本）
+    /// </summary>
+    /// <param name="inCount">输入样本数，0表示刷新</param>
+    /// <returns>输出样本数上限，失败返回负值</returns>
+    int GetOutSamples(int inCount);
 
     void SetRawContext(SwrContext *p)
     {
@@ -0,0 +1,154 @@
+#include "ST_VideoFramePool.h"
+
+extern "C"
+{
+#include <libavutil/imgutils.h>
+}
+
+bool ST_VideoFramePool::Init(AVPixelFormat format, int maxWidth, int maxHeight, int bufferCount)
+{
+    Reset();
+
+    // 各平面行首按BUFFER_ALIGN对齐，任意显示尺寸下sws_scale都能走SIMD路径
+    int bufferSize = av_image_get_buffer_size(format, maxWidth, maxHeight, BUFFER_ALIGN);
+    if (bufferSize <= 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_format = format;
+    m_maxWidth = maxWidth;
+    m_maxHeight = maxHeight;
+    // 一块上传中、一块已发布、一块写入中，至少三块才能保证生产者不等待
+    int count = bufferCount < 3 ? 3 : bufferCount;
+    for (int i = 0; i < count; ++i)
+    {
+        auto slot = std::make_unique<ST_Slot>();
+        // 多分配BUFFER_ALIGN字节，使平面起始地址也能对齐
+        slot->m_storage.resize(static_cast<size_t>(bufferSize) + BUFFER_ALIGN);
+        slot->m_frame.m_format = format;
+        m_slots.push_back(std::move(slot));
+    }
+    return true;
+}
+
+void ST_VideoFramePool::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.clear();
+    m_readySlot = nullptr;
+    m_format = AV_PIX_FMT_NONE;
+    m_maxWidth = 0;
+    m_maxHeight = 0;
+    m_replacedCount.store(0);
+}
+
+ST_VideoFrameBuffer *ST_VideoFramePool::AcquireWrite(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (width > m_maxWidth || height > m_maxHeight)
+    {
+        return nullptr;
+    }
+
+    for (auto &slot : m_slots)
+    {
+        if (slot->m_state != EM_SlotState::Free)
+        {
+            continue;
+        }
+
+        // 按本帧尺寸排布平面，尺寸不超过最大尺寸时分配的内存足够
+        ST_VideoFrameBuffer &frame = slot->m_frame;
+        if (frame.m_width != width || frame.m_height != height)
+        {
+            if (av_image_fill_arrays(frame.m_data, frame.m_linesize, AlignedStorage(*slot), m_format, width, height, BUFFER_ALIGN) < 0)
+            {
+                return nullptr;
+            }
+            frame.m_width = width;
+            frame.m_height = height;
+        }
+        slot->m_state = EM_SlotState::Writing;
+        return &frame;
+    }
+    return nullptr;
+}
+
+void ST_VideoFramePool::CommitWrite(ST_VideoFrameBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ST_Slot *slot = FindSlot(buffer);
+    if (!slot || slot->m_state != EM_SlotState::Writing)
+    {
+        return;
+    }
+
+    // 消费者还没取走的旧帧直接回收
+    if (m_readySlot)
+    {
+        m_readySlot->m_state = EM_SlotState::Free;
+        m_replacedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot->m_state = EM_SlotState::Ready;
+    m_readySlot = slot;
+}
+
+void ST_VideoFramePool::CancelWrite(ST_VideoFrameBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ST_Slot *slot = FindSlot(buffer);
+    if (slot && slot->m_state == EM_SlotState::Writing)
+    {
+        slot->m_state = EM_SlotState::Free;
+    }
+}
+
+const ST_VideoFrameBuffer *ST_VideoFramePool::AcquireRead()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_readySlot)
+    {
+        return nullptr;
+    }
+
+    ST_Slot *slot = m_readySlot;
+    m_readySlot = nullptr;
+    slot->m_state = EM_SlotState::Reading;
+    return &slot->m_frame;
+}
+
+void ST_VideoFramePool::ReleaseRead(const ST_VideoFrameBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ST_Slot *slot = FindSlot(buffer);
+    if (slot && slot->m_state == EM_SlotState::Reading)
+    {
+        slot->m_state = EM_SlotState::Free;
+    }
+}
+
+uint8_t *ST_VideoFramePool::AlignedStorage(ST_Slot &slot)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(slot.m_storage.data());
+    uintptr_t aligned = (address + BUFFER_ALIGN - 1) & ~static_cast<uintptr_t>(BUFFER_ALIGN - 1);
+    return slot.m_storage.data() + (aligned - address);
+}
+
+ST_VideoFramePool::ST_Slot *ST_VideoFramePool::FindSlot(const ST_VideoFrameBuffer *buffer)
+{
+    for (auto &slot : m_slots)
+    {
+        if (&slot->m_frame == buffer)
+        {
+            return slot.get();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern "C"
+{
+#include <libavutil/pixfmt.h>
+}
+
+/// <summary>
+/// 帧池中的一块显示帧缓冲区
+/// </summary>
+struct ST_VideoFrameBuffer
+{
+    uint8_t *m_data[4]{nullptr, nullptr, nullptr, nullptr}; /// 各平面数据，按m_width×m_height排布，行首32字节对齐
+    int m_linesize[4]{0, 0, 0, 0};                          /// 各平面行间距
+    int m_width{0};                                         /// 图像宽度
+    int m_height{0};                                        /// 图像高度
+    AVPixelFormat m_format{AV_PIX_FMT_NONE};                /// 像素格式
+    double m_pts{0.0};                                      /// 显示时间（秒）
+};
+
+/// <summary>
+/// 跨线程交接显示帧的缓冲池（默认三缓冲）
+/// 生产者（呈现线程）取空闲缓冲区写入后发布，消费者（SDL窗口所在的Qt线程）取最新发布的缓冲区上传纹理后归还；
+/// 消费者尚未取走的旧帧被新帧替换而不是排队，每块缓冲区同一时刻只被一方访问，不会出现写入中被上传的撕裂
+/// </summary>
+class ST_VideoFramePool
+{
+  public:
+    ST_VideoFramePool() = default;
+    ~ST_VideoFramePool() = default;
+
+    ST_VideoFramePool(const ST_VideoFramePool &) = delete;
+    ST_VideoFramePool &operator=(const ST_VideoFramePool &) = delete;
+
+    /// <summary>
+    /// 按最大尺寸预分配缓冲区，之后写入的帧尺寸不能超过该尺寸（需在生产者和消费者均未运行时调用）
+    /// </summary>
+    /// <param name="format">像素格式</param>
+    /// <param name="maxWidth">最大宽度</param>
+    /// <param name="maxHeight">最大高度</param>
+    /// <param name="bufferCount">缓冲区个数，至少为3，保证生产者总能取到空闲缓冲区</param>
+    /// <returns>是否分配成功</returns>
+    bool Init(AVPixelFormat format, int maxWidth, int maxHeight, int bufferCount = 3);
+
+    /// <summary>
+    /// 释放全部缓冲区，之后Acquire均返回nullptr
+    /// </summary>
+    void Reset();
+
+    /// <summary>
+    /// 取一块空闲缓冲区并按指定尺寸排布平面（仅生产者调用）
+    /// </summary>
+    /// <param name="width">图像宽度，不超过Init的最大宽度</param>
+    /// <param name="height">图像高度，不超过Init的最大高度</param>
+    /// <returns>缓冲区，没有空闲缓冲区或尺寸无效时返回nullptr</returns>
+    ST_VideoFrameBuffer *AcquireWrite(int width, int height);
+
+    /// <summary>
+    /// 发布写好的缓冲区，替换尚未被消费者取走的旧帧（仅生产者调用）
+    /// </summary>
+    /// <param name="buffer">AcquireWrite返回的缓冲区</param>
+    void CommitWrite(ST_VideoFrameBuffer *buffer);
+
+    /// <summary>
+    /// 放弃写入，缓冲区直接回到空闲状态（仅生产者调用）
+    /// </summary>
+    /// <param name="buffer">AcquireWrite返回的缓冲区</param>
+    void CancelWrite(ST_VideoFrameBuffer *buffer);
+
+    /// <summary>
+    /// 取最新发布的缓冲区（仅消费者调用）
+    /// </summary>
+    /// <returns>缓冲区，没有新帧时返回nullptr</returns>
+    const ST_VideoFrameBuffer *AcquireRead();
+
+    /// <summary>
+    /// 归还已上传的缓冲区（仅消费者调用）
+    /// </summary>
+    /// <param name="buffer">AcquireRead返回的缓冲区</param>
+    void ReleaseRead(const ST_VideoFrameBuffer *buffer);
+
+    /// <summary>
+    /// 获取被新帧替换、未被上传的帧数
+    /// </summary>
+    uint64_t GetReplacedCount() const
+    {
+        return m_replacedCount.load();
+    }
+
+  private:
+    /// <summary>
+    /// 缓冲区状态
+    /// </summary>
+    enum class EM_SlotState
+    {
+        Free,    /// 空闲
+        Writing, /// 生产者写入中
+        Ready,   /// 已发布，等待消费者取走
+        Reading  /// 消费者上传中
+    };
+
+    /// <summary>
+    /// 缓冲区槽位
+    /// </summary>
+    struct ST_Slot
+    {
+        ST_VideoFrameBuffer m_frame;                  /// 对外的帧描述
+        std::vector<uint8_t> m_storage;               /// 按最大尺寸分配的内存
+        EM_SlotState m_state{EM_SlotState::Free};     /// 状态
+    };
+
+    /// <summary>
+    /// 查找缓冲区所在的槽位（调用方需持有m_mutex）
+    /// </summary>
+    ST_Slot *FindSlot(const ST_VideoFrameBuffer *buffer);
+
+    /// <summary>
+    /// 获取槽位内存中按BUFFER_ALIGN对齐的起始地址
+    /// </summary>
+    static uint8_t *AlignedStorage(ST_Slot &slot);
+
+    /// <summary>
+    /// 平面起始地址和行间距的对齐字节数，满足swscale的SIMD要求
+    /// </summary>
+    static constexpr int BUFFER_ALIGN = 32;
+
+    std::mutex m_mutex;                               /// 状态互斥锁，只保护状态切换，不在锁内拷贝数据
+    std::vector<std::unique_ptr<ST_Slot>> m_slots;    /// 缓冲区槽位
+    ST_Slot *m_readySlot{nullptr};                    /// 最新发布的槽位
+    AVPixelFormat m_format{AV_PIX_FMT_NONE};          /// 像素格式
+    int m_maxWidth{0};                                /// 最大宽度
+    int m_maxHeight{0};                               /// 最大高度
+    std::atomic<uint64_t> m_replacedCount{0};         /// 被替换的帧数
+};
@@ -230,3 +230,46 @@ int ST_AudioPlayInfo::GetAudioStreamAvailable() const
 {
     return m_audioStream.GetRawStream() ? SDL_GetAudioStreamAvailable(m_audioStream.GetRawStream()) : 0;
 }
+
+int ST_AudioPlayInfo::GetAudioStreamQueued() const
+{
+    return m_audioStream.GetRawStream() ? SDL_GetAudioStreamQueued(m_audioStream.GetRawStream()) : 0;
+}
+
+int ST_AudioPlayInfo::GetAudioDeviceBufferFrames() const
+{
+    SDL_AudioSpec deviceSpec;
+    int sampleFrames = 0;
+    if (!m_audioDeviceId.GetRawDeviceID() || !SDL_GetAudioDeviceFormat(m_audioDeviceId.GetRawDeviceID(), &deviceSpec, &sampleFrames))
+    {
+        return 0;
+    }
+    return sampleFrames;
+}
+
+void ST_AudioPlayInfo::SetAudioStreamGetCallback(SDL_AudioStreamCallback callback, void *userdata)
+{
+    if (m_audioStream.GetRawStream())
+    {
+        if (!SDL_SetAudioStreamGetCallback(m_audioStream.GetRawStream(), callback, userdata))
+        {
+            qWarning() << "Failed to set audio stream get callback:" << SDL_GetError();
+        }
+    }
+}
+
+void ST_AudioPlayInfo::LockAudioStream()
+{
+    if (m_audioStream.GetRawStream())
+    {
+        SDL_LockAudioStream(m_audioStream.GetRawStream());
+    }
+}
+
+void ST_AudioPlayInfo::UnlockAudioStream()
+{
+    if (m_audioStream.GetRawStream())
+    {
+        SDL_UnlockAudioStream(m_audioStream.GetRawStream());
+    }
+}
@@ -121,6 +121,33 @@ class ST_AudioPlayInfo
     /// </summary>
     int GetAudioStreamAvailable() const;
 
+    /// <summary>
+    /// 获取音频流中已排队但尚未被设备消费的字节数
+    /// </summary>
+    int GetAudioStreamQueued() const;
+
+    /// <summary>
+    /// 获取音频设备缓冲区大小（样本帧），用于估算设备输出延迟
+    /// </summary>
+    int GetAudioDeviceBufferFrames() const;
+
+    /// <summary>
+    /// 设置音频流拉取回调，设备需要数据时由SDL音频线程调用
+    /// </summary>
+    /// <param name="callback">回调函数</param>
+    /// <param name="userdata">用户数据</param>
+    void SetAudioStreamGetCallback(SDL_AudioStreamCallback callback, void *userdata);
+
+    /// <summary>
+    /// 锁定音频流，期间SDL不会调用拉取回调
+    /// </summary>
+    void LockAudioStream();
+
+    /// <summary>
+    /// 解锁音频流
+    /// </summary>
+    void UnlockAudioStream();
+
     /// <summary>
     /// 获取当前音频设备ID
     /// </summary>
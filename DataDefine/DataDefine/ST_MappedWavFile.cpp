@@ -0,0 +1,190 @@
+#include "ST_MappedWavFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include "BaseDataDefine/ST_MappedFileIO.h"
+#include "LogSystem/LogSystem.h"
+
+namespace
+{
+    const uint16_t WAVE_FORMAT_PCM = 0x0001;
+    const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+    const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    // WAV为小端格式，目标平台均为小端，直接按字节拷贝
+    uint16_t ReadLE16(const uint8_t *data)
+    {
+        uint16_t value = 0;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint32_t ReadLE32(const uint8_t *data)
+    {
+        uint32_t value = 0;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+ST_MappedWavFile::~ST_MappedWavFile()
+{
+    Close();
+}
+
+bool ST_MappedWavFile::Open(const QString &filePath)
+{
+    Close();
+
+    // 非本地固定磁盘上的映射读取会在音频回调中缺页阻塞，交给解码路径后台预读
+    if (!ST_MappedFileIO::IsLocalFixedDisk(filePath))
+    {
+        return false;
+    }
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        LOG_WARN("ST_MappedWavFile::Open() : Failed to open file: " + filePath.toStdString());
+        return false;
+    }
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < 12)
+    {
+        Close();
+        return false;
+    }
+
+    m_mapped = m_file.map(0, fileSize);
+    if (!m_mapped)
+    {
+        LOG_WARN("ST_MappedWavFile::Open() : Failed to map file: " + filePath.toStdString());
+        Close();
+        return false;
+    }
+
+    if (memcmp(m_mapped, "RIFF", 4) != 0 || memcmp(m_mapped + 8, "WAVE", 4) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    // 遍历RIFF块，找到fmt和data块（块按偶数字节对齐）
+    bool bHasFormat = false;
+    qint64 offset = 12;
+    while (offset + 8 <= fileSize)
+    {
+        const uint8_t *chunk = m_mapped + offset;
+        uint32_t chunkSize = ReadLE32(chunk + 4);
+        const qint64 bodyOffset = offset + 8;
+        const qint64 bodyAvailable = fileSize - bodyOffset;
+
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            if (chunkSize > bodyAvailable || !ParseFormatChunk(chunk + 8, chunkSize))
+            {
+                Close();
+                return false;
+            }
+            bHasFormat = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            if (!bHasFormat)
+            {
+                break;
+            }
+
+            // 录音中断或流式写入的文件data块大小可能不准确，以实际文件长度为准
+            qint64 dataSize = std::min<qint64>(chunkSize, bodyAvailable);
+            m_data = m_mapped + bodyOffset;
+            m_dataSize = static_cast<size_t>(dataSize - dataSize % m_blockAlign);
+            return true;
+        }
+
+        offset = bodyOffset + chunkSize + (chunkSize & 1);
+    }
+
+    Close();
+    return false;
+}
+
+void ST_MappedWavFile::Close()
+{
+    if (m_mapped)
+    {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    if (m_file.isOpen())
+    {
+        m_file.close();
+    }
+
+    m_data = nullptr;
+    m_dataSize = 0;
+    m_sampleRate = 0;
+    m_channels = 0;
+    m_blockAlign = 0;
+    m_sampleFormat = AV_SAMPLE_FMT_NONE;
+}
+
+double ST_MappedWavFile::GetDuration() const
+{
+    if (m_sampleRate <= 0 || m_blockAlign <= 0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(m_dataSize / m_blockAlign) / m_sampleRate;
+}
+
+bool ST_MappedWavFile::ParseFormatChunk(const uint8_t *chunk, uint32_t chunkSize)
+{
+    if (chunkSize < 16)
+    {
+        return false;
+    }
+
+    uint16_t formatTag = ReadLE16(chunk);
+    m_channels = ReadLE16(chunk + 2);
+    m_sampleRate = static_cast<int>(ReadLE32(chunk + 4));
+    m_blockAlign = ReadLE16(chunk + 12);
+    uint16_t bitsPerSample = ReadLE16(chunk + 14);
+
+    // WAVE_FORMAT_EXTENSIBLE：实际格式为子格式GUID的前两个字节
+    if (formatTag == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40)
+    {
+        formatTag = ReadLE16(chunk + 24);
+    }
+
+    if (m_channels <= 0 || m_sampleRate <= 0 || m_blockAlign <= 0 || m_blockAlign != m_channels * bitsPerSample / 8)
+    {
+        return false;
+    }
+
+    m_sampleFormat = AV_SAMPLE_FMT_NONE;
+    if (formatTag == WAVE_FORMAT_PCM)
+    {
+        switch (bitsPerSample)
+        {
+            case 8:
+                m_sampleFormat = AV_SAMPLE_FMT_U8;
+                break;
+            case 16:
+                m_sampleFormat = AV_SAMPLE_FMT_S16;
+                break;
+            case 32:
+                m_sampleFormat = AV_SAMPLE_FMT_S32;
+                break;
+            default:
+                break;
+        }
+    }
+    else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32)
+    {
+        m_sampleFormat = AV_SAMPLE_FMT_FLT;
+    }
+
+    return m_sampleFormat != AV_SAMPLE_FMT_NONE;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <QFile>
+#include <QString>
+
+extern "C"
+{
+#include <libavutil/samplefmt.h>
+}
+
+/// <summary>
+/// 内存映射的PCM WAV文件
+/// 解析RIFF头并映射整个文件，data块中的样本可直接按字节读取，无需解码
+/// </summary>
+class ST_MappedWavFile
+{
+  public:
+    ST_MappedWavFile() = default;
+    ~ST_MappedWavFile();
+
+    ST_MappedWavFile(const ST_MappedWavFile &) = delete;
+    ST_MappedWavFile &operator=(const ST_MappedWavFile &) = delete;
+
+    /// <summary>
+    /// 打开并映射WAV文件，仅支持SDL可直接播放的8/16/32位整数和32位浮点PCM
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <returns>是否成功</returns>
+    bool Open(const QString &filePath);
+
+    /// <summary>
+    /// 取消映射并关闭文件
+    /// </summary>
+    void Close();
+
+    /// <summary>
+    /// 获取data块起始地址
+    /// </summary>
+    const uint8_t *GetData() const
+    {
+        return m_data;
+    }
+
+    /// <summary>
+    /// 获取data块大小（字节，已按样本帧对齐）
+    /// </summary>
+    size_t GetDataSize() const
+    {
+        return m_dataSize;
+    }
+
+    /// <summary>
+    /// 获取采样率
+    /// </summary>
+    int GetSampleRate() const
+    {
+        return m_sampleRate;
+    }
+
+    /// <summary>
+    /// 获取声道数
+    /// </summary>
+    int GetChannels() const
+    {
+        return m_channels;
+    }
+
+    /// <summary>
+    /// 获取采样格式（交错）
+    /// </summary>
+    AVSampleFormat GetSampleFormat() const
+    {
+        return m_sampleFormat;
+    }
+
+    /// <summary>
+    /// 获取每个样本帧的字节数
+    /// </summary>
+    int GetBlockAlign() const
+    {
+        return m_blockAlign;
+    }
+
+    /// <summary>
+    /// 获取时长（秒）
+    /// </summary>
+    double GetDuration() const;
+
+  private:
+    /// <summary>
+    /// 解析fmt块
+    /// </summary>
+    /// <param name="chunk">块数据</param>
+    /// <param name="chunkSize">块大小</param>
+    /// <returns>格式是否受支持</returns>
+    bool ParseFormatChunk(const uint8_t *chunk, uint32_t chunkSize);
+
+  private:
+    QFile m_file;                                      /// 映射的文件
+    uchar *m_mapped{nullptr};                          /// 映射起始地址
+    const uint8_t *m_data{nullptr};                    /// data块起始地址
+    size_t m_dataSize{0};                              /// data块大小（字节）
+    int m_sampleRate{0};                               /// 采样率
+    int m_channels{0};                                 /// 声道数
+    int m_blockAlign{0};                               /// 每个样本帧的字节数
+    AVSampleFormat m_sampleFormat{AV_SAMPLE_FMT_NONE}; /// 采样格式
+};
@@ -1,5 +1,6 @@
 ﻿#include "ST_OpenFileResult.h"
 
+#include "BaseDataDefine/ST_StreamInfoCache.h"
 #include "LogSystem/LogSystem.h"
 #include "SDKCommonDefine/SDKCommonDefine.h"
 
@@ -13,23 +14,26 @@ ST_OpenFileResult::~ST_OpenFileResult()
 
 bool ST_OpenFileResult::OpenFilePath(const QString &filePath)
 {
-    // 打开音频文件
-    m_formatCtx = new ST_AVFormatContext;
-    int ret = m_formatCtx->OpenInputFilePath(filePath.toUtf8().constData(), nullptr, nullptr);
-    if (ret < 0)
+    // 已探测过的文件以最小探测量打开，流参数由缓存补全
+    ST_StreamProbeInfo probeInfo;
+    bool bCached = ST_StreamInfoCache::Instance().Find(filePath, probeInfo);
+    if (bCached && !OpenFormatContext(filePath, &probeInfo))
     {
-        LOG_WARN("Failed to open input file");
-        return false;
+        LOG_INFO("Cached stream layout mismatch, probing again: " + filePath.toStdString());
+        ST_StreamInfoCache::Instance().Remove(filePath);
+        bCached = false;
     }
 
-    ret = avformat_find_stream_info(m_formatCtx->GetRawContext(), nullptr);
-    if (ret < 0)
+    if (!bCached)
     {
-        LOG_WARN("Find stream info failed");
-        return false;
+        if (!OpenFormatContext(filePath, nullptr))
+        {
+            return false;
+        }
+        ST_StreamInfoCache::Instance().Store(filePath, m_formatCtx->GetRawContext());
     }
 
-    m_audioStreamIdx = m_formatCtx->FindBestStream(AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+    m_audioStreamIdx = bCached ? probeInfo.m_bestAudioStream : m_formatCtx->FindBestStream(AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
     if (m_audioStreamIdx < 0)
     {
         LOG_WARN("No audio stream found");
@@ -60,3 +64,34 @@ bool ST_OpenFileResult::OpenFilePath(const QString &filePath)
     }
     return true;
 }
+
+bool ST_OpenFileResult::OpenFormatContext(const QString &filePath, const ST_StreamProbeInfo *probeInfo)
+{
+    SAFE_DELETE_POINTER_VALUE(m_formatCtx);
+    m_formatCtx = new ST_AVFormatContext;
+
+    AVDictionary *options = nullptr;
+    const AVInputFormat *inputFormat = probeInfo ? ST_StreamInfoCache::GetFastOpenParams(*probeInfo, &options) : nullptr;
+    bool bOpened = m_formatCtx->OpenInputFilePath(filePath.toUtf8().constData(), inputFormat, options ? &options : nullptr);
+    av_dict_free(&options);
+    if (!bOpened)
+    {
+        LOG_WARN("Failed to open input file");
+        SAFE_DELETE_POINTER_VALUE(m_formatCtx);
+        return false;
+    }
+
+    if (avformat_find_stream_info(m_formatCtx->GetRawContext(), nullptr) < 0)
+    {
+        LOG_WARN("Find stream info failed");
+        SAFE_DELETE_POINTER_VALUE(m_formatCtx);
+        return false;
+    }
+
+    if (probeInfo && !ST_StreamInfoCache::ApplyToContext(*probeInfo, m_formatCtx->GetRawContext()))
+    {
+        SAFE_DELETE_POINTER_VALUE(m_formatCtx);
+        return false;
+    }
+    return true;
+}
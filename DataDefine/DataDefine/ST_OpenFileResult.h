@@ -4,6 +4,9 @@
 #include "BaseDataDefine/ST_AVCodecContext.h"
 #include "BaseDataDefine/ST_AVCodecParameters.h"
 #include "BaseDataDefine/ST_AVFormatContext.h"
+
+struct ST_StreamProbeInfo;
+
 class ST_OpenFileResult
 {
   public:
@@ -11,12 +14,26 @@ class ST_OpenFileResult
     ~ST_OpenFileResult();
 
   public:
+    /// <summary>
+    /// 打开文件并初始化音频解码器，已探测过的文件使用流信息缓存跳过完整探测
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <returns>是否成功</returns>
     bool OpenFilePath(const QString &filePath);
     ST_AVFormatContext *m_formatCtx = nullptr;
     ST_AVCodecParameters *m_codecParams = nullptr;
     ST_AVCodec *m_codec = nullptr;
     ST_AVCodecContext *m_codecCtx = nullptr;
     int m_audioStreamIdx = -1;
+
+  private:
+    /// <summary>
+    /// 打开格式上下文并探测流信息，传入缓存的探测结果时以最小探测量打开并校验流布局
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="probeInfo">缓存的探测结果，nullptr表示完整探测</param>
+    /// <returns>是否成功，流布局与缓存不一致时返回false</returns>
+    bool OpenFormatContext(const QString &filePath, const ST_StreamProbeInfo *probeInfo);
 };
 
 
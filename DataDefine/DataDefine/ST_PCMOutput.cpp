@@ -0,0 +1,36 @@
+#include "ST_PCMOutput.h"
+
+ST_PCMOutput::ST_PCMOutput(std::vector<uint8_t> &overflow)
+    : m_overflow(overflow)
+{
+}
+
+ST_PCMOutput::ST_PCMOutput(uint8_t *span, size_t spanCapacity, std::vector<uint8_t> &overflow)
+    : m_span(span), m_spanCapacity(span ? spanCapacity : 0), m_overflow(overflow)
+{
+}
+
+uint8_t *ST_PCMOutput::Reserve(size_t maxBytes)
+{
+    // 溢出缓冲区中已有数据时后续输出也必须追加在其后，否则顺序错乱
+    m_bReservedInSpan = m_overflow.empty() && m_spanUsed + maxBytes <= m_spanCapacity;
+    if (m_bReservedInSpan)
+    {
+        return m_span + m_spanUsed;
+    }
+
+    // 溢出缓冲区保留容量，稳定后不再重新分配
+    m_overflowReserveOffset = m_overflow.size();
+    m_overflow.resize(m_overflowReserveOffset + maxBytes);
+    return m_overflow.data() + m_overflowReserveOffset;
+}
+
+void ST_PCMOutput::Commit(size_t bytes)
+{
+    if (m_bReservedInSpan)
+    {
+        m_spanUsed += bytes;
+        return;
+    }
+    m_overflow.resize(m_overflowReserveOffset + bytes);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// PCM输出目标
+/// 优先写入调用方提供的连续空间（如环形缓冲区的写入窗口），放不下时按顺序写入溢出缓冲区；
+/// 写入方先Reserve最大字节数，直接写入返回的指针后Commit实际字节数，中间不产生拷贝
+/// </summary>
+class ST_PCMOutput
+{
+  public:
+    /// <summary>
+    /// 只写入溢出缓冲区
+    /// </summary>
+    /// <param name="overflow">溢出缓冲区（在末尾追加）</param>
+    explicit ST_PCMOutput(std::vector<uint8_t> &overflow);
+
+    /// <summary>
+    /// 优先写入连续空间
+    /// </summary>
+    /// <param name="span">连续空间起始地址</param>
+    /// <param name="spanCapacity">连续空间大小（字节）</param>
+    /// <param name="overflow">溢出缓冲区（在末尾追加）</param>
+    ST_PCMOutput(uint8_t *span, size_t spanCapacity, std::vector<uint8_t> &overflow);
+
+    ST_PCMOutput(const ST_PCMOutput &) = delete;
+    ST_PCMOutput &operator=(const ST_PCMOutput &) = delete;
+
+    /// <summary>
+    /// 预留写入空间；连续空间放不下或已开始使用溢出缓冲区时在溢出缓冲区末尾预留，保证输出顺序
+    /// </summary>
+    /// <param name="maxBytes">最多写入的字节数</param>
+    /// <returns>写入位置的指针，在Commit之前有效</returns>
+    uint8_t *Reserve(size_t maxBytes);
+
+    /// <summary>
+    /// 提交上一次Reserve后实际写入的字节数
+    /// </summary>
+    /// <param name="bytes">实际写入的字节数，不超过预留的字节数</param>
+    void Commit(size_t bytes);
+
+    /// <summary>
+    /// 获取写入连续空间的字节数
+    /// </summary>
+    size_t GetSpanUsed() const
+    {
+        return m_spanUsed;
+    }
+
+  private:
+    uint8_t *m_span{nullptr};           /// 连续空间起始地址
+    size_t m_spanCapacity{0};           /// 连续空间大小（字节）
+    size_t m_spanUsed{0};               /// 连续空间已写入的字节数
+    std::vector<uint8_t> &m_overflow;   /// 溢出缓冲区
+    size_t m_overflowReserveOffset{0};  /// 在溢出缓冲区中预留的起始偏移
+    bool m_bReservedInSpan{false};      /// 上一次预留是否在连续空间中
+};
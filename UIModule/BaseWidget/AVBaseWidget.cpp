@@ -88,6 +88,20 @@ void AVBaseWidget::ConnectSignals()
 
     // 连接进度条信号
     connect(ui->ControlButtons, &ControlButtonWidget::SigProgressChanged , this, &AVBaseWidget::SlotProgressBarValueChanged);
+    connect(ui->ControlButtons, &ControlButtonWidget::SigProgressDragStarted, this, [this]()
+    {
+        if (m_playerManager)
+        {
+            m_playerManager->BeginSeekDrag();
+        }
+    });
+    connect(ui->ControlButtons, &ControlButtonWidget::SigProgressDragFinished, this, [this]()
+    {
+        if (m_playerManager)
+        {
+            m_playerManager->EndSeekDrag();
+        }
+    });
 
     // 连接播放进度更新定时器
     connect(m_playTimer, &QTimer::timeout, this, &AVBaseWidget::SlotUpdatePlayProgress);
@@ -100,6 +114,9 @@ void AVBaseWidget::ConnectSignals()
             ui->ControlButtons->UpdateRecordState(isRecording);
         });
         connect(m_playerManager, &MediaPlayerManager::SigPlayerFinished, this, &AVBaseWidget::SlotAVPlayFinished);
+        connect(m_playerManager, &MediaPlayerManager::SigTrackChanged, this, &AVBaseWidget::SlotAVTrackChanged);
+        connect(m_playerManager, &MediaPlayerManager::SigMediaPlayStarted, this, &AVBaseWidget::SlotAVPlayStarted);
+        connect(m_playerManager, &MediaPlayerManager::SigMediaPlayFailed, this, &AVBaseWidget::SlotAVPlayFailed);
     }
 }
 
@@ -130,6 +147,13 @@ void AVBaseWidget::SlotBtnPlayClicked()
     LOG_INFO("播放按钮被点击");
     ui->ControlButtons->SetButtonEnabled(ControlButtonWidget::EM_ControlButtonType::Play, false);
 
+    // 正在打开文件时忽略，避免重复发起播放请求
+    if (m_playerManager && m_playerManager->IsLoading())
+    {
+        ui->ControlButtons->SetButtonEnabled(ControlButtonWidget::EM_ControlButtonType::Play, true);
+        return;
+    }
+
     if (!m_currentAVFile.isEmpty())
     {
         if (!GetIsPlaying())
@@ -177,27 +201,35 @@ void AVBaseWidget::StartAVPlay(const QString& filePath, double startPosition)
         return;
     }
 
-    // 使用MediaPlayerManager播放媒体文件
-    if (m_playerManager->PlayMedia(filePath, startPosition))
-    {
-        // 获取并设置总时长（转换为毫秒）
-        double duration = m_playerManager->GetDuration();
-        qint64 durationMs = static_cast<qint64>(duration * 1000);
-        ui->ControlButtons->SetDuration(durationMs);
-        
-        // 设置初始进度（毫秒）
-        qint64 startPositionMs = static_cast<qint64>(startPosition * 1000);
-        ui->ControlButtons->SetProgressValue(startPositionMs);
-        
-        m_playTimer->start();
-        LOG_INFO("Media playback started successfully, duration: " + std::to_string(duration) + " seconds");
-    }
-    else
-    {
-        m_playTimer->stop();
-        LOG_WARN("Failed to start media playback");
-        QMessageBox::warning(this, "错误", "播放失败");
-    }
+    // 打开文件和启动播放在工作线程中完成，结果通过SigMediaPlayStarted/SigMediaPlayFailed返回
+    m_playTimer->stop();
+    m_preparedNextAVFile.clear();
+    m_playerManager->PlayMediaAsync(filePath, startPosition);
+}
+
+void AVBaseWidget::SlotAVPlayStarted(const QString& filePath, double startPosition)
+{
+    // 获取并设置总时长（转换为毫秒）
+    double duration = m_playerManager->GetDuration();
+    qint64 durationMs = static_cast<qint64>(duration * 1000);
+    ui->ControlButtons->SetDuration(durationMs);
+
+    // 设置初始进度（毫秒）
+    qint64 startPositionMs = static_cast<qint64>(startPosition * 1000);
+    ui->ControlButtons->SetProgressValue(startPositionMs);
+
+    m_playTimer->start();
+    LOG_INFO("Media playback started successfully: " + filePath.toStdString() + ", duration: " + std::to_string(duration) + " seconds");
+
+    PrepareNextAVFile();
+}
+
+void AVBaseWidget::SlotAVPlayFailed(const QString& filePath)
+{
+    m_playTimer->stop();
+    ui->ControlButtons->UpdatePlayState(false);
+    LOG_WARN("Failed to start media playback: " + filePath.toStdString());
+    QMessageBox::warning(this, "错误", "播放失败");
 }
 
 void AVBaseWidget::StopAVPlay()
@@ -211,10 +243,59 @@ void AVBaseWidget::StopAVPlay()
 
     // 停止进度更新定时器
     m_playTimer->stop();
+    m_preparedNextAVFile.clear();
 
     LOG_INFO("媒体播放已停止");
 }
 
+void AVBaseWidget::PrepareNextAVFile()
+{
+    m_preparedNextAVFile.clear();
+    if (!m_playerManager)
+    {
+        return;
+    }
+
+    QString nextFilePath;
+    int currentIndex = GetFileIndex(m_currentAVFile);
+    if (currentIndex != -1 && currentIndex + 1 < ui->audioFileList->GetItemCount())
+    {
+        FilePathIconListWidgetItem* nextItem = ui->audioFileList->GetItem(currentIndex + 1);
+        if (nextItem)
+        {
+            nextFilePath = nextItem->GetNodeInfo().filePath;
+        }
+    }
+
+    if (m_playerManager->PrepareNextTrack(nextFilePath))
+    {
+        m_preparedNextAVFile = nextFilePath;
+    }
+}
+
+void AVBaseWidget::SlotAVTrackChanged(const QString& filePath)
+{
+    LOG_INFO("Gapless track change: " + filePath.toStdString());
+
+    m_currentAVFile = filePath;
+    m_currentPosition = 0.0;
+    ui->ControlButtons->SetCurrentAudioFile(filePath);
+
+    int index = GetFileIndex(filePath);
+    if (index != -1)
+    {
+        ui->audioFileList->setCurrentItem(ui->audioFileList->GetItem(index));
+    }
+
+    // 更新新音轨的总时长和进度（毫秒）
+    qint64 durationMs = static_cast<qint64>(m_playerManager->GetDuration() * 1000);
+    ui->ControlButtons->SetDuration(durationMs);
+    ui->ControlButtons->SetProgressValue(0);
+    emit SigAVFileSelected(filePath);
+
+    PrepareNextAVFile();
+}
+
 void AVBaseWidget::SlotAVPlayFinished()
 {
     StopAVPlay();
@@ -570,8 +651,8 @@ void AVBaseWidget::SlotProgressBarValueChanged(qint64 value)
     {
         m_currentPosition = value / 1000.0;
 
-        // 跳转播放位置（转换为秒）
-        m_playerManager->SeekPlay(m_currentPosition);
+        // 跳转播放位置（转换为秒），拖动产生的连续请求由播放管理器合并
+        m_playerManager->RequestSeek(m_currentPosition);
     }
 }
 
@@ -598,8 +679,8 @@ void AVBaseWidget::SlotUpdatePlayProgress()
 
     m_isProgressBarUpdating = false;
 
-    // 检查播放是否完成
-    if (currentPos >= duration && duration > 0)
+    // 检查播放是否完成，已预备下一首时由播放器无缝切换
+    if (currentPos >= duration && duration > 0 && m_preparedNextAVFile.isEmpty())
     {
         emit SigAVPlayFinished();
     }
@@ -122,6 +122,25 @@ protected slots:
     /// </summary>
     void SlotUpdatePlayProgress();
 
+    /// <summary>
+    /// 无缝切换到下一首槽函数
+    /// </summary>
+    /// <param name="filePath">新音轨文件路径</param>
+    void SlotAVTrackChanged(const QString& filePath);
+
+    /// <summary>
+    /// 异步播放已开始槽函数
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    void SlotAVPlayStarted(const QString& filePath, double startPosition);
+
+    /// <summary>
+    /// 异步播放失败槽函数
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    void SlotAVPlayFailed(const QString& filePath);
+
 protected:
     /// <summary>
     /// 窗口关闭事件
@@ -164,6 +183,11 @@ private:
     /// </summary>
     void StopAVPlay();
 
+    /// <summary>
+    /// 预备播放列表中当前文件的下一项，用于无缝播放（列表末尾不循环）
+    /// </summary>
+    void PrepareNextAVFile();
+
     /// <summary>
     /// 启动音视频录制
     /// </summary>
@@ -263,6 +287,7 @@ private:
     PlayerAudioModuleWidget* m_audioPlayerWidget{nullptr}; /// 音频播放器模块控件
     PlayerVideoModuleWidget* m_videoPlayerWidget{nullptr}; /// 视频播放器模块控件
     QString m_currentAVFile;                                /// 当前播放的音视频文件
+    QString m_preparedNextAVFile;                           /// 已预备无缝播放的下一个文件
     QTimer* m_playTimer{nullptr};                           /// 播放定时器
     double m_currentPosition{0.0};                          /// 当前播放位置（秒）
     bool m_isProgressBarUpdating{false};                    /// 进度条更新标志，防止循环更新
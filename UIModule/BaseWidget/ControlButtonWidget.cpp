@@ -1,5 +1,6 @@
 ﻿#include "ControlButtonWidget.h"
 #include "ui_ControlButtonWidget.h"
+#include <QSlider>
 #include <QTimer>
 #include "CommonDefine/UIWidgetColorDefine.h"
 #include "UtilsWidget/CustomToolTips.h"
@@ -48,6 +49,18 @@ void ControlButtonWidget::ConnectSignals()
     connect(ui->btnNext, &CustomToolButton::clicked, this, &ControlButtonWidget::SigNextClicked);
     connect(ui->btnPrevious, &CustomToolButton::clicked, this, &ControlButtonWidget::SigPreviousClicked);
     connect(ui->musicProgressBar, &MusicProgressBar::SigPositionChanged, this, &ControlButtonWidget::SigProgressChanged);
+
+    // 拖动状态取自进度条的滑块信号，点击跳转不产生拖动
+    QSlider* progressSlider = qobject_cast<QSlider*>(ui->musicProgressBar);
+    if (!progressSlider)
+    {
+        progressSlider = ui->musicProgressBar->findChild<QSlider*>();
+    }
+    if (progressSlider)
+    {
+        connect(progressSlider, &QSlider::sliderPressed, this, &ControlButtonWidget::SigProgressDragStarted);
+        connect(progressSlider, &QSlider::sliderReleased, this, &ControlButtonWidget::SigProgressDragFinished);
+    }
 }
 
 void ControlButtonWidget::UpdatePlayState(bool isPlaying)
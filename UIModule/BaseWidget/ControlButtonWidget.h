@@ -144,6 +144,16 @@ signals:
     /// </summary>
     /// <param name="value"></param>
     void SigProgressChanged(qint64 value);
+
+    /// <summary>
+    /// 进度条滑块按下信号
+    /// </summary>
+    void SigProgressDragStarted();
+
+    /// <summary>
+    /// 进度条滑块松开信号
+    /// </summary>
+    void SigProgressDragFinished();
 private:
     /// <summary>
     /// 初始化界面
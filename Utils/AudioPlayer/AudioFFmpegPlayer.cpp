@@ -1,8 +1,11 @@
 ﻿#include "AudioFFmpegPlayer.h"
+#include <algorithm>
+#include <cmath>
 #include <QFile>
 #include "AudioPlayerUtils.h"
 
 #include "AudioResampler.h"
+#include "AVFileSystem.h"
 #include "CoreServerGlobal.h"
 #include "../BasePlayer/FFmpegPublicUtils.h"
 #include "BaseDataDefine/ST_AVCodec.h"
@@ -12,6 +15,7 @@
 #include "BaseDataDefine/ST_AVFrame.h"
 #include "DataDefine/ST_AudioDecodeResult.h"
 #include "DataDefine/ST_OpenFileResult.h"
+#include "DataDefine/ST_PCMOutput.h"
 #include "DataDefine/ST_ResampleParams.h"
 #include "DataDefine/ST_ResampleResult.h"
 #include "FileSystem/FileSystem.h"
@@ -54,6 +58,9 @@ AudioFFmpegPlayer::~AudioFFmpegPlayer()
     {
         m_recordDevice.reset();
     }
+
+    // 等待正在执行的预备任务结束，之后才开始的任务不再访问播放器
+    WaitForPrepareTasks(true);
 }
 
 
@@ -177,27 +184,30 @@ void AudioFFmpegPlayer::StopRecording()
 
 void AudioFFmpegPlayer::StartPlay(const QString& inputFilePath, bool bStart, double startPosition, const QStringList& args)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    PlayerStateReSet();
-
-    // 记录播放开始时间和位置
-    RecordPlayStartTime(startPosition);
-
     // 使用时间系统进行整体计时
     TIME_START("AudioPlaybackTotal");
     LOG_INFO("=== Starting audio playback: " + inputFilePath.toStdString() + ", start position: " + std::to_string(startPosition) + " seconds ===");
-    m_playInfo = std::make_unique<ST_AudioPlayInfo>();
 
-    // 使用基类的通用文件打开功能
+    // 打开、探测文件和创建解码器不持有m_mutex，期间其他线程对播放器的查询和控制不会被阻塞
     TIME_START("AudioFileOpen");
-    auto openFileResult = OpenMediaFile(inputFilePath);
-    if (!openFileResult)
+    ST_OutputFormat outputFormat;
+    std::unique_ptr<AudioTrackDecoder> trackDecoder = OpenPlaybackTrack(inputFilePath, outputFormat);
+    TimeSystem::Instance().StopTimingWithLog("AudioFileOpen", EM_TimingLogLevel::Info);
+
+    // 只在安装新音轨时持有m_mutex
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    PlayerStateReSet();
+    if (!trackDecoder)
     {
         LOG_ERROR("Failed to open audio file: " + inputFilePath.toStdString());
         return;
     }
-    TimeSystem::Instance().StopTimingWithLog("AudioFileOpen", EM_TimingLogLevel::Info);
 
+    SetCurrentFilePath(inputFilePath);
+    SetDuration(trackDecoder->GetDuration());
+    m_outSampleRate = outputFormat.m_sampleRate;
+    m_outSampleFormat = outputFormat.m_sampleFormat;
+    m_outChannels = outputFormat.m_channels;
     LOG_INFO("Audio duration: " + std::to_string(GetDuration()) + " seconds");
 
     // 确保起始位置在有效范围内
@@ -207,101 +217,20 @@ void AudioFFmpegPlayer::StartPlay(const QString& inputFilePath, bool bStart, dou
         startPosition = GetDuration();
     }
 
-    // 如果指定了起始位置，执行定位
-    if (startPosition > 0.0)
-    {
-        TIME_START("AudioSeek");
-        LOG_INFO("Seeking to position: " + std::to_string(startPosition) + " seconds");
-
-        // 确保不会超出音频范围
-        if (startPosition > GetDuration())
-        {
-            startPosition = GetDuration();
-        }
-
-        // 使用通用的seek功能
-        if (!FFmpegPublicUtils::SeekAudio(openFileResult->m_formatCtx->GetRawContext(), openFileResult->m_codecCtx->GetRawContext(), startPosition))
-        {
-            return;
-        }
-        TimeSystem::Instance().StopTimingWithLog("AudioSeek", EM_TimingLogLevel::Info);
-    }
-
-    // 初始化音频流索引
-    m_audioStreamIdx = openFileResult->m_audioStreamIdx;
-
-    // 创建或重用重采样器
-    if (!m_resampler)
-    {
-        m_resampler = std::make_unique<AudioResampler>();
-    }
-
-    // 创建或重用重采样参数
-    if (!m_resampleParams)
-    {
-        m_resampleParams = std::make_unique<ST_ResampleParams>();
-    }
-
-    // 重置重采样参数更新标记
-    m_bResampleParamsUpdated = false;
-
-    // 获取音频参数
-    AVStream* audioStream = openFileResult->m_formatCtx->GetRawContext()->streams[m_audioStreamIdx];
-    AVCodecParameters* codecpar = audioStream->codecpar;
-    AVCodecContext* codecCtx = openFileResult->m_codecCtx->GetRawContext();
-
-    // 设置实际的输入参数（优先使用解码器上下文的参数）
-    int inputSampleRate = (codecCtx->sample_rate > 0) ? codecCtx->sample_rate : codecpar->sample_rate;
-    AVSampleFormat inputFormat = (codecCtx->sample_fmt != AV_SAMPLE_FMT_NONE) ? codecCtx->sample_fmt : static_cast<AVSampleFormat>(codecpar->format);
-
-    // 如果格式仍然是NONE，则设置一个默认值
-    if (inputFormat == AV_SAMPLE_FMT_NONE)
-    {
-        LOG_WARN("Audio format is AV_SAMPLE_FMT_NONE, will update from first decoded frame");
-        inputFormat = AV_SAMPLE_FMT_FLTP;
-    }
-
-    m_resampleParams->GetInput().SetSampleRate(inputSampleRate);
-    m_resampleParams->GetInput().SetSampleFormat(ST_AVSampleFormat(inputFormat));
-
-    // 设置输入通道布局
-    AVChannelLayoutRAII inLayout;
-    if (codecCtx->ch_layout.nb_channels > 0)
-    {
-        inLayout = AVChannelLayoutRAII::copyFrom(&codecCtx->ch_layout);
-    }
-    else
-    {
-        inLayout = AVChannelLayoutRAII::copyFrom(&codecpar->ch_layout);
-    }
-
-    if (inLayout)
-    {
-        m_resampleParams->GetInput().SetChannelLayout(ST_AVChannelLayout(inLayout.release()));
-    }
-
-    // 设置标准的输出参数
-    m_resampleParams->GetOutput().SetSampleRate(44100);
-    m_resampleParams->GetOutput().SetSampleFormat(ST_AVSampleFormat(AV_SAMPLE_FMT_S16));
-
-    // 设置输出通道布局
-    auto outLayout = AVChannelLayoutRAII::createDefault(2);
-    if (outLayout)
-    {
-        m_resampleParams->GetOutput().SetChannelLayout(ST_AVChannelLayout(outLayout.release()));
-    }
+    // 记录播放开始时间和位置
+    RecordPlayStartTime(startPosition);
+    m_playInfo = std::make_unique<ST_AudioPlayInfo>();
 
-    LOG_INFO("Audio parameters - Input: " + std::to_string(inputSampleRate) + "Hz, " + std::to_string(codecpar->ch_layout.nb_channels) + " channels");
-    LOG_INFO("Audio parameters - Output: 44100Hz, 2 channels, S16 format");
+    ST_ResampleParams& resampleParams = trackDecoder->GetResampleParams();
 
     // 优化SDL音频规格配置
     SDL_AudioSpec wantedSpec;
     memset(&wantedSpec, 0, sizeof(wantedSpec));
 
     // 使用重采样器的输出参数配置SDL
-    wantedSpec.freq = m_resampleParams->GetOutput().GetSampleRate();
-    wantedSpec.format = FFmpegPublicUtils::FFmpegToSDLFormat(m_resampleParams->GetOutput().GetSampleFormat().sampleFormat);
-    wantedSpec.channels = m_resampleParams->GetOutput().GetChannelLayout().GetRawLayout()->nb_channels;
+    wantedSpec.freq = resampleParams.GetOutput().GetSampleRate();
+    wantedSpec.format = FFmpegPublicUtils::FFmpegToSDLFormat(resampleParams.GetOutput().GetSampleFormat().sampleFormat);
+    wantedSpec.channels = resampleParams.GetOutput().GetChannelLayout().GetRawLayout()->nb_channels;
 
     LOG_INFO("SDL Audio Spec - Freq: " + std::to_string(wantedSpec.freq) + ", Format: " + std::to_string(wantedSpec.format) + ", Channels: " + std::to_string(wantedSpec.channels));
 
@@ -330,6 +259,27 @@ void AudioFFmpegPlayer::StartPlay(const QString& inputFilePath, bool bStart, dou
         return;
     }
 
+    // 预分配PCM环形缓冲区（按最大预读窗口加一定余量），音频回调只从中拷贝数据
+    // 容量和回调拷贝缓冲区均为整数个样本帧，多声道格式的帧大小不一定整除2的幂
+    const size_t frameSize = SDL_AUDIO_FRAMESIZE(wantedSpec);
+    const size_t ringFrames = static_cast<size_t>(wantedSpec.freq) * MAX_LOOKAHEAD_MS / 1000 + static_cast<size_t>(wantedSpec.freq) / 4;
+    m_pcmRing.Init(ringFrames * frameSize);
+    m_callbackBuffer.resize(std::max(CALLBACK_BUFFER_SIZE / frameSize, static_cast<size_t>(1)) * frameSize);
+    m_underrunCount.store(0);
+    m_streamPutFailCount.store(0);
+    m_clockFrameSize.store(SDL_AUDIO_FRAMESIZE(wantedSpec));
+    // 设备缓冲区按设备采样率计数，时钟按音频流采样率计数，采样率不同时换算为音频流的样本帧
+    int64_t deviceBufferFrames = m_playInfo->GetAudioDeviceBufferFrames();
+    SDL_AudioSpec deviceSpec;
+    if (SDL_GetAudioDeviceFormat(deviceId, &deviceSpec, nullptr) && deviceSpec.freq > 0 && deviceSpec.freq != wantedSpec.freq)
+    {
+        deviceBufferFrames = deviceBufferFrames * wantedSpec.freq / deviceSpec.freq;
+    }
+    m_deviceBufferFrames.store(deviceBufferFrames);
+    m_clockSampleRate.store(wantedSpec.freq);
+    LOG_INFO("Audio device buffer: " + std::to_string(m_deviceBufferFrames.load()) + " sample frames at " + std::to_string(wantedSpec.freq) + " Hz");
+    m_playInfo->SetAudioStreamGetCallback(&AudioFFmpegPlayer::AudioStreamGetCallback, this);
+
     m_playInfo->BindStreamAndDevice();
 
     // Start playback
@@ -337,239 +287,976 @@ void AudioFFmpegPlayer::StartPlay(const QString& inputFilePath, bool bStart, dou
     {
         m_playInfo->BeginPlayAudio();
         m_playState.TransitionTo(AVPlayState::Playing);
+        m_bClockRunning.store(true);
     }
     else
     {
         m_playState.TransitionTo(AVPlayState::Paused);
     }
     LOG_INFO("Audio playback started");
-    ProcessAudioData(*openFileResult, *m_resampler, *m_resampleParams, startPosition);
+
+    // 保留解码上下文，由音频解码线程按预读窗口持续解码
+    {
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+        m_trackDecoder = std::move(trackDecoder);
+        m_playingFilePath = inputFilePath;
+        m_playingDuration = GetDuration();
+    }
+    ProcessAudioData(startPosition);
     TimeSystem::Instance().StopTimingWithLog("AudioPlaybackTotal", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Audio playback initialization completed");
 }
 
-void AudioFFmpegPlayer::ProcessAudioData(const ST_OpenFileResult& openFileResult, AudioResampler& resampler, ST_ResampleParams& resampleParams, double startSeconds)
+void AudioFFmpegPlayer::ProcessAudioData(double startSeconds)
 {
-    TIME_START("AudioDataProcessing");
-    LOG_INFO("=== Starting audio data processing from position: " + std::to_string(startSeconds) + " seconds ===");
+    LOG_INFO("=== Starting audio data processing from position: " + std::to_string(startSeconds) + " seconds, lookahead: " + std::to_string(GetLookaheadMs()) + " ms ===");
 
-    // 处理音频数据
-    ST_AVPacket pkt;
-    const int BUFFER_SIZE = 8192;
-
-    // 清空之前的缓冲区
     {
-        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-        m_audioBuffer.clear();
-        m_audioBuffer.reserve(BUFFER_SIZE * 4);
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+        ResetDecodeState(startSeconds);
     }
 
-    int processedPackets = 0;
-    int processedFrames = 0;
+    // 解码和重采样在独立线程中进行，调用线程只负责启动
+    StartAudioDecodeThread();
+}
 
-    // 使用成员变量的重采样参数更新标记
-    ST_AVFrame frame;
-    FFmpegPublicUtils::SeekAudio(openFileResult.m_formatCtx->GetRawContext(), openFileResult.m_codecCtx->GetRawContext(), startSeconds);
+bool AudioFFmpegPlayer::ResetDecodeState(double startSeconds, bool bAccurate)
+{
+    m_bInputEOF = false;
+    m_bDecodeEOF.store(false);
+    m_bRingPrimed.store(false);
+    m_pendingPCM.clear();
+    m_pendingOffset = 0;
+    ResetAudioClock(startSeconds);
+
+    // 使已发出但尚未处理的结束通知失效，重新开始检测
+    ++m_endOfStreamGeneration;
+    m_drainTicksNS.store(0);
+    m_bEndOfStreamSignalled.store(false);
+    m_bEndOfStreamPending.store(false);
+    m_bEndOfStreamPosted.store(false);
+
+    if (!m_trackDecoder)
+    {
+        return false;
+    }
 
-    // 标记是否处于seek后的跳过早期帧阶段
-    bool bSkipEarlyFrames = true;
-    int skippedFrames = 0;
+    // 预览定位不裁剪到目标，时钟需按实际解码出的首个样本重新定位
+    m_bClockAnchorPending = !bAccurate && !m_trackDecoder->IsInMemory();
+    return m_trackDecoder->Seek(startSeconds, bAccurate);
+}
 
-    while (pkt.ReadPacket(openFileResult.m_formatCtx->GetRawContext()))
+void AudioFFmpegPlayer::FillAudioLookahead()
+{
+    if (!m_trackDecoder)
     {
-        if (pkt.GetRawPacket()->stream_index == m_audioStreamIdx)
+        return;
+    }
+
+    const size_t lookaheadBytes = static_cast<size_t>(GetLookaheadBytes());
+    // 回调中数据降到预读窗口一半以下时唤醒解码线程
+    m_refillThresholdBytes.store(lookaheadBytes / 2, std::memory_order_relaxed);
+    while (!m_bDecodeEOF.load())
+    {
+        // 先写入上次剩余的数据，环形缓冲区已满时等待消费
+        if (!WritePendingPCM())
         {
-            // 发送数据包到解码器
-            if (!pkt.SendPacket(openFileResult.m_codecCtx->GetRawContext()))
+            break;
+        }
+
+        if (m_bInputEOF)
+        {
+            CacheTrackPCM();
+
+            // 已预备下一首音轨时直接衔接，不产生静音间隙
+            if (SpliceNextTrack())
             {
                 continue;
             }
-            // 接收解码后的帧
-            while (frame.GetCodecFrame(openFileResult.m_codecCtx->GetRawContext()))
+
+            m_bDecodeEOF.store(true);
+            m_bRingPrimed.store(true);
+            LOG_INFO("Audio decode reached end of file");
+            break;
+        }
+
+        if (m_pcmRing.GetReadableBytes() >= lookaheadBytes)
+        {
+            m_bRingPrimed.store(true);
+            break;
+        }
+
+        // 内存音轨直接从内存写入环形缓冲区，不经过待写入缓冲区
+        if (m_trackDecoder->IsInMemory())
+        {
+            if (!WriteMemoryPCM(lookaheadBytes - m_pcmRing.GetReadableBytes()))
             {
-                processedFrames++;
-
-                // 获取音频帧时间戳
-                double audioPTS = 0.0;
-                if (frame.GetRawFrame()->pts != AV_NOPTS_VALUE)
-                {
-                    AVStream* audioStream = openFileResult.m_formatCtx->GetRawContext()->streams[m_audioStreamIdx];
-                    audioPTS = frame.GetRawFrame()->pts * av_q2d(audioStream->time_base);
-                }
-
-                // 在seek后跳过所有PTS小于目标时间的帧
-                if (bSkipEarlyFrames && audioPTS < startSeconds)
-                {
-                    skippedFrames++;
-                    LOG_DEBUG("Skipping early audio frame after seek: audioPTS=" + std::to_string(audioPTS) + ", target=" + std::to_string(startSeconds));
-                    continue;
-                }
-
-                // 找到第一个符合要求的帧，重置标记
-                if (bSkipEarlyFrames)
-                {
-                    bSkipEarlyFrames = false;
-                    LOG_INFO("Found first valid audio frame after seek: audioPTS=" + std::to_string(audioPTS) + ", target=" + std::to_string(startSeconds) + ", skipped=" + std::to_string(skippedFrames) + " frames");
-                }
-
-                // === 修复：在第一次获取解码帧时更新重采样参数 ===
-                if (!m_bResampleParamsUpdated)
-                {
-                    AVFrame* rawFrame = frame.GetRawFrame();
-
-                    // 从实际解码的帧获取正确的音频格式
-                    auto actualFormat = static_cast<AVSampleFormat>(rawFrame->format);
-                    int actualSampleRate = rawFrame->sample_rate;
-
-                    LOG_INFO("Updating resample params from first decoded frame:");
-                    LOG_INFO("  Actual format: " + std::to_string(static_cast<int>(actualFormat)) + " (" + std::string(av_get_sample_fmt_name(actualFormat)) + ")");
-                    LOG_INFO("  Actual sample rate: " + std::to_string(actualSampleRate));
-                    LOG_INFO("  Actual channels: " + std::to_string(rawFrame->ch_layout.nb_channels));
-
-                    // 更新重采样参数
-                    m_resampleParams->GetInput().SetSampleFormat(ST_AVSampleFormat(actualFormat));
-                    if (actualSampleRate > 0)
-                    {
-                        m_resampleParams->GetInput().SetSampleRate(actualSampleRate);
-                    }
-
-                    // 使用RAII包装器更新通道布局
-                    if (rawFrame->ch_layout.nb_channels > 0)
-                    {
-                        auto inLayout = AVChannelLayoutRAII::copyFrom(&rawFrame->ch_layout);
-                        if (inLayout)
-                        {
-                            m_resampleParams->GetInput().SetChannelLayout(ST_AVChannelLayout(inLayout.release()));
-                        }
-                    }
-
-                    m_bResampleParamsUpdated = true;
-                }
-
-                // 直接使用AVFrame进行重采样，避免数据格式转换问题
-                ST_ResampleResult resampleResult;
-
-                // 准备输入数据指针数组
-                const uint8_t* inputDataPtrs[AV_NUM_DATA_POINTERS] = {0};
-
-                // 检查是否为平面格式
-                bool isPlanar = av_sample_fmt_is_planar(static_cast<AVSampleFormat>(frame.GetRawFrame()->format));
-                int channels = frame.GetRawFrame()->ch_layout.nb_channels;
-
-                if (isPlanar)
-                {
-                    // 平面格式：每个通道分别存储
-                    for (int ch = 0; ch < channels && ch < AV_NUM_DATA_POINTERS; ch++)
-                    {
-                        inputDataPtrs[ch] = frame.GetRawFrame()->data[ch];
-                    }
-                }
-                else
-                {
-                    // 交错格式：所有通道数据交错存储
-                    inputDataPtrs[0] = frame.GetRawFrame()->data[0];
-                }
-
-                // 执行重采样
-                TIME_START("AudioResample");
-                m_resampler->Resample(inputDataPtrs, frame.GetRawFrame()->nb_samples, resampleResult, *m_resampleParams);
-                double resampleDuration = TimeSystem::Instance().StopTiming("AudioResample", EM_TimeUnit::Microseconds);
-
-                // 只在耗时较长时记录重采样时间
-                if (resampleDuration > 1000) // 大于1ms才记录
-                {
-                    LOG_DEBUG("Frame resampling took " + std::to_string(resampleDuration) + " μs");
-                }
-
-                // 将重采样后的数据添加到缓冲区
-                if (!resampleResult.GetData().empty())
-                {
-                    {
-                        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-                        m_audioBuffer.insert(m_audioBuffer.end(), resampleResult.GetData().begin(), resampleResult.GetData().end());
-
-                        // 当缓冲区达到一定大小时才传输
-                        if (m_audioBuffer.size() >= BUFFER_SIZE)
-                        {
-                            m_playInfo->PutDataToStream(m_audioBuffer.data(), static_cast<int>(m_audioBuffer.size()));
-                            m_audioBuffer.clear();
-                        }
-                    }
-                }
+                break;
             }
-            processedPackets++;
+            continue;
+        }
+
+        // 解码结果直接写入环形缓冲区的连续写入窗口，放不下的部分进入待写入缓冲区
+        size_t spanBytes = 0;
+        uint8_t* span = m_pcmRing.GetWriteSpan(spanBytes);
+        ST_PCMOutput output(span, spanBytes, m_pendingPCM);
+        const bool bMore = m_trackDecoder->DecodePacket(output);
+        if (output.GetSpanUsed() > 0 || !m_pendingPCM.empty())
+        {
+            AnchorClockAtFirstOutput();
+        }
+        if (output.GetSpanUsed() > 0)
+        {
+            m_pcmRing.CommitWrite(output.GetSpanUsed());
+            RecordSeekLatency();
+        }
+
+        if (!bMore)
+        {
+            // 文件结束：取出重采样器中的剩余数据
+            m_trackDecoder->Flush(m_pendingPCM);
+            m_bInputEOF = true;
         }
+    }
+}
+
+void AudioFFmpegPlayer::AnchorClockAtFirstOutput()
+{
+    if (!m_bClockAnchorPending)
+    {
+        return;
+    }
+    m_bClockAnchorPending = false;
+
+    int sourceSampleRate = 0;
+    int sourceChannels = 0;
+    AVSampleFormat sourceFormat = AV_SAMPLE_FMT_NONE;
+    m_trackDecoder->GetSourceFormat(sourceSampleRate, sourceChannels, sourceFormat);
+    const int64_t firstSample = m_trackDecoder->GetFirstOutputSample();
+    if (firstSample == AV_NOPTS_VALUE || sourceSampleRate <= 0)
+    {
+        return;
+    }
+
+    // 环形缓冲区从起点开始写入，起点对应实际解码出的首个样本（通常是目标之前的关键帧）
+    const double firstSeconds = std::max(static_cast<double>(firstSample) / sourceSampleRate, 0.0);
+    m_clockOriginFrames.store(-static_cast<int64_t>(std::llround(firstSeconds * m_clockSampleRate.load())), std::memory_order_release);
+    LOG_INFO("Preview seek clock anchored at first decoded sample: " + std::to_string(firstSeconds) + " seconds");
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioFFmpegPlayer::OpenPlaybackTrack(const QString& filePath, ST_OutputFormat& outputFormat)
+{
+    // 已缓存的音轨和PCM WAV直接从内存读取，无需打开解码器
+    std::unique_ptr<AudioTrackDecoder> trackDecoder = OpenCachedTrack(filePath, outputFormat);
+    if (!trackDecoder)
+    {
+        trackDecoder = OpenMappedWavTrack(filePath, outputFormat);
+    }
+    if (trackDecoder)
+    {
+        return trackDecoder;
+    }
 
-        pkt.UnrefPacket();
+    if (filePath.isEmpty() || !my_sdk::FileSystem::Exists(filePath.toStdString()))
+    {
+        LOG_WARN("AudioFFmpegPlayer::OpenPlaybackTrack() : File does not exist: " + filePath.toStdString());
+        return nullptr;
     }
 
-    // 处理剩余的音频数据
+    auto openFileResult = std::make_unique<ST_OpenFileResult>();
+    openFileResult->OpenFilePath(filePath);
+    if (!openFileResult->m_formatCtx || !openFileResult->m_formatCtx->GetRawContext() || !openFileResult->m_codecCtx)
     {
-        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-        if (!m_audioBuffer.empty())
+        LOG_WARN("AudioFFmpegPlayer::OpenPlaybackTrack() : Failed to open file: " + filePath.toStdString());
+        return nullptr;
+    }
+
+    // 协商输出格式并创建音轨解码器，格式一致时解码结果直通输出
+    outputFormat = NegotiateOutputFormat(*openFileResult);
+    trackDecoder = std::make_unique<AudioTrackDecoder>();
+    if (!trackDecoder->Init(std::move(openFileResult), filePath, outputFormat.m_sampleRate, outputFormat.m_sampleFormat, outputFormat.m_channels))
+    {
+        LOG_ERROR("Failed to initialize audio track decoder: " + filePath.toStdString());
+        return nullptr;
+    }
+    trackDecoder->EnableCapture(m_pcmCache.GetBudgetBytes());
+    return trackDecoder;
+}
+
+AudioFFmpegPlayer::ST_OutputFormat AudioFFmpegPlayer::NegotiateOutputFormat(const ST_OpenFileResult& openFileResult) const
+{
+    AVCodecContext* codecCtx = openFileResult.m_codecCtx->GetRawContext();
+    AVCodecParameters* codecpar = openFileResult.m_formatCtx->GetRawContext()->streams[openFileResult.m_audioStreamIdx]->codecpar;
+    int sourceSampleRate = (codecCtx->sample_rate > 0) ? codecCtx->sample_rate : codecpar->sample_rate;
+    int sourceChannels = (codecCtx->ch_layout.nb_channels > 0) ? codecCtx->ch_layout.nb_channels : codecpar->ch_layout.nb_channels;
+    AVSampleFormat sourceFormat = (codecCtx->sample_fmt != AV_SAMPLE_FMT_NONE) ? codecCtx->sample_fmt : static_cast<AVSampleFormat>(codecpar->format);
+    return NegotiateOutputFormat(sourceSampleRate, sourceChannels, sourceFormat);
+}
+
+AudioFFmpegPlayer::ST_OutputFormat AudioFFmpegPlayer::NegotiateOutputFormat(int sourceSampleRate, int sourceChannels, AVSampleFormat sourceFormat) const
+{
+    ST_OutputFormat outputFormat;
+
+    // 查询默认播放设备的首选格式
+    SDL_AudioSpec deviceSpec;
+    memset(&deviceSpec, 0, sizeof(deviceSpec));
+    bool bHasDeviceSpec = SDL_GetAudioDeviceFormat(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &deviceSpec, nullptr);
+    if (!bHasDeviceSpec)
+    {
+        LOG_WARN("Failed to query audio device format: " + std::string(SDL_GetError()));
+    }
+
+    // 采样率：始终保留源采样率，SDL音频流接受任意输入采样率，与设备不一致时由SDL转换，解码侧不再重采样
+    outputFormat.m_sampleRate = (sourceSampleRate > 0) ? sourceSampleRate : DEFAULT_OUTPUT_SAMPLE_RATE;
+
+    // 声道数：设备能容纳时保留源声道数
+    outputFormat.m_channels = (sourceChannels > 0) ? sourceChannels : DEFAULT_OUTPUT_CHANNELS;
+    if (bHasDeviceSpec && deviceSpec.channels > 0 && outputFormat.m_channels > deviceSpec.channels)
+    {
+        outputFormat.m_channels = deviceSpec.channels;
+    }
+
+    // 采样格式：SDL支持的格式保留（平面格式仅交错），双精度等不支持的格式转为32位浮点
+    AVSampleFormat packedFormat = av_get_packed_sample_fmt(sourceFormat);
+    switch (packedFormat)
+    {
+        case AV_SAMPLE_FMT_U8:
+        case AV_SAMPLE_FMT_S16:
+        case AV_SAMPLE_FMT_S32:
+        case AV_SAMPLE_FMT_FLT:
+            outputFormat.m_sampleFormat = packedFormat;
+            break;
+        case AV_SAMPLE_FMT_NONE:
+            outputFormat.m_sampleFormat = DEFAULT_OUTPUT_SAMPLE_FORMAT;
+            break;
+        default:
+            outputFormat.m_sampleFormat = AV_SAMPLE_FMT_FLT;
+            break;
+    }
+
+    LOG_INFO("Negotiated audio output - Source: " + std::to_string(sourceSampleRate) + "Hz/" + std::to_string(sourceChannels) + "ch, Device: " + std::to_string(deviceSpec.freq) + "Hz/" + std::to_string(deviceSpec.channels) + "ch, Output: " + std::to_string(outputFormat.m_sampleRate) + "Hz/" + std::to_string(outputFormat.m_channels) + "ch/" + std::string(av_get_sample_fmt_name(outputFormat.m_sampleFormat)));
+    return outputFormat;
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioFFmpegPlayer::OpenCachedTrack(const QString& filePath, ST_OutputFormat& outputFormat)
+{
+    const qint64 lastModified = AudioPCMCache::GetLastModified(filePath);
+    if (lastModified < 0)
+    {
+        return nullptr;
+    }
+
+    // 按缓存中记录的源格式协商输出格式，设备格式变化时输出格式不同，视为未命中
+    int sourceSampleRate = 0;
+    int sourceChannels = 0;
+    AVSampleFormat sourceFormat = AV_SAMPLE_FMT_NONE;
+    ST_OutputFormat cachedFormat;
+    if (m_pcmCache.FindSourceFormat(filePath, lastModified, sourceSampleRate, sourceChannels, sourceFormat))
+    {
+        cachedFormat = NegotiateOutputFormat(sourceSampleRate, sourceChannels, sourceFormat);
+    }
+
+    auto cacheEntry = m_pcmCache.Find(ST_PCMCacheKey{filePath, lastModified, cachedFormat.m_sampleRate, cachedFormat.m_sampleFormat, cachedFormat.m_channels});
+    auto trackDecoder = std::make_unique<AudioTrackDecoder>();
+    if (!trackDecoder->InitCachedPCM(std::move(cacheEntry)))
+    {
+        return nullptr;
+    }
+
+    outputFormat = cachedFormat;
+    return trackDecoder;
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioFFmpegPlayer::OpenMappedWavTrack(const QString& filePath, ST_OutputFormat& outputFormat)
+{
+    if (av_fileSystem::AVFileSystem::GetAVFileType(filePath.toStdString()) != av_fileSystem::EM_AVFileType::WAV)
+    {
+        return nullptr;
+    }
+
+    auto mappedWav = std::make_unique<ST_MappedWavFile>();
+    if (!mappedWav->Open(filePath))
+    {
+        LOG_INFO("WAV file not eligible for mapped playback, fallback to decoding: " + filePath.toStdString());
+        return nullptr;
+    }
+
+    const ST_OutputFormat wavFormat = NegotiateOutputFormat(mappedWav->GetSampleRate(), mappedWav->GetChannels(), mappedWav->GetSampleFormat());
+    auto trackDecoder = std::make_unique<AudioTrackDecoder>();
+    if (!trackDecoder->InitMappedWav(std::move(mappedWav), filePath, wavFormat.m_sampleRate, wavFormat.m_sampleFormat, wavFormat.m_channels))
+    {
+        return nullptr;
+    }
+
+    outputFormat = wavFormat;
+    return trackDecoder;
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioFFmpegPlayer::OpenTrackDecoder(const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels)
+{
+    if (filePath.isEmpty() || !my_sdk::FileSystem::Exists(filePath.toStdString()))
+    {
+        LOG_WARN("AudioFFmpegPlayer::OpenTrackDecoder() : File does not exist: " + filePath.toStdString());
+        return nullptr;
+    }
+
+    // 已缓存的音轨直接使用缓存的PCM
+    auto cacheEntry = m_pcmCache.Find(ST_PCMCacheKey{filePath, AudioPCMCache::GetLastModified(filePath), outSampleRate, outFormat, outChannels});
+    if (cacheEntry)
+    {
+        auto trackDecoder = std::make_unique<AudioTrackDecoder>();
+        if (trackDecoder->InitCachedPCM(std::move(cacheEntry)))
         {
-            m_playInfo->PutDataToStream(m_audioBuffer.data(), static_cast<int>(m_audioBuffer.size()));
-            m_audioBuffer.clear();
+            return trackDecoder;
         }
     }
 
-    // 刷新重采样器中的剩余数据
-    ST_ResampleResult flushResult;
-    m_resampler->Flush(flushResult, *m_resampleParams);
-    if (!flushResult.GetData().empty())
+    // 格式与输出一致的PCM WAV直接映射读取
+    if (av_fileSystem::AVFileSystem::GetAVFileType(filePath.toStdString()) == av_fileSystem::EM_AVFileType::WAV)
     {
-        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-        m_audioBuffer.insert(m_audioBuffer.end(), flushResult.GetData().begin(), flushResult.GetData().end());
-        if (!m_audioBuffer.empty())
+        auto mappedWav = std::make_unique<ST_MappedWavFile>();
+        auto trackDecoder = std::make_unique<AudioTrackDecoder>();
+        if (mappedWav->Open(filePath) && trackDecoder->InitMappedWav(std::move(mappedWav), filePath, outSampleRate, outFormat, outChannels))
         {
-            m_playInfo->PutDataToStream(m_audioBuffer.data(), static_cast<int>(m_audioBuffer.size()));
-            m_audioBuffer.clear();
+            return trackDecoder;
         }
     }
 
-    // 清空音频流缓冲区，确保seek时不会有旧数据
-    m_playInfo->FlushAudioStream();
-    m_audioPlayerFinishedThreadID = CoreServerGlobal::Instance().GetThreadPool().CreateDedicatedThread("AudioPlayerFinished", [this]()
+    auto openFileResult = std::make_unique<ST_OpenFileResult>();
+    openFileResult->OpenFilePath(filePath);
+
+    auto trackDecoder = std::make_unique<AudioTrackDecoder>();
+    if (!trackDecoder->Init(std::move(openFileResult), filePath, outSampleRate, outFormat, outChannels))
+    {
+        return nullptr;
+    }
+    trackDecoder->EnableCapture(m_pcmCache.GetBudgetBytes());
+    return trackDecoder;
+}
+
+void AudioFFmpegPlayer::CacheTrackPCM()
+{
+    auto cacheEntry = std::make_shared<ST_PCMCacheEntry>();
+    if (!m_trackDecoder->TakeCapturedPCM(cacheEntry->m_pcm))
+    {
+        return;
+    }
+
+    cacheEntry->m_key = ST_PCMCacheKey{m_trackDecoder->GetFilePath(), AudioPCMCache::GetLastModified(m_trackDecoder->GetFilePath()), m_outSampleRate, m_outSampleFormat, m_outChannels};
+    cacheEntry->m_duration = m_trackDecoder->GetDuration();
+    m_trackDecoder->GetSourceFormat(cacheEntry->m_sourceSampleRate, cacheEntry->m_sourceChannels, cacheEntry->m_sourceFormat);
+    m_pcmCache.Insert(std::move(cacheEntry));
+}
+
+void AudioFFmpegPlayer::PrepareNextTrack(const QString& filePath)
+{
+    // 新的预备请求使之前尚未完成的请求失效
+    uint64_t generation = ++m_nextTrackGeneration;
+    {
+        std::lock_guard<std::mutex> nextLock(m_nextTrackMutex);
+        m_nextTrackDecoder.reset();
+    }
+
+    if (filePath.isEmpty())
+    {
+        return;
+    }
+
+    LOG_INFO("Preparing next audio track: " + filePath.toStdString());
+    // 下一首音轨转换为当前会话的输出格式，衔接时无需重新打开设备
+    const int outSampleRate = m_outSampleRate;
+    const AVSampleFormat outFormat = m_outSampleFormat;
+    const int outChannels = m_outChannels;
+    auto taskState = m_prepareTaskState;
+    CoreServerGlobal::Instance().GetThreadPool().Submit([this, taskState, filePath, generation, outSampleRate, outFormat, outChannels]()
     {
-        while (IsPlaying() && m_playInfo)
         {
-            // 如果正在seek，跳过结束判断
-            if (m_playInfo->IsSeeking())
+            std::lock_guard<std::mutex> stateLock(taskState->m_mutex);
+            // 播放器已销毁或请求已过期时直接退出，不访问播放器
+            if (!taskState->m_bOwnerAlive || generation != m_nextTrackGeneration.load())
             {
-                SDL_Delay(50);  // seek期间稍微延长等待时间
-                continue;
+                return;
             }
-            
-            // 只有在非seek状态下才检查数据是否结束
-            if (m_playInfo->GetDataIsEnd())
+            ++taskState->m_runningCount;
+        }
+
+        RunPrepareNextTrack(filePath, generation, outSampleRate, outFormat, outChannels);
+
+        {
+            std::lock_guard<std::mutex> stateLock(taskState->m_mutex);
+            --taskState->m_runningCount;
+        }
+        taskState->m_cond.notify_all();
+    }, EM_TaskPriority::Normal);
+}
+
+void AudioFFmpegPlayer::RunPrepareNextTrack(const QString& filePath, uint64_t generation, int outSampleRate, AVSampleFormat outFormat, int outChannels)
+{
+    auto trackDecoder = OpenTrackDecoder(filePath, outSampleRate, outFormat, outChannels);
+    if (!trackDecoder)
+    {
+        LOG_WARN("Failed to prepare next audio track: " + filePath.toStdString());
+        return;
+    }
+
+    // 打开文件期间请求已过期时不再预解码
+    if (generation != m_nextTrackGeneration.load())
+    {
+        return;
+    }
+
+    // 预解码开头一段数据，衔接时无需等待打开文件和首次解码
+    const size_t bytesPerSecond = static_cast<size_t>(outSampleRate) * outChannels * av_get_bytes_per_sample(outFormat);
+    trackDecoder->Preroll(bytesPerSecond * NEXT_TRACK_PREROLL_MS / 1000);
+
+    std::lock_guard<std::mutex> nextLock(m_nextTrackMutex);
+    if (generation == m_nextTrackGeneration.load())
+    {
+        m_nextTrackDecoder = std::move(trackDecoder);
+        LOG_INFO("Next audio track ready: " + filePath.toStdString());
+    }
+}
+
+void AudioFFmpegPlayer::WaitForPrepareTasks(bool bOwnerDestroyed)
+{
+    std::unique_lock<std::mutex> stateLock(m_prepareTaskState->m_mutex);
+    if (bOwnerDestroyed)
+    {
+        m_prepareTaskState->m_bOwnerAlive = false;
+    }
+    m_prepareTaskState->m_cond.wait(stateLock, [this]()
+    {
+        return m_prepareTaskState->m_runningCount == 0;
+    });
+}
+
+bool AudioFFmpegPlayer::SpliceNextTrack()
+{
+    std::unique_ptr<AudioTrackDecoder> nextTrack;
+    {
+        std::lock_guard<std::mutex> nextLock(m_nextTrackMutex);
+        nextTrack = std::move(m_nextTrackDecoder);
+    }
+
+    if (!nextTrack)
+    {
+        return false;
+    }
+
+    // 待写入数据已全部写入，当前写入位置即新音轨首个样本的位置
+    ST_TrackSplice splice;
+    splice.m_ringPosition = m_pcmRing.GetWritePosition();
+    splice.m_filePath = nextTrack->GetFilePath();
+    splice.m_duration = nextTrack->GetDuration();
+    m_trackSplices.push_back(splice);
+    UpdateNextSplicePosition();
+
+    m_trackDecoder = std::move(nextTrack);
+    m_bClockAnchorPending = false;
+    m_bInputEOF = m_trackDecoder->TakePrerollPCM(m_pendingPCM);
+    m_pendingOffset = 0;
+    LOG_INFO("Gapless splice to next audio track: " + splice.m_filePath.toStdString() + ", ring position: " + std::to_string(splice.m_ringPosition));
+    return true;
+}
+
+void AudioFFmpegPlayer::CheckTrackSplices()
+{
+    const size_t readPosition = m_pcmRing.GetReadPosition();
+    while (!m_trackSplices.empty() && readPosition >= m_trackSplices.front().m_ringPosition)
+    {
+        ST_TrackSplice splice = m_trackSplices.front();
+        m_trackSplices.pop_front();
+
+        // seek按正在播放的音轨校验目标，不等待主线程处理切换通知
+        m_playingFilePath = splice.m_filePath;
+        m_playingDuration = splice.m_duration;
+
+        // 音频时钟从衔接点开始计算新音轨的位置
+        const int frameSize = m_clockFrameSize.load();
+        if (frameSize > 0)
+        {
+            m_clockOriginFrames.store(static_cast<int64_t>(splice.m_ringPosition / frameSize), std::memory_order_release);
+        }
+
+        // 解码线程不能持有m_mutex，播放状态交由主线程更新
+        uint64_t session = m_playSession.load();
+        QMetaObject::invokeMethod(this, [this, splice, session]()
+        {
+            if (session == m_playSession.load())
             {
-                break;
+                OnTrackSpliced(splice.m_filePath, splice.m_duration);
             }
-            
-            SDL_Delay(20);
+        }, Qt::QueuedConnection);
+    }
+    UpdateNextSplicePosition();
+}
+
+void AudioFFmpegPlayer::UpdateNextSplicePosition()
+{
+    m_nextSplicePosition.store(m_trackSplices.empty() ? SIZE_MAX : m_trackSplices.front().m_ringPosition, std::memory_order_release);
+}
+
+void AudioFFmpegPlayer::BeginRestoreCurrentTrack(double seconds, bool bAccurate)
+{
+    // 恢复尚未完成时再次seek只更新定位目标
+    if (m_pendingRestore.m_bPending)
+    {
+        m_pendingRestore.m_seconds = seconds;
+        m_pendingRestore.m_bAccurate = bAccurate;
+        return;
+    }
+
+    m_pendingRestore.m_bPending = true;
+    m_pendingRestore.m_filePath = m_playingFilePath;
+    m_pendingRestore.m_seconds = seconds;
+    m_pendingRestore.m_bAccurate = bAccurate;
+    // 只衔接了一首时复用其解码上下文；否则重新打开第一个衔接点的音轨
+    if (m_trackSplices.size() == 1)
+    {
+        m_pendingRestore.m_nextTrack = std::move(m_trackDecoder);
+        m_pendingRestore.m_nextFilePath.clear();
+    }
+    else
+    {
+        m_pendingRestore.m_nextFilePath = m_trackSplices.front().m_filePath;
+    }
+
+    // 没有解码上下文时解码线程不会继续写入已衔接的音轨
+    m_trackDecoder.reset();
+    m_trackSplices.clear();
+    UpdateNextSplicePosition();
+    {
+        std::lock_guard<std::mutex> nextLock(m_nextTrackMutex);
+        ++m_nextTrackGeneration;
+        m_nextTrackDecoder.reset();
+    }
+}
+
+void AudioFFmpegPlayer::RunPendingRestore()
+{
+    QString filePath;
+    QString nextFilePath;
+    std::unique_ptr<AudioTrackDecoder> nextTrack;
+    {
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+        if (!m_pendingRestore.m_bPending)
+        {
+            return;
         }
-        
-        // 确保不是由于seek导致的误判
-        if (m_playInfo && !m_playInfo->IsSeeking() && IsPlaying())
+        filePath = m_pendingRestore.m_filePath;
+        nextFilePath = m_pendingRestore.m_nextFilePath;
+        nextTrack = std::move(m_pendingRestore.m_nextTrack);
+    }
+
+    // 打开文件可能很慢（网络路径），不持有m_decodeMutex，seek和音频回调不受影响
+    auto currentTrack = OpenTrackDecoder(filePath, m_outSampleRate, m_outSampleFormat, m_outChannels);
+    if (nextTrack)
+    {
+        nextTrack->Seek(0.0);
+    }
+    else if (!nextFilePath.isEmpty())
+    {
+        nextTrack = OpenTrackDecoder(nextFilePath, m_outSampleRate, m_outSampleFormat, m_outChannels);
+    }
+
+    std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+    // 停止播放时请求已被清除
+    if (!m_pendingRestore.m_bPending)
+    {
+        return;
+    }
+    m_pendingRestore.m_bPending = false;
+    m_pendingRestore.m_nextFilePath.clear();
+
+    if (!currentTrack)
+    {
+        LOG_WARN("Failed to reopen current audio track: " + filePath.toStdString());
+        m_bDecodeEOF.store(true);
+        m_bRingPrimed.store(true);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> nextLock(m_nextTrackMutex);
+        ++m_nextTrackGeneration;
+        m_nextTrackDecoder = std::move(nextTrack);
+    }
+
+    m_trackDecoder = std::move(currentTrack);
+    ResetDecodeState(m_pendingRestore.m_seconds, m_pendingRestore.m_bAccurate);
+    LOG_INFO("Splice reverted, current audio track reopened: " + filePath.toStdString());
+}
+
+void AudioFFmpegPlayer::OnTrackSpliced(const QString& filePath, double duration)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        SetCurrentFilePath(filePath);
+        SetDuration(duration);
+        RecordPlayStartTime(0.0);
+    }
+
+    LOG_INFO("Audio track changed: " + filePath.toStdString() + ", duration: " + std::to_string(duration) + " seconds");
+    emit SigAudioTrackChanged(filePath);
+}
+
+bool AudioFFmpegPlayer::WritePendingPCM()
+{
+    if (m_pendingOffset < m_pendingPCM.size())
+    {
+        size_t written = m_pcmRing.Write(m_pendingPCM.data() + m_pendingOffset, m_pendingPCM.size() - m_pendingOffset);
+        m_pendingOffset += written;
+        if (written > 0)
         {
-            LOG_INFO("Audio playback naturally finished");
-            emit SigAudioPlayerFinished();
+            RecordSeekLatency();
         }
-        else
+
+        if (m_pendingOffset < m_pendingPCM.size())
         {
-            LOG_INFO("Audio playback ended due to seek or manual stop");
+            return false;
+        }
+    }
+
+    // 保留容量，避免下一帧重新分配
+    m_pendingPCM.clear();
+    m_pendingOffset = 0;
+    return true;
+}
+
+bool AudioFFmpegPlayer::WriteMemoryPCM(size_t maxBytes)
+{
+    size_t availableBytes = 0;
+    const uint8_t* data = m_trackDecoder->PeekMemoryPCM(availableBytes);
+    const size_t frameSize = static_cast<size_t>(m_outChannels * av_get_bytes_per_sample(m_outSampleFormat));
+    // 末尾不足一帧的数据无法播放，视为音轨结束
+    if (frameSize == 0 || availableBytes < frameSize)
+    {
+        m_bInputEOF = true;
+        return true;
+    }
+
+    // 只写入整数个样本帧，并且不超过可写空间（单生产者下可写空间只增不减，写入不会被截断），保证环形缓冲区中的音轨数据始终按帧对齐
+    size_t writeBytes = std::min(std::min(availableBytes, maxBytes), m_pcmRing.GetWritableBytes());
+    writeBytes -= writeBytes % frameSize;
+    if (writeBytes == 0)
+    {
+        return false;
+    }
+
+    size_t written = m_pcmRing.Write(data, writeBytes);
+    if (written == 0)
+    {
+        return false;
+    }
+
+    m_trackDecoder->ConsumeMemoryPCM(written);
+    RecordSeekLatency();
+    return true;
+}
+
+void AudioFFmpegPlayer::RecordSeekLatency()
+{
+    // seek后首批数据可供播放，统计seek延迟
+    if (m_bSeekLatencyPending)
+    {
+        m_bSeekLatencyPending = false;
+        double latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_seekStartTime).count();
+        m_lastSeekLatencyMs.store(latencyMs);
+        LOG_INFO("Audio seek latency (request to first playable sample): " + std::to_string(latencyMs) + " ms");
+    }
+}
+
+void SDLCALL AudioFFmpegPlayer::AudioStreamGetCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount)
+{
+    Q_UNUSED(totalAmount);
+    auto* player = static_cast<AudioFFmpegPlayer*>(userdata);
+    if (player)
+    {
+        player->OnAudioStreamRequest(stream, additionalAmount);
+    }
+}
+
+void AudioFFmpegPlayer::OnAudioStreamRequest(SDL_AudioStream* stream, int additionalAmount)
+{
+    const size_t frameSize = static_cast<size_t>(std::max(m_clockFrameSize.load(std::memory_order_relaxed), 1));
+
+    // SDL拒绝包含不完整样本帧的数据，请求量向上取整、每次读取向下取整到整帧，未写完的帧留在环形缓冲区中
+    size_t remaining = (static_cast<size_t>(std::max(additionalAmount, 0)) + frameSize - 1) / frameSize * frameSize;
+    while (remaining > 0)
+    {
+        size_t readBytes = std::min(std::min(remaining, m_callbackBuffer.size()), m_pcmRing.GetReadableBytes());
+        readBytes -= readBytes % frameSize;
+        if (readBytes == 0)
+        {
+            break;
+        }
+
+        size_t bytesRead = m_pcmRing.Read(m_callbackBuffer.data(), readBytes);
+        if (bytesRead == 0)
+        {
+            break;
+        }
+        if (!SDL_PutAudioStreamData(stream, m_callbackBuffer.data(), static_cast<int>(bytesRead)))
+        {
+            m_streamPutFailCount.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        remaining -= bytesRead;
+    }
+
+    // 首次填充完成后、文件结束前数据不足即为欠载，设备将输出静音
+    if (remaining > 0 && m_bRingPrimed.load(std::memory_order_relaxed) && !m_bDecodeEOF.load(std::memory_order_relaxed))
+    {
+        m_underrunCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    UpdateAudioClock(stream);
+
+    // 数据低于补充阈值或已播放到衔接点时唤醒解码线程，回调中不加锁，丢失的唤醒由等待超时兜底
+    const bool bNeedRefill = !m_bDecodeEOF.load(std::memory_order_relaxed) && m_pcmRing.GetReadableBytes() < m_refillThresholdBytes.load(std::memory_order_relaxed);
+    const bool bSpliceReached = m_pcmRing.GetReadPosition() >= m_nextSplicePosition.load(std::memory_order_acquire);
+    if ((bNeedRefill || bSpliceReached) && !m_bDecodeWakePending.exchange(true))
+    {
+        m_decodeWakeCond.notify_one();
+    }
+
+    CheckEndOfStream(stream);
+}
+
+void AudioFFmpegPlayer::CheckEndOfStream(SDL_AudioStream* stream)
+{
+    // 先读取序号：seek或停止先清除m_bDecodeEOF再递增序号，过期的判断结果会被主线程丢弃
+    const uint64_t generation = m_endOfStreamGeneration.load();
+    if (m_bEndOfStreamSignalled.load(std::memory_order_relaxed) || !m_bDecodeEOF.load() || m_pcmRing.GetReadableBytes() > 0 || SDL_GetAudioStreamQueued(stream) > 0)
+    {
+        return;
+    }
+
+    // 音频流已取空，等待设备缓冲区中的最后一段数据输出完
+    const uint64_t nowNS = SDL_GetTicksNS();
+    uint64_t drainTicksNS = m_drainTicksNS.load(std::memory_order_relaxed);
+    if (drainTicksNS == 0)
+    {
+        drainTicksNS = nowNS;
+        m_drainTicksNS.store(drainTicksNS, std::memory_order_relaxed);
+    }
+
+    const int sampleRate = m_clockSampleRate.load(std::memory_order_relaxed);
+    const uint64_t deviceLatencyNS = (sampleRate > 0) ? static_cast<uint64_t>(m_deviceBufferFrames.load(std::memory_order_relaxed)) * SDL_NS_PER_SECOND / sampleRate : 0;
+    if (nowNS - drainTicksNS < deviceLatencyNS || m_bEndOfStreamSignalled.exchange(true))
+    {
+        return;
+    }
+
+    // 回调中不分配内存、不加锁，只记录结束并唤醒解码线程，由解码线程通知主线程
+    m_pendingEndOfStreamGeneration.store(generation, std::memory_order_relaxed);
+    m_bEndOfStreamPending.store(true, std::memory_order_release);
+    if (!m_bDecodeWakePending.exchange(true))
+    {
+        m_decodeWakeCond.notify_one();
+    }
+}
+
+void AudioFFmpegPlayer::PostEndOfStream()
+{
+    if (!m_bEndOfStreamPending.exchange(false, std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // 解码线程不能持有m_mutex，播放结束交由主线程处理
+    const uint64_t generation = m_pendingEndOfStreamGeneration.load(std::memory_order_relaxed);
+    m_bEndOfStreamPosted.store(true);
+    QMetaObject::invokeMethod(this, [this, generation]()
+    {
+        OnEndOfStream(generation);
+    }, Qt::QueuedConnection);
+}
+
+void AudioFFmpegPlayer::OnEndOfStream(uint64_t generation)
+{
+    if (generation != m_endOfStreamGeneration.load() || !IsPlaying())
+    {
+        return;
+    }
+
+    LOG_INFO("Audio playback naturally finished, underruns: " + std::to_string(GetUnderrunCount()));
+    emit SigAudioPlayerFinished();
+}
+
+void AudioFFmpegPlayer::UpdateAudioClock(SDL_AudioStream* stream)
+{
+    const int frameSize = m_clockFrameSize.load(std::memory_order_relaxed);
+    if (frameSize <= 0)
+    {
+        return;
+    }
+
+    // 推送到音频流的数据总量即环形缓冲区的读取位置，减去仍在排队的部分即设备已取走的数据
+    const int64_t pushedBytes = static_cast<int64_t>(m_pcmRing.GetReadPosition());
+    const int64_t consumedBytes = std::max<int64_t>(pushedBytes - SDL_GetAudioStreamQueued(stream), 0);
+    m_clockConsumedFrames.store(consumedBytes / frameSize, std::memory_order_release);
+    m_clockUpdateTicksNS.store(SDL_GetTicksNS(), std::memory_order_release);
+}
+
+void AudioFFmpegPlayer::ResetAudioClock(double startSeconds)
+{
+    m_clockConsumedFrames.store(0, std::memory_order_release);
+    m_clockOriginFrames.store(-static_cast<int64_t>(std::llround(startSeconds * m_clockSampleRate.load())), std::memory_order_release);
+    m_clockUpdateTicksNS.store(SDL_GetTicksNS(), std::memory_order_release);
+}
+
+double AudioFFmpegPlayer::GetAudioClock() const
+{
+    const int sampleRate = m_clockSampleRate.load(std::memory_order_acquire);
+    if (sampleRate <= 0)
+    {
+        return -1.0;
+    }
+
+    // 设备已取走的数据中，最后一个设备缓冲区仍在输出，尚未被听到
+    const int64_t bufferFrames = m_deviceBufferFrames.load(std::memory_order_relaxed);
+    int64_t playedFrames = m_clockConsumedFrames.load(std::memory_order_acquire) - bufferFrames;
+    if (m_bClockRunning.load(std::memory_order_relaxed))
+    {
+        // 两次回调之间按经过时间插值，最多推进一个设备缓冲区，欠载时时钟随之停止
+        double elapsedSeconds = static_cast<double>(SDL_GetTicksNS() - m_clockUpdateTicksNS.load(std::memory_order_acquire)) / SDL_NS_PER_SECOND;
+        playedFrames += std::min(static_cast<int64_t>(elapsedSeconds * sampleRate), bufferFrames);
+    }
+    playedFrames = std::max<int64_t>(playedFrames, 0);
+
+    double position = static_cast<double>(playedFrames - m_clockOriginFrames.load(std::memory_order_acquire)) / sampleRate;
+    return std::max(position, 0.0);
+}
+
+int AudioFFmpegPlayer::GetLookaheadBytes() const
+{
+    if (!m_playInfo)
+    {
+        return 0;
+    }
+
+    // 按样本帧计算，保证预读窗口和补充阈值都是整数个样本帧
+    SDL_AudioSpec& spec = m_playInfo->GetAudioSpec(false);
+    int64_t lookaheadFrames = static_cast<int64_t>(spec.freq) * m_lookaheadMs.load() / 1000;
+    return static_cast<int>(lookaheadFrames * SDL_AUDIO_FRAMESIZE(spec));
+}
+
+void AudioFFmpegPlayer::SetLookaheadMs(int lookaheadMs)
+{
+    m_lookaheadMs.store(std::max(MIN_LOOKAHEAD_MS, std::min(MAX_LOOKAHEAD_MS, lookaheadMs)));
+    LOG_INFO("Audio lookahead set to " + std::to_string(m_lookaheadMs.load()) + " ms");
+}
+
+int AudioFFmpegPlayer::GetLookaheadMs() const
+{
+    return m_lookaheadMs.load();
+}
+
+uint64_t AudioFFmpegPlayer::GetUnderrunCount() const
+{
+    return m_underrunCount.load();
+}
+
+void AudioFFmpegPlayer::SetPCMCacheBudget(size_t budgetBytes)
+{
+    m_pcmCache.SetBudgetBytes(budgetBytes);
+}
+
+uint64_t AudioFFmpegPlayer::GetPCMCacheHitCount() const
+{
+    return m_pcmCache.GetHitCount();
+}
+
+uint64_t AudioFFmpegPlayer::GetPCMCacheMissCount() const
+{
+    return m_pcmCache.GetMissCount();
+}
+
+double AudioFFmpegPlayer::GetLastSeekLatencyMs() const
+{
+    return m_lastSeekLatencyMs.load();
+}
+
+void AudioFFmpegPlayer::StartAudioDecodeThread()
+{
+    if (m_bDecodeThreadRunning.load())
+    {
+        return;
+    }
+
+    m_bDecodeThreadRunning.store(true);
+    m_audioDecodeThreadID = CoreServerGlobal::Instance().GetThreadPool().CreateDedicatedThread("AudioDecodeThread", [this]()
+    {
+        while (m_bDecodeThreadRunning.load())
+        {
+            // 正在seek时不解码，seek流程重置解码状态后会唤醒解码线程
+            if (m_playInfo && !m_playInfo->IsSeeking())
+            {
+                // seek撤销了衔接时先重新打开当前音轨
+                RunPendingRestore();
+
+                std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+                FillAudioLookahead();
+                CheckTrackSplices();
+            }
+
+            // 播放结束由音频回调在数据取空后标记，解码线程代为通知主线程
+            PostEndOfStream();
+            WaitForDecodeWake();
         }
     });
+    m_bHasDecodeThread = true;
+}
 
+void AudioFFmpegPlayer::WaitForDecodeWake()
+{
+    std::unique_lock<std::mutex> wakeLock(m_decodeWakeMutex);
+    auto isWoken = [this]()
+    {
+        return m_bDecodeWakePending.load() || !m_bDecodeThreadRunning.load();
+    };
 
-    LOG_INFO("=== Audio data processing completed, processed " + std::to_string(processedPackets) + " packets, " + std::to_string(processedFrames) + " frames ===");
+    // 解码结束且结束通知已发出后，只有seek或停止才需要解码线程；通知发出前按超时等待，避免丢失回调的无锁唤醒
+    if (m_bDecodeEOF.load() && m_nextSplicePosition.load() == SIZE_MAX && m_bEndOfStreamPosted.load())
+    {
+        m_decodeWakeCond.wait(wakeLock, isWoken);
+    }
+    else
+    {
+        m_decodeWakeCond.wait_for(wakeLock, std::chrono::milliseconds(DECODE_WAKE_TIMEOUT_MS), isWoken);
+    }
+    m_bDecodeWakePending.store(false);
+}
 
-    TimeSystem::Instance().StopTimingWithLog("AudioDataProcessing", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Audio data processing completed");
+void AudioFFmpegPlayer::WakeDecodeThread()
+{
+    {
+        std::lock_guard<std::mutex> wakeLock(m_decodeWakeMutex);
+        m_bDecodeWakePending.store(true);
+    }
+    m_decodeWakeCond.notify_one();
+}
+
+void AudioFFmpegPlayer::StopAudioDecodeThread()
+{
+    m_bDecodeThreadRunning.store(false);
+    WakeDecodeThread();
+    if (m_bHasDecodeThread)
+    {
+        CoreServerGlobal::Instance().GetThreadPool().StopDedicatedThread(m_audioDecodeThreadID);
+        m_bHasDecodeThread = false;
+    }
 }
 
 void AudioFFmpegPlayer::PlayerStateReSet()
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
+    // 先停止解码线程，避免其访问即将释放的资源
+    StopAudioDecodeThread();
+    m_bClockRunning.store(false);
+    m_clockSampleRate.store(0);
+
     // 确保之前的资源被完全释放
     if (m_playInfo)
     {
@@ -579,20 +1266,35 @@ void AudioFFmpegPlayer::PlayerStateReSet()
         SDL_Delay(10); // 等待资源释放
     }
 
-    // 清理缓存的重采样资源
-    m_resampler.reset();
-    m_resampleParams.reset();
-    m_audioStreamIdx = -1;
-    m_bResampleParamsUpdated = false;
+    // 丢弃预备的下一首音轨和尚未送达的切换通知，等待正在打开文件的预备任务结束
+    ++m_playSession;
+    PrepareNextTrack(QString());
+    WaitForPrepareTasks(false);
 
-    // 清空音频缓冲区
+    // 释放解码上下文，此时音频流已销毁，回调不会再访问环形缓冲区
     {
-        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-        m_audioBuffer.clear();
-        m_audioBuffer.shrink_to_fit();
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+        m_trackDecoder.reset();
+        m_trackSplices.clear();
+        UpdateNextSplicePosition();
+        m_pendingRestore = ST_PendingRestore();
+        m_playingFilePath.clear();
+        m_playingDuration = 0.0;
+        m_bDecodeEOF.store(false);
+        ++m_endOfStreamGeneration;
+        m_pendingPCM.clear();
+        m_pendingOffset = 0;
+        m_pcmRing.Clear();
     }
 
-    CoreServerGlobal::Instance().GetThreadPool().StopDedicatedThread(m_audioPlayerFinishedThreadID);
+    if (m_underrunCount.load() > 0)
+    {
+        LOG_WARN("Audio playback underruns: " + std::to_string(m_underrunCount.load()));
+    }
+    if (m_streamPutFailCount.load() > 0)
+    {
+        LOG_WARN("Audio stream put failures: " + std::to_string(m_streamPutFailCount.load()));
+    }
 }
 
 void AudioFFmpegPlayer::PausePlay()
@@ -613,6 +1315,7 @@ void AudioFFmpegPlayer::PausePlay()
     m_isPaused = true;
     m_playState.TransitionTo(AVPlayState::Paused);
     m_playInfo->PauseAudio();
+    m_bClockRunning.store(false);
 }
 
 void AudioFFmpegPlayer::ResumePlay()
@@ -629,6 +1332,8 @@ void AudioFFmpegPlayer::ResumePlay()
     RecordPlayStartTime(resumePosition);
 
     m_playState.TransitionTo(AVPlayState::Playing);
+    m_clockUpdateTicksNS.store(SDL_GetTicksNS());
+    m_bClockRunning.store(true);
     m_playInfo->ResumeAudio();
 
     LOG_INFO("Audio ResumePlay - RecordPlayStartTime called with position: " + std::to_string(resumePosition) + " seconds");
@@ -641,62 +1346,81 @@ void AudioFFmpegPlayer::StopPlay()
     m_playState.TransitionTo(AVPlayState::Stopped);
 }
 
-bool AudioFFmpegPlayer::SeekAudio(double seconds)
+bool AudioFFmpegPlayer::SeekAudio(double seconds, bool bAccurate)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_playInfo->SetSeeking(true);
-    if (GetCurrentFilePath().isEmpty() || !m_playInfo)
+    if (!m_playInfo)
     {
         return false;
     }
 
-    // 验证seek位置
-    if (seconds < 0.0 || seconds > GetDuration())
+    // 按正在播放的音轨验证seek位置，衔接点出队时已更新，不依赖主线程的切换通知
+    bool bValidTarget = false;
+    {
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
+        bValidTarget = !m_playingFilePath.isEmpty() && seconds >= 0.0 && seconds <= m_playingDuration;
+    }
+    if (!bValidTarget)
     {
         LOG_WARN("Invalid seek position: " + std::to_string(seconds));
         return false;
     }
 
-    LOG_INFO("Seeking audio to position: " + std::to_string(seconds) + " seconds");
-
-    // 暂停播放
+    LOG_INFO("Seeking audio to position: " + std::to_string(seconds) + " seconds" + (bAccurate ? "" : " (preview)"));
+    TIME_START("AudioSeek");
+    auto seekStartTime = std::chrono::steady_clock::now();
+    m_playInfo->SetSeeking(true);
 
-    // 重新打开文件以获取新的文件上下文
-    auto openFileResult = OpenMediaFile(GetCurrentFilePath());
-    if (!openFileResult)
+    bool bSeekSuccess = false;
     {
-        LOG_WARN("Failed to reopen file for seek operation");
-        return false;
-    }
+        std::lock_guard<std::mutex> decodeLock(m_decodeMutex);
 
-    // 清空音频缓冲区和设备缓冲区
-    m_playInfo->FlushAudioStream();
-    m_playInfo->ClearAudioDeviceBuffer();
-    {
-        std::lock_guard<std::recursive_mutex> buffer_lock(m_bufferMutex);
-        m_audioBuffer.clear();
-        m_audioBuffer.shrink_to_fit();
-    }
+        // 锁定音频流使回调暂停，清空环形缓冲区和设备缓冲区中的旧数据
+        m_playInfo->LockAudioStream();
+        m_pcmRing.Clear();
+        m_playInfo->ClearAudioDeviceBuffer();
+        m_playInfo->UnlockAudioStream();
 
-    // 更新音频流索引
-    m_audioStreamIdx = openFileResult->m_audioStreamIdx;
+        if (!m_trackSplices.empty() || m_pendingRestore.m_bPending)
+        {
+            // 已衔接但尚未播放到的下一首音轨需要撤销，重新打开当前音轨交由解码线程完成，调用线程不等待打开文件
+            BeginRestoreCurrentTrack(seconds, bAccurate);
+            ResetDecodeState(seconds, bAccurate);
+            bSeekSuccess = true;
+        }
+        else
+        {
+            // 复用已打开的解码上下文：av_seek_frame + avcodec_flush_buffers，由解码线程填充预读窗口
+            bSeekSuccess = ResetDecodeState(seconds, bAccurate);
+        }
+        m_seekStartTime = seekStartTime;
+        m_bSeekLatencyPending = bSeekSuccess;
+    }
 
-    // 重置重采样参数更新标记
-    m_bResampleParamsUpdated = false;
     m_playInfo->SetSeeking(false);
     // 注意：seek时不更新播放起始时间，由ResumePlay统一处理
-    // 重新处理音频数据，从seek位置开始
-    ProcessAudioData(*openFileResult, *m_resampler, *m_resampleParams, seconds);
-    LOG_INFO("Audio seek completed successfully to position: " + std::to_string(seconds) + " seconds");
-    return true;
+    StartAudioDecodeThread();
+    WakeDecodeThread();
+    TimeSystem::Instance().StopTimingWithLog("AudioSeek", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Audio seek to " + std::to_string(seconds) + " seconds " + (bSeekSuccess ? "completed" : "failed"));
+    return bSeekSuccess;
 }
 
 void AudioFFmpegPlayer::SeekPlay(double seconds)
+{
+    SeekPlayInternal(seconds, true);
+}
+
+void AudioFFmpegPlayer::PreviewSeek(double seconds)
+{
+    SeekPlayInternal(seconds, false);
+}
+
+void AudioFFmpegPlayer::SeekPlayInternal(double seconds, bool bAccurate)
 {
     LOG_INFO("AudioFFmpegPlayer::SeekPlay called - target position: " + std::to_string(seconds) + " seconds");
     if (IsPlaying() || IsPaused())
     {
-        SeekAudio(seconds);
+        SeekAudio(seconds, bAccurate);
         m_pauseTime = seconds; // 强制同步m_pauseTime为seek目标时间
         LOG_INFO("Audio seek to: " + std::to_string(seconds) + " seconds, m_pauseTime synchronized to: " + std::to_string(seconds));
     }
@@ -710,7 +1434,12 @@ void AudioFFmpegPlayer::SetInputDevice(const QString& deviceName)
 
 double AudioFFmpegPlayer::GetCurrentPosition()
 {
-    // 使用基类的计算方法
+    // 优先使用按样本计数的音频时钟，未在播放时使用基类的计算方法
+    double audioClock = GetAudioClock();
+    if (audioClock >= 0.0)
+    {
+        return audioClock;
+    }
     return CalculateCurrentPosition();
 }
 
@@ -1,13 +1,20 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <QDebug>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include "AudioPCMCache.h"
 #include "AudioResampler.h"
+#include "AudioTrackDecoder.h"
 #include "../BasePlayer/BaseFFmpegPlayer.h"
+#include "BaseDataDefine/ST_PCMRingBuffer.h"
 #include "DataDefine/ST_AudioPlayInfo.h"
 #include "DataDefine/ST_OpenAudioDevice.h"
 #include "DataDefine/ST_OpenFileResult.h"
@@ -82,12 +89,24 @@ public:
     /// <param name="seconds">快进秒数</param>
     void SeekPlay(double seconds) override;
 
+    /// <summary>
+    /// 快速预览定位：从目标前的数据包直接开始播放，不做样本精确裁剪（拖动进度条时使用）
+    /// </summary>
+    /// <param name="seconds">定位时间（秒）</param>
+    void PreviewSeek(double seconds);
+
     /// <summary>
     /// 获取当前播放位置
     /// </summary>
     /// <returns>当前播放位置（秒）</returns>
     double GetCurrentPosition();
 
+    /// <summary>
+    /// 获取音频时钟：按设备已消费的样本数扣除设备缓冲延迟计算，无锁，可在任意线程调用
+    /// </summary>
+    /// <returns>当前音轨的实际播放位置（秒），未在播放时返回-1</returns>
+    double GetAudioClock() const;
+
     /// <summary>
     /// 重置播放器状态（重写基类方法）
     /// </summary>
@@ -98,6 +117,49 @@ public:
     /// </summary>
     void ForceStop() override;
 
+    /// <summary>
+    /// 设置流式解码的预读窗口（毫秒），超出[500, 5000]范围时自动截断
+    /// </summary>
+    /// <param name="lookaheadMs">预读时长（毫秒）</param>
+    void SetLookaheadMs(int lookaheadMs);
+
+    /// <summary>
+    /// 获取流式解码的预读窗口（毫秒）
+    /// </summary>
+    int GetLookaheadMs() const;
+
+    /// <summary>
+    /// 获取播放过程中音频回调欠载（PCM环形缓冲区数据不足）的次数
+    /// </summary>
+    uint64_t GetUnderrunCount() const;
+
+    /// <summary>
+    /// 获取最近一次seek的延迟（从发起seek到首批数据可供播放，毫秒）
+    /// </summary>
+    double GetLastSeekLatencyMs() const;
+
+    /// <summary>
+    /// 设置已解码PCM缓存的字节预算，0表示禁用缓存
+    /// </summary>
+    /// <param name="budgetBytes">字节预算</param>
+    void SetPCMCacheBudget(size_t budgetBytes);
+
+    /// <summary>
+    /// 获取PCM缓存命中次数
+    /// </summary>
+    uint64_t GetPCMCacheHitCount() const;
+
+    /// <summary>
+    /// 获取PCM缓存未命中次数
+    /// </summary>
+    uint64_t GetPCMCacheMissCount() const;
+
+    /// <summary>
+    /// 预先打开并预解码下一首音轨，当前音轨解码结束时无缝衔接；传入空路径取消预备
+    /// </summary>
+    /// <param name="filePath">下一首音轨文件路径</param>
+    void PrepareNextTrack(const QString& filePath);
+
 signals:
     /// <summary>
     /// 播放进度改变信号
@@ -109,7 +171,57 @@ signals:
     /// 播放完毕
     /// </summary>
     void SigAudioPlayerFinished();
+    /// <summary>
+    /// 无缝切换到下一首音轨（该音轨的首个样本开始播放时发出）
+    /// </summary>
+    /// <param name="filePath">新音轨文件路径</param>
+    void SigAudioTrackChanged(const QString& filePath);
 private:
+    /// <summary>
+    /// 音轨衔接点
+    /// </summary>
+    struct ST_TrackSplice
+    {
+        size_t m_ringPosition{0}; /// 新音轨在环形缓冲区中的起始写入位置
+        QString m_filePath;       /// 新音轨文件路径
+        double m_duration{0.0};   /// 新音轨时长（秒）
+    };
+
+    /// <summary>
+    /// 协商后的输出格式
+    /// </summary>
+    struct ST_OutputFormat
+    {
+        int m_sampleRate{DEFAULT_OUTPUT_SAMPLE_RATE};                   /// 输出采样率
+        AVSampleFormat m_sampleFormat{DEFAULT_OUTPUT_SAMPLE_FORMAT};    /// 输出采样格式（交错）
+        int m_channels{DEFAULT_OUTPUT_CHANNELS};                        /// 输出声道数
+    };
+
+    /// <summary>
+    /// 下一首音轨预备任务的共享状态，线程池任务持有其引用，播放器销毁后任务据此不再访问播放器
+    /// </summary>
+    struct ST_PrepareTaskState
+    {
+        std::mutex m_mutex;             /// 状态互斥锁
+        std::condition_variable m_cond; /// 任务结束通知
+        bool m_bOwnerAlive{true};       /// 播放器是否仍存在
+        int m_runningCount{0};          /// 正在执行的预备任务数
+    };
+
+    /// <summary>
+    /// 等待解码线程完成的撤销衔接请求：seek到达时下一首音轨已衔接，需重新打开当前音轨后再定位
+    /// </summary>
+    struct ST_PendingRestore
+    {
+        bool m_bPending{false};                             /// 是否有待处理的请求
+        QString m_filePath;                                 /// 需要重新打开的当前音轨
+        QString m_nextFilePath;                             /// 需要重新打开的下一首音轨，为空时使用m_nextTrack
+        std::unique_ptr<AudioTrackDecoder> m_nextTrack;     /// 只衔接了一首时复用其解码上下文，从头重新解码
+        double m_seconds{0.0};                              /// 定位目标（秒），恢复期间再次seek时更新
+        bool m_bAccurate{true};                             /// 是否精确定位
+    };
+
+
     /// <summary>
     /// 打开设备
     /// </summary>
@@ -129,17 +241,234 @@ private:
     /// 音频定位
     /// </summary>
     /// <param name="seconds">定位时间（秒）</param>
+    /// <param name="bAccurate">是否样本精确定位</param>
     /// <returns>是否定位成功</returns>
-    bool SeekAudio(double seconds);
+    bool SeekAudio(double seconds, bool bAccurate = true);
 
     /// <summary>
-    /// 处理音频数据流
+    /// 播放或暂停状态下执行定位并同步暂停位置
+    /// </summary>
+    /// <param name="seconds">定位时间（秒）</param>
+    /// <param name="bAccurate">是否样本精确定位</param>
+    void SeekPlayInternal(double seconds, bool bAccurate);
+
+    /// <summary>
+    /// 处理音频数据流：定位到起始位置并启动音频解码线程
     /// </summary>
-    /// <param name="openFileResult">打开文件结果</param>
-    /// <param name="resampler">重采样器</param>
-    /// <param name="resampleParams">重采样参数</param>
     /// <param name="startSeconds">起始播放位置（秒），默认从当前位置开始</param>
-    void ProcessAudioData(const ST_OpenFileResult& openFileResult, AudioResampler& resampler, ST_ResampleParams& resampleParams, double startSeconds = 0.0);
+    void ProcessAudioData(double startSeconds = 0.0);
+
+    /// <summary>
+    /// 重置流式解码状态并在已打开的解码上下文上定位到指定位置（调用方需持有m_decodeMutex）
+    /// </summary>
+    /// <param name="startSeconds">起始播放位置（秒）</param>
+    /// <param name="bAccurate">是否样本精确定位</param>
+    /// <returns>是否定位成功</returns>
+    bool ResetDecodeState(double startSeconds, bool bAccurate = true);
+
+    /// <summary>
+    /// 解码持续进行，直到PCM环形缓冲区中的数据达到预读窗口、缓冲区已满或文件结束（调用方需持有m_decodeMutex）
+    /// </summary>
+    void FillAudioLookahead();
+
+    /// <summary>
+    /// 预览定位后首批数据解码出来时，将音频时钟原点定位到实际的首个样本（调用方需持有m_decodeMutex）
+    /// </summary>
+    void AnchorClockAtFirstOutput();
+
+    /// <summary>
+    /// 打开要播放的音轨并协商输出格式，依次尝试PCM缓存、PCM WAV映射和解码，不修改播放器状态（调用方无需持有m_mutex）
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outputFormat">成功时输出协商后的输出格式</param>
+    /// <returns>音轨解码器，失败返回nullptr</returns>
+    std::unique_ptr<AudioTrackDecoder> OpenPlaybackTrack(const QString& filePath, ST_OutputFormat& outputFormat);
+
+    /// <summary>
+    /// 根据源音频格式和设备首选格式协商输出格式，始终保留源采样率，设备支持时保留源声道数和采样格式
+    /// </summary>
+    /// <param name="openFileResult">已打开的文件</param>
+    /// <returns>输出格式</returns>
+    ST_OutputFormat NegotiateOutputFormat(const ST_OpenFileResult& openFileResult) const;
+
+    /// <summary>
+    /// 根据源音频参数和设备首选格式协商输出格式，采样率与设备不一致时由SDL音频流转换
+    /// </summary>
+    /// <param name="sourceSampleRate">源采样率</param>
+    /// <param name="sourceChannels">源声道数</param>
+    /// <param name="sourceFormat">源采样格式</param>
+    /// <returns>输出格式</returns>
+    ST_OutputFormat NegotiateOutputFormat(int sourceSampleRate, int sourceChannels, AVSampleFormat sourceFormat) const;
+
+    /// <summary>
+    /// 从PCM缓存创建音轨：按缓存记录的源格式协商输出
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outputFormat">命中时输出协商后的输出格式</param>
+    /// <returns>缓存音轨，未命中返回nullptr</returns>
+    std::unique_ptr<AudioTrackDecoder> OpenCachedTrack(const QString& filePath, ST_OutputFormat& outputFormat);
+
+    /// <summary>
+    /// PCM WAV快速路径：映射文件并按源格式协商输出，格式一致时创建映射音轨
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outputFormat">成功时输出协商后的输出格式</param>
+    /// <returns>映射音轨，不适用时返回nullptr</returns>
+    std::unique_ptr<AudioTrackDecoder> OpenMappedWavTrack(const QString& filePath, ST_OutputFormat& outputFormat);
+
+    /// <summary>
+    /// 打开音频文件并创建指定输出格式的音轨解码器，优先使用PCM缓存，不修改当前播放状态（可在线程池中调用）
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outSampleRate">输出采样率</param>
+    /// <param name="outFormat">输出采样格式</param>
+    /// <param name="outChannels">输出声道数</param>
+    /// <returns>音轨解码器，失败返回nullptr</returns>
+    std::unique_ptr<AudioTrackDecoder> OpenTrackDecoder(const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels);
+
+    /// <summary>
+    /// 当前音轨从开头完整解码到结尾时，将解码结果放入PCM缓存（调用方需持有m_decodeMutex）
+    /// </summary>
+    void CacheTrackPCM();
+
+    /// <summary>
+    /// 在线程池中打开并预解码下一首音轨，请求仍有效时放入预备位置
+    /// </summary>
+    /// <param name="filePath">下一首音轨文件路径</param>
+    /// <param name="generation">预备请求序号</param>
+    /// <param name="outSampleRate">输出采样率</param>
+    /// <param name="outFormat">输出采样格式</param>
+    /// <param name="outChannels">输出声道数</param>
+    void RunPrepareNextTrack(const QString& filePath, uint64_t generation, int outSampleRate, AVSampleFormat outFormat, int outChannels);
+
+    /// <summary>
+    /// 等待正在执行的预备任务结束（尚未开始的任务会因请求过期直接退出）
+    /// </summary>
+    /// <param name="bOwnerDestroyed">播放器即将销毁，之后开始的任务不再访问播放器</param>
+    void WaitForPrepareTasks(bool bOwnerDestroyed);
+
+    /// <summary>
+    /// 当前音轨输入结束时切换到已预备的下一首音轨（调用方需持有m_decodeMutex）
+    /// </summary>
+    /// <returns>是否切换成功</returns>
+    bool SpliceNextTrack();
+
+    /// <summary>
+    /// 检查音频回调是否已播放到衔接点，到达后立即更新正在播放的音轨并通知主线程（调用方需持有m_decodeMutex）
+    /// </summary>
+    void CheckTrackSplices();
+
+    /// <summary>
+    /// 更新下一个衔接点的写入位置，供音频回调判断何时唤醒解码线程（调用方需持有m_decodeMutex）
+    /// </summary>
+    void UpdateNextSplicePosition();
+
+    /// <summary>
+    /// 衔接点尚未播放到时撤销切换：丢弃已衔接的数据和解码上下文，记录撤销请求交由解码线程完成（调用方需持有m_decodeMutex）
+    /// </summary>
+    /// <param name="seconds">定位目标（秒）</param>
+    /// <param name="bAccurate">是否精确定位</param>
+    void BeginRestoreCurrentTrack(double seconds, bool bAccurate);
+
+    /// <summary>
+    /// 在解码线程中完成撤销请求：重新打开当前音轨并定位，已切换的音轨放回预备位置（调用方不能持有m_decodeMutex，打开文件时不加锁）
+    /// </summary>
+    void RunPendingRestore();
+
+    /// <summary>
+    /// 主线程中更新为已衔接的音轨
+    /// </summary>
+    /// <param name="filePath">新音轨文件路径</param>
+    /// <param name="duration">新音轨时长（秒）</param>
+    void OnTrackSpliced(const QString& filePath, double duration);
+
+    /// <summary>
+    /// 将待写入缓冲区中的PCM数据写入环形缓冲区（调用方需持有m_decodeMutex）
+    /// </summary>
+    /// <returns>待写入数据全部写入返回true，环形缓冲区已满返回false</returns>
+    bool WritePendingPCM();
+
+    /// <summary>
+    /// 将内存音轨的PCM数据直接写入环形缓冲区，读到结尾时标记输入结束（调用方需持有m_decodeMutex）
+    /// </summary>
+    /// <param name="maxBytes">本次最多写入的字节数</param>
+    /// <returns>环形缓冲区已满返回false</returns>
+    bool WriteMemoryPCM(size_t maxBytes);
+
+    /// <summary>
+    /// seek后首批数据写入环形缓冲区时记录seek延迟（调用方需持有m_decodeMutex）
+    /// </summary>
+    void RecordSeekLatency();
+
+    /// <summary>
+    /// SDL音频流拉取回调，在SDL音频线程中执行
+    /// </summary>
+    /// <param name="userdata">播放器实例</param>
+    /// <param name="stream">SDL音频流</param>
+    /// <param name="additionalAmount">本次需要补充的字节数</param>
+    /// <param name="totalAmount">本次请求的总字节数</param>
+    static void SDLCALL AudioStreamGetCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount);
+
+    /// <summary>
+    /// 从PCM环形缓冲区读取数据提交给SDL音频流并更新音频时钟，不加锁、不分配内存
+    /// </summary>
+    /// <param name="stream">SDL音频流</param>
+    /// <param name="additionalAmount">需要补充的字节数</param>
+    void OnAudioStreamRequest(SDL_AudioStream* stream, int additionalAmount);
+
+    /// <summary>
+    /// 重置音频时钟，起始位置对应环形缓冲区的起点（调用时环形缓冲区和音频流需已清空）
+    /// </summary>
+    /// <param name="startSeconds">起始位置（秒）</param>
+    void ResetAudioClock(double startSeconds);
+
+    /// <summary>
+    /// 在音频回调中根据已推送和仍在排队的数据更新设备已消费的样本数
+    /// </summary>
+    /// <param name="stream">SDL音频流</param>
+    void UpdateAudioClock(SDL_AudioStream* stream);
+
+    /// <summary>
+    /// 在音频回调中检测播放结束：解码结束、环形缓冲区和音频流取空且设备缓冲区播放完后标记一次并唤醒解码线程
+    /// </summary>
+    /// <param name="stream">SDL音频流</param>
+    void CheckEndOfStream(SDL_AudioStream* stream);
+
+    /// <summary>
+    /// 解码线程中将音频回调标记的播放结束投递到主线程
+    /// </summary>
+    void PostEndOfStream();
+
+    /// <summary>
+    /// 主线程中处理播放结束通知
+    /// </summary>
+    /// <param name="generation">发出通知时的播放结束检测序号</param>
+    void OnEndOfStream(uint64_t generation);
+
+    /// <summary>
+    /// 预读窗口对应的字节数
+    /// </summary>
+    int GetLookaheadBytes() const;
+
+    /// <summary>
+    /// 启动音频解码线程，按预读窗口向环形缓冲区补充数据，数据充足时等待唤醒
+    /// </summary>
+    void StartAudioDecodeThread();
+
+    /// <summary>
+    /// 解码线程等待唤醒：解码结束、无待播放的衔接点且结束通知已发出时一直等待，否则最多等待DECODE_WAKE_TIMEOUT_MS
+    /// </summary>
+    void WaitForDecodeWake();
+
+    /// <summary>
+    /// 唤醒解码线程（不可在音频回调中调用）
+    /// </summary>
+    void WakeDecodeThread();
+
+    /// <summary>
+    /// 停止音频解码线程
+    /// </summary>
+    void StopAudioDecodeThread();
 
     /// <summary>
     /// 重置播放器状态
@@ -147,19 +476,84 @@ private:
     void PlayerStateReSet();
 
 private:
+    static const int MIN_LOOKAHEAD_MS{500};                     /// 预读窗口下限（毫秒）
+    static const int MAX_LOOKAHEAD_MS{5000};                    /// 预读窗口上限（毫秒）
+    static const size_t CALLBACK_BUFFER_SIZE{16384};            /// 音频回调单次拷贝的字节数上限，按样本帧向下取整
+    static const int DEFAULT_OUTPUT_SAMPLE_RATE{44100};          /// 无法获取源格式时的默认输出采样率
+    static const int DEFAULT_OUTPUT_CHANNELS{2};                 /// 无法获取源格式时的默认输出声道数
+    static const AVSampleFormat DEFAULT_OUTPUT_SAMPLE_FORMAT{AV_SAMPLE_FMT_S16}; /// 无法获取源格式时的默认输出采样格式
+    static const int NEXT_TRACK_PREROLL_MS{500};                 /// 下一首音轨预解码时长（毫秒）
+    static const int DECODE_WAKE_TIMEOUT_MS{100};                /// 解码线程等待唤醒的超时（毫秒），弥补回调无锁通知可能丢失的唤醒
+
     QString m_currentInputDevice;                                /// 当前选择的FFmpeg输入设备
     std::unique_ptr<ST_OpenAudioDevice> m_recordDevice{nullptr}; /// 录制设备
     std::unique_ptr<ST_AudioPlayInfo> m_playInfo{nullptr};       /// 播放信息
     QStringList m_inputAudioDevices;                             /// 音频输入设备列表
-    
-    std::vector<uint8_t> m_audioBuffer;                          /// 音频数据缓冲区
-    std::recursive_mutex m_bufferMutex;                        /// 缓冲区互斥锁
-    
-    // 缓存的重采样相关资源
-    std::unique_ptr<AudioResampler> m_resampler{nullptr};       /// 重采样器实例
-    std::unique_ptr<ST_ResampleParams> m_resampleParams{nullptr}; /// 重采样参数
-    int m_audioStreamIdx{-1};                                   /// 音频流索引
-    bool m_bResampleParamsUpdated{false};                       /// 重采样参数是否已更新
-
-    size_t m_audioPlayerFinishedThreadID;
+
+    ST_PCMRingBuffer m_pcmRing;                                  /// 解码线程与音频回调之间的PCM环形缓冲区
+    std::vector<uint8_t> m_pendingPCM;                           /// 尚未写入环形缓冲区的PCM数据（仅解码线程访问）
+    size_t m_pendingOffset{0};                                   /// 待写入数据的起始偏移
+    std::vector<uint8_t> m_callbackBuffer;                       /// 音频回调使用的预分配拷贝缓冲区
+    std::atomic<uint64_t> m_underrunCount{0};                    /// 音频回调欠载次数
+    std::atomic<uint64_t> m_streamPutFailCount{0};               /// 向音频流推送数据失败的次数
+    std::atomic<bool> m_bRingPrimed{false};                      /// 环形缓冲区是否已完成首次填充
+
+    // 协商后的输出格式，同一播放会话内衔接的音轨统一转换为该格式
+    int m_outSampleRate{DEFAULT_OUTPUT_SAMPLE_RATE};            /// 输出采样率
+    AVSampleFormat m_outSampleFormat{DEFAULT_OUTPUT_SAMPLE_FORMAT}; /// 输出采样格式（交错）
+    int m_outChannels{DEFAULT_OUTPUT_CHANNELS};                 /// 输出声道数
+
+    // 流式解码状态
+    std::unique_ptr<AudioTrackDecoder> m_trackDecoder{nullptr}; /// 当前解码音轨
+    std::mutex m_decodeMutex;                                   /// 解码状态互斥锁
+    std::atomic<int> m_lookaheadMs{1000};                       /// 预读窗口（毫秒）
+    std::atomic<bool> m_bDecodeEOF{false};                      /// 文件是否已解码完毕
+    std::atomic<bool> m_bDecodeThreadRunning{false};            /// 解码线程是否运行
+    bool m_bInputEOF{false};                                    /// 输入文件是否已读取完毕
+    bool m_bClockAnchorPending{false};                          /// 预览定位后是否等待按首个解码样本定位时钟
+
+    // 解码线程唤醒（音频回调中只做无锁通知）
+    std::mutex m_decodeWakeMutex;                               /// 解码线程唤醒互斥锁
+    std::condition_variable m_decodeWakeCond;                   /// 解码线程唤醒条件变量
+    std::atomic<bool> m_bDecodeWakePending{false};              /// 是否有待处理的唤醒
+    std::atomic<size_t> m_refillThresholdBytes{0};              /// 环形缓冲区低于该字节数时唤醒解码线程补充数据
+    std::atomic<size_t> m_nextSplicePosition{SIZE_MAX};         /// 下一个衔接点的写入位置，SIZE_MAX表示没有
+
+    // 播放结束检测（由音频回调在数据取空后发出）
+    std::atomic<uint64_t> m_endOfStreamGeneration{0};           /// 播放结束检测序号，seek或停止时递增，用于丢弃过期的结束通知
+    std::atomic<uint64_t> m_drainTicksNS{0};                    /// 音频流取空的时间（纳秒），0表示尚未取空
+    std::atomic<bool> m_bEndOfStreamSignalled{false};           /// 音频回调是否已检测到播放结束
+    std::atomic<bool> m_bEndOfStreamPending{false};             /// 播放结束是否等待解码线程投递
+    std::atomic<uint64_t> m_pendingEndOfStreamGeneration{0};    /// 等待投递的播放结束检测序号
+    std::atomic<bool> m_bEndOfStreamPosted{false};              /// 解码线程是否已向主线程投递播放结束通知
+
+    // 无缝播放
+    std::unique_ptr<AudioTrackDecoder> m_nextTrackDecoder{nullptr}; /// 已预备的下一首音轨
+    std::mutex m_nextTrackMutex;                                /// 下一首音轨互斥锁
+    std::atomic<uint64_t> m_nextTrackGeneration{0};             /// 下一首音轨预备请求序号，用于丢弃过期的预备结果
+    std::shared_ptr<ST_PrepareTaskState> m_prepareTaskState{std::make_shared<ST_PrepareTaskState>()}; /// 预备任务共享状态
+    std::deque<ST_TrackSplice> m_trackSplices;                  /// 已写入环形缓冲区但尚未播放到的衔接点（仅在m_decodeMutex下访问）
+    QString m_playingFilePath;                                  /// 正在播放的音轨，到达衔接点时立即更新（仅在m_decodeMutex下访问）
+    double m_playingDuration{0.0};                              /// 正在播放的音轨时长（秒）（仅在m_decodeMutex下访问）
+    ST_PendingRestore m_pendingRestore;                         /// 等待解码线程完成的撤销衔接请求（仅在m_decodeMutex下访问）
+    std::atomic<uint64_t> m_playSession{0};                     /// 播放会话序号，用于丢弃过期的音轨切换通知
+
+    AudioPCMCache m_pcmCache;                                   /// 最近播放音轨的已解码PCM缓存
+
+    // 音频时钟（以设备已消费的样本计数，不依赖系统时间）
+    std::atomic<int> m_clockSampleRate{0};                      /// 时钟采样率，0表示时钟无效
+    std::atomic<int> m_clockFrameSize{0};                       /// 每个样本帧的字节数
+    std::atomic<int64_t> m_deviceBufferFrames{0};               /// 设备缓冲区大小（按音频流采样率换算的样本帧），作为输出延迟
+    std::atomic<int64_t> m_clockConsumedFrames{0};              /// 设备已从音频流取走的样本帧数（自环形缓冲区起点）
+    std::atomic<int64_t> m_clockOriginFrames{0};                /// 当前音轨0秒对应的样本帧位置
+    std::atomic<uint64_t> m_clockUpdateTicksNS{0};              /// 最近一次更新时钟的时间（纳秒）
+    std::atomic<bool> m_bClockRunning{false};                   /// 设备是否在输出，暂停时停止插值
+
+    // seek延迟统计
+    std::chrono::steady_clock::time_point m_seekStartTime;      /// 最近一次seek的发起时间（仅在m_decodeMutex下访问）
+    bool m_bSeekLatencyPending{false};                          /// 是否等待统计seek延迟
+    std::atomic<double> m_lastSeekLatencyMs{0.0};               /// 最近一次seek延迟（毫秒）
+
+    size_t m_audioDecodeThreadID{0};                            /// 音频解码线程ID
+    bool m_bHasDecodeThread{false};                             /// 是否已创建音频解码线程
 };
@@ -0,0 +1,324 @@
+#include "AudioOfflineDecoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include "AudioTrackDecoder.h"
+#include "CoreServerGlobal.h"
+#include "LogSystem/LogSystem.h"
+#include "TimeSystem/TimeSystem.h"
+
+/// <summary>
+/// 一次分块解码任务的共享状态，由调用线程和线程池任务共同持有
+/// </summary>
+struct AudioOfflineDecoder::ST_ChunkJob
+{
+    ST_OfflineDecodeParams m_params;                      /// 解码参数（已替换为实际输出参数）
+    ChunkConsumer m_consumer;                             /// 分块输出回调
+    int m_inRate{0};                                      /// 实际输入采样率
+    int64_t m_firstSample{0};                             /// 首个输出样本在源音轨中的位置
+    int64_t m_marginSamples{0};                           /// 分块起点前的余量（源样本）
+    size_t m_frameBytes{0};                               /// 输出每个样本帧的字节数
+    std::vector<int64_t> m_boundaries;                    /// 分块起点（相对首个输出样本的源样本偏移），最后一个分块解码到文件结尾
+    std::unique_ptr<AudioTrackDecoder> m_firstDecoder;    /// 确定输出起点时打开的解码器，由首个分块继续使用
+    std::vector<uint8_t> m_firstPCM;                      /// 确定输出起点时已解码的输出
+    std::atomic<int> m_nextChunk{0};                      /// 下一个待领取的分块
+    std::mutex m_mutex;                                   /// 完成状态互斥锁
+    std::condition_variable m_finishedCondition;          /// 分块完成通知
+    int m_finishedChunks{0};                              /// 已完成的分块数
+    bool m_bFailed{false};                                /// 是否有分块失败
+
+    int GetChunkCount() const
+    {
+        return static_cast<int>(m_boundaries.size());
+    }
+
+    /// <summary>
+    /// 源样本偏移换算为输出样本偏移，分块边界和余量均按比例对齐，结果为整数
+    /// </summary>
+    int64_t ToOutputSamples(int64_t sourceSamples) const
+    {
+        return sourceSamples * m_params.m_outSampleRate / m_inRate;
+    }
+};
+
+int AudioOfflineDecoder::DecodeChunks(ST_OfflineDecodeParams& params, const ChunkConsumer& consumer)
+{
+    TIME_START("OfflineDecode");
+    auto job = std::make_shared<ST_ChunkJob>();
+    job->m_firstDecoder = OpenDecoder(params);
+    if (!job->m_firstDecoder)
+    {
+        LOG_WARN("DecodeChunks() : Failed to open audio file: " + params.m_filePath.toStdString());
+        TimeSystem::Instance().StopTiming("OfflineDecode");
+        return -1;
+    }
+    job->m_params = params;
+    job->m_consumer = consumer;
+    job->m_frameBytes = static_cast<size_t>(params.m_outChannels) * av_get_bytes_per_sample(params.m_outFormat);
+
+    // 先解码到首个输出，以首帧的实际采样率和时间戳作为划分分块的基准
+    AudioTrackDecoder& firstDecoder = *job->m_firstDecoder;
+    DecodeFirstOutput(firstDecoder, job->m_firstPCM);
+    job->m_inRate = firstDecoder.GetResampleParams().GetInput().GetSampleRate();
+    job->m_firstSample = firstDecoder.GetFirstOutputSample();
+    AVFormatContext* formatCtx = firstDecoder.GetOpenFileResult()->m_formatCtx->GetRawContext();
+    const bool bSeekable = formatCtx->pb && (formatCtx->pb->seekable & AVIO_SEEKABLE_NORMAL);
+    PlanChunks(*job, firstDecoder.GetDuration(), bSeekable);
+
+    const int chunkCount = job->GetChunkCount();
+    int threadCount = params.m_maxThreads > 0 ? params.m_maxThreads : static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+    threadCount = std::min(threadCount, chunkCount);
+    LOG_INFO("Offline decode: " + params.m_filePath.toStdString() + ", " + std::to_string(chunkCount) + " chunks on " + std::to_string(threadCount) + " threads");
+
+    // 调用线程同样领取分块，线程池繁忙时也不会因等待未启动的任务而阻塞
+    for (int i = 1; i < threadCount; ++i)
+    {
+        CoreServerGlobal::Instance().GetThreadPool().Submit([job]()
+        {
+            RunChunks(*job);
+        }, EM_TaskPriority::Normal);
+    }
+    RunChunks(*job);
+
+    bool bFailed = false;
+    {
+        std::unique_lock<std::mutex> lock(job->m_mutex);
+        job->m_finishedCondition.wait(lock, [&job, chunkCount]()
+        {
+            return job->m_finishedChunks >= chunkCount;
+        });
+        bFailed = job->m_bFailed;
+    }
+
+    TimeSystem::Instance().StopTimingWithLog("OfflineDecode", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Offline decode of " + std::to_string(chunkCount) + " chunks " + (bFailed ? "failed" : "completed"));
+    return bFailed ? -1 : chunkCount;
+}
+
+bool AudioOfflineDecoder::DecodeFile(ST_OfflineDecodeParams& params, std::vector<uint8_t>& outPCM)
+{
+    std::mutex chunksMutex;
+    std::map<int, std::vector<uint8_t>> chunks;
+    const int chunkCount = DecodeChunks(params, [&](int chunkIndex, int64_t, const uint8_t* data, size_t samples)
+    {
+        const size_t bytes = samples * static_cast<size_t>(params.m_outChannels) * av_get_bytes_per_sample(params.m_outFormat);
+        std::vector<uint8_t> chunk(data, data + bytes);
+        std::lock_guard<std::mutex> lock(chunksMutex);
+        chunks[chunkIndex] = std::move(chunk);
+    });
+    if (chunkCount < 0)
+    {
+        return false;
+    }
+
+    size_t totalBytes = 0;
+    for (const auto& chunk : chunks)
+    {
+        totalBytes += chunk.second.size();
+    }
+    outPCM.clear();
+    outPCM.reserve(totalBytes);
+    for (auto& chunk : chunks)
+    {
+        outPCM.insert(outPCM.end(), chunk.second.begin(), chunk.second.end());
+        std::vector<uint8_t>().swap(chunk.second);
+    }
+    return true;
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioOfflineDecoder::OpenDecoder(ST_OfflineDecodeParams& params)
+{
+    auto openFileResult = std::make_unique<ST_OpenFileResult>();
+    openFileResult->OpenFilePath(params.m_filePath);
+    if (!openFileResult->m_formatCtx || !openFileResult->m_codecCtx)
+    {
+        return nullptr;
+    }
+
+    const AVCodecContext* codecCtx = openFileResult->m_codecCtx->GetRawContext();
+    if (params.m_outSampleRate <= 0)
+    {
+        params.m_outSampleRate = codecCtx->sample_rate;
+    }
+    if (params.m_outChannels <= 0)
+    {
+        params.m_outChannels = codecCtx->ch_layout.nb_channels;
+    }
+
+    auto decoder = std::make_unique<AudioTrackDecoder>();
+    if (!decoder->Init(std::move(openFileResult), params.m_filePath, params.m_outSampleRate, params.m_outFormat, params.m_outChannels, EM_ResampleUsage::Offline))
+    {
+        return nullptr;
+    }
+    return decoder;
+}
+
+void AudioOfflineDecoder::PlanChunks(ST_ChunkJob& job, double duration, bool bSeekable)
+{
+    job.m_boundaries.assign(1, 0);
+    if (job.m_inRate <= 0 || job.m_params.m_outSampleRate <= 0 || job.m_firstSample == AV_NOPTS_VALUE || !bSeekable || duration <= 0.0 || job.m_params.m_maxThreads == 1)
+    {
+        LOG_INFO("Offline decode falls back to a single sequential chunk: " + job.m_params.m_filePath.toStdString());
+        return;
+    }
+
+    // 分块起点需落在输入输出采样率的公共网格上，重采样滤波器的相位才与顺序解码一致；
+    // 同时换算到输出后还需满足调用方的对齐要求
+    const int64_t rateGcd = std::gcd(job.m_inRate, job.m_params.m_outSampleRate);
+    const int64_t gridSamples = job.m_inRate / rateGcd;
+    const int64_t outputPerGrid = job.m_params.m_outSampleRate / rateGcd;
+    const int64_t alignSamples = std::max(job.m_params.m_alignSamples, 1);
+    const int64_t unitSamples = gridSamples * (alignSamples / std::gcd(alignSamples, outputPerGrid));
+
+    const auto totalSamples = static_cast<int64_t>(duration * job.m_inRate);
+    const int64_t chunkSamples = static_cast<int64_t>(CHUNK_SECONDS) * job.m_inRate;
+    const auto chunkCount = static_cast<int>(std::min<int64_t>(std::max<int64_t>(totalSamples / chunkSamples, 1), static_cast<int64_t>(MAX_CHUNKS)));
+    for (int i = 1; i < chunkCount; ++i)
+    {
+        const int64_t boundary = totalSamples * i / chunkCount / unitSamples * unitSamples;
+        if (boundary > job.m_boundaries.back())
+        {
+            job.m_boundaries.push_back(boundary);
+        }
+    }
+
+    const int64_t marginSamples = static_cast<int64_t>(job.m_inRate) * MARGIN_MS / 1000;
+    job.m_marginSamples = (marginSamples + gridSamples - 1) / gridSamples * gridSamples;
+}
+
+void AudioOfflineDecoder::RunChunks(ST_ChunkJob& job)
+{
+    const int chunkCount = job.GetChunkCount();
+    int chunkIndex = job.m_nextChunk++;
+    while (chunkIndex < chunkCount)
+    {
+        bool bFailed = false;
+        {
+            std::lock_guard<std::mutex> lock(job.m_mutex);
+            bFailed = job.m_bFailed;
+        }
+        // 已有分块失败时不再解码，只计入完成数
+        const bool bSuccess = bFailed || DecodeChunk(job, chunkIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(job.m_mutex);
+            job.m_bFailed = job.m_bFailed || !bSuccess;
+            ++job.m_finishedChunks;
+        }
+        job.m_finishedCondition.notify_all();
+        chunkIndex = job.m_nextChunk++;
+    }
+}
+
+bool AudioOfflineDecoder::DecodeChunk(ST_ChunkJob& job, int chunkIndex)
+{
+    const int64_t chunkBegin = job.m_boundaries[chunkIndex];
+    const bool bLastChunk = chunkIndex + 1 == job.GetChunkCount();
+
+    std::vector<uint8_t> pcm;
+    std::unique_ptr<AudioTrackDecoder> decoder;
+    int64_t decodeBegin = 0;
+    if (chunkIndex == 0)
+    {
+        decoder = std::move(job.m_firstDecoder);
+        pcm.swap(job.m_firstPCM);
+    }
+    else
+    {
+        decoder = OpenChunkDecoder(job, chunkBegin, pcm, decodeBegin);
+    }
+    if (!decoder)
+    {
+        LOG_WARN("DecodeChunk() : Failed to open decoder for chunk " + std::to_string(chunkIndex));
+        return false;
+    }
+
+    // 余量部分边解码边丢弃，末块解码到文件结尾
+    size_t skipBytes = static_cast<size_t>(job.ToOutputSamples(chunkBegin - decodeBegin)) * job.m_frameBytes;
+    size_t remainingBytes = bLastChunk ? SIZE_MAX : static_cast<size_t>(job.ToOutputSamples(job.m_boundaries[chunkIndex + 1] - chunkBegin)) * job.m_frameBytes;
+    if (!bLastChunk)
+    {
+        pcm.reserve(remainingBytes);
+    }
+    while (true)
+    {
+        if (skipBytes > 0)
+        {
+            const size_t dropBytes = std::min(skipBytes, pcm.size());
+            pcm.erase(pcm.begin(), pcm.begin() + static_cast<std::ptrdiff_t>(dropBytes));
+            skipBytes -= dropBytes;
+        }
+        if (skipBytes == 0 && pcm.size() >= remainingBytes)
+        {
+            break;
+        }
+        if (!decoder->DecodePacket(pcm))
+        {
+            decoder->Flush(pcm);
+            const size_t dropBytes = std::min(skipBytes, pcm.size());
+            pcm.erase(pcm.begin(), pcm.begin() + static_cast<std::ptrdiff_t>(dropBytes));
+            break;
+        }
+    }
+
+    // 文件比声明的时长短时后面的分块可能没有数据
+    const size_t bytes = std::min(pcm.size(), remainingBytes);
+    job.m_consumer(chunkIndex, job.ToOutputSamples(chunkBegin), pcm.data(), bytes / job.m_frameBytes);
+    return true;
+}
+
+std::unique_ptr<AudioTrackDecoder> AudioOfflineDecoder::OpenChunkDecoder(ST_ChunkJob& job, int64_t chunkBegin, std::vector<uint8_t>& pcm, int64_t& decodeBegin)
+{
+    for (int attempt = 0; attempt < SEEK_ATTEMPTS; ++attempt)
+    {
+        decodeBegin = chunkBegin - (job.m_marginSamples << attempt);
+        const int64_t seekSample = job.m_firstSample + decodeBegin;
+        if (decodeBegin <= 0 || seekSample < 0)
+        {
+            break;
+        }
+
+        auto decoder = OpenDecoder(job.m_params);
+        if (!decoder)
+        {
+            return nullptr;
+        }
+        pcm.clear();
+        if (!decoder->Seek(static_cast<double>(seekSample) / job.m_inRate))
+        {
+            break;
+        }
+
+        // 首帧时间戳早于目标时已按样本裁剪；晚于目标说明seek落在目标之后，需加大余量
+        const bool bEOF = DecodeFirstOutput(*decoder, pcm);
+        const int64_t firstOutputSample = decoder->GetFirstOutputSample();
+        if (firstOutputSample == seekSample || (bEOF && pcm.empty() && firstOutputSample == AV_NOPTS_VALUE))
+        {
+            return decoder;
+        }
+        LOG_DEBUG("Chunk seek landed at sample " + std::to_string(firstOutputSample) + " instead of " + std::to_string(seekSample) + ", retrying with a larger margin");
+    }
+
+    // 无法精确定位时从头解码，结果仍与顺序解码一致
+    LOG_WARN("Chunk at sample " + std::to_string(chunkBegin) + " cannot be located accurately, decoding from the beginning");
+    decodeBegin = 0;
+    pcm.clear();
+    return OpenDecoder(job.m_params);
+}
+
+bool AudioOfflineDecoder::DecodeFirstOutput(AudioTrackDecoder& decoder, std::vector<uint8_t>& pcm)
+{
+    // 帧没有时间戳时首个输出位置始终未知，以产生输出为准
+    while (pcm.empty() && decoder.GetFirstOutputSample() == AV_NOPTS_VALUE)
+    {
+        if (!decoder.DecodePacket(pcm))
+        {
+            return true;
+        }
+    }
+    return false;
+}
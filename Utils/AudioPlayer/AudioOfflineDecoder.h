@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QString>
+
+extern "C"
+{
+#include <libavutil/samplefmt.h>
+}
+
+class AudioTrackDecoder;
+
+/// <summary>
+/// 离线解码参数
+/// </summary>
+struct ST_OfflineDecodeParams
+{
+    QString m_filePath;                            /// 文件路径
+    int m_outSampleRate{0};                        /// 输出采样率，0表示使用源采样率
+    AVSampleFormat m_outFormat{AV_SAMPLE_FMT_FLT}; /// 输出采样格式（交错）
+    int m_outChannels{0};                          /// 输出声道数，0表示使用源声道数
+    int m_alignSamples{1};                         /// 分块起点在输出中对齐的样本数（如波形每个点对应的样本数）
+    int m_maxThreads{0};                           /// 最大并行数，0表示按CPU核心数
+};
+
+/// <summary>
+/// 长文件的分块并行离线解码器（用于波形分析、导出等批处理）
+/// 在可seek的位置把音轨切分为若干分块，每个分块单独打开文件、从分块起点前一段余量处精确seek，
+/// 在CoreServerGlobal线程池上并行解码和重采样，丢弃余量部分后按样本精确拼接，结果与从头顺序解码一致
+/// </summary>
+class AudioOfflineDecoder
+{
+public:
+    /// <summary>
+    /// 分块输出回调，在工作线程中调用，不同分块的回调可能并发执行
+    /// </summary>
+    /// <param name="chunkIndex">分块序号</param>
+    /// <param name="outputOffset">分块首个样本在整条输出中的位置（样本帧）</param>
+    /// <param name="data">交错PCM数据</param>
+    /// <param name="samples">样本帧数</param>
+    using ChunkConsumer = std::function<void(int chunkIndex, int64_t outputOffset, const uint8_t* data, size_t samples)>;
+
+    /// <summary>
+    /// 分块并行解码，每个分块完成后回调一次；无法按时间戳精确定位的文件退化为单个分块顺序解码
+    /// </summary>
+    /// <param name="params">解码参数，为0的输出采样率和声道数在打开文件后替换为源音频参数（先于任何回调）</param>
+    /// <param name="consumer">分块输出回调</param>
+    /// <returns>分块数，失败返回-1</returns>
+    static int DecodeChunks(ST_OfflineDecodeParams& params, const ChunkConsumer& consumer);
+
+    /// <summary>
+    /// 分块并行解码整条音轨并按顺序拼接
+    /// </summary>
+    /// <param name="params">解码参数，为0的输出采样率和声道数替换为源音频参数</param>
+    /// <param name="outPCM">输出PCM数据</param>
+    /// <returns>是否成功</returns>
+    static bool DecodeFile(ST_OfflineDecodeParams& params, std::vector<uint8_t>& outPCM);
+
+private:
+    struct ST_ChunkJob;
+
+    /// <summary>
+    /// 打开文件并初始化离线用途的音轨解码器
+    /// </summary>
+    /// <param name="params">解码参数，为0的输出参数替换为源音频参数</param>
+    static std::unique_ptr<AudioTrackDecoder> OpenDecoder(ST_OfflineDecodeParams& params);
+
+    /// <summary>
+    /// 按源音轨长度、采样率比例和对齐要求划分分块
+    /// </summary>
+    /// <param name="job">解码任务</param>
+    /// <param name="duration">音轨时长（秒）</param>
+    /// <param name="bSeekable">文件是否可以seek</param>
+    static void PlanChunks(ST_ChunkJob& job, double duration, bool bSeekable);
+
+    /// <summary>
+    /// 工作线程循环领取并解码分块，直到没有剩余分块
+    /// </summary>
+    static void RunChunks(ST_ChunkJob& job);
+
+    /// <summary>
+    /// 解码一个分块并回调输出
+    /// </summary>
+    /// <param name="job">解码任务</param>
+    /// <param name="chunkIndex">分块序号</param>
+    /// <returns>是否成功</returns>
+    static bool DecodeChunk(ST_ChunkJob& job, int chunkIndex);
+
+    /// <summary>
+    /// 打开解码器并精确seek到分块起点前的余量处，首个输出样本位置与目标不一致时加大余量重试，
+    /// 仍不一致则从头解码
+    /// </summary>
+    /// <param name="job">解码任务</param>
+    /// <param name="chunkBegin">分块起点（相对首个输出样本的源样本偏移）</param>
+    /// <param name="pcm">已解码的输出</param>
+    /// <param name="decodeBegin">解码起点（相对首个输出样本的源样本偏移）</param>
+    static std::unique_ptr<AudioTrackDecoder> OpenChunkDecoder(ST_ChunkJob& job, int64_t chunkBegin, std::vector<uint8_t>& pcm, int64_t& decodeBegin);
+
+    /// <summary>
+    /// 解码直到得到首个输出样本或文件结束
+    /// </summary>
+    /// <returns>是否读到文件结尾</returns>
+    static bool DecodeFirstOutput(AudioTrackDecoder& decoder, std::vector<uint8_t>& pcm);
+
+private:
+    static const int CHUNK_SECONDS{60};  /// 每个分块的目标时长（秒），分块数多于线程数以便负载均衡并限制单块内存
+    static const int MARGIN_MS{500};     /// 分块起点前的余量（毫秒），覆盖解码器和重采样滤波器的启动过程
+    static const int MAX_CHUNKS{4096};   /// 最大分块数
+    static const int SEEK_ATTEMPTS{3};   /// 精确seek的尝试次数，每次余量加倍
+};
@@ -0,0 +1,121 @@
+#include "AudioPCMCache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include "LogSystem/LogSystem.h"
+
+qint64 AudioPCMCache::GetLastModified(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists())
+    {
+        return -1;
+    }
+    return fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+void AudioPCMCache::SetBudgetBytes(size_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    EvictToBudget();
+}
+
+size_t AudioPCMCache::GetBudgetBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+size_t AudioPCMCache::GetUsedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usedBytes;
+}
+
+bool AudioPCMCache::FindSourceFormat(const QString& filePath, qint64 lastModified, int& sourceSampleRate, int& sourceChannels, AVSampleFormat& sourceFormat) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_entries)
+    {
+        if (entry->m_key.m_filePath == filePath && entry->m_key.m_lastModified == lastModified)
+        {
+            sourceSampleRate = entry->m_sourceSampleRate;
+            sourceChannels = entry->m_sourceChannels;
+            sourceFormat = entry->m_sourceFormat;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<const ST_PCMCacheEntry> AudioPCMCache::Find(const ST_PCMCacheKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((*it)->m_key == key)
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            ++m_hitCount;
+            LOG_INFO("PCM cache hit: " + key.m_filePath.toStdString() + " (hits: " + std::to_string(m_hitCount.load()) + ", misses: " + std::to_string(m_missCount.load()) + ")");
+            return m_entries.front();
+        }
+    }
+
+    ++m_missCount;
+    LOG_INFO("PCM cache miss: " + key.m_filePath.toStdString() + " (hits: " + std::to_string(m_hitCount.load()) + ", misses: " + std::to_string(m_missCount.load()) + ")");
+    return nullptr;
+}
+
+void AudioPCMCache::Insert(std::shared_ptr<const ST_PCMCacheEntry> entry)
+{
+    if (!entry || entry->m_pcm.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry->m_pcm.size() > m_budgetBytes)
+    {
+        LOG_INFO("PCM cache skipped, track exceeds budget: " + entry->m_key.m_filePath.toStdString() + ", " + std::to_string(entry->m_pcm.size()) + " bytes");
+        return;
+    }
+
+    // 同一文件的旧版本或旧输出格式已无用，一并移除
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if ((*it)->m_key.m_filePath == entry->m_key.m_filePath)
+        {
+            m_usedBytes -= (*it)->m_pcm.size();
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_usedBytes += entry->m_pcm.size();
+    m_entries.push_front(std::move(entry));
+    EvictToBudget();
+    LOG_INFO("PCM cache stored: " + m_entries.front()->m_key.m_filePath.toStdString() + ", " + std::to_string(m_entries.front()->m_pcm.size()) + " bytes, used " + std::to_string(m_usedBytes) + " of " + std::to_string(m_budgetBytes) + " bytes");
+}
+
+void AudioPCMCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_usedBytes = 0;
+}
+
+void AudioPCMCache::EvictToBudget()
+{
+    // 正在播放的缓存项由音轨持有引用，淘汰后在播放结束时才释放
+    while (!m_entries.empty() && m_usedBytes > m_budgetBytes)
+    {
+        LOG_DEBUG("PCM cache evicted: " + m_entries.back()->m_key.m_filePath.toStdString());
+        m_usedBytes -= m_entries.back()->m_pcm.size();
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QString>
+
+extern "C"
+{
+#include <libavutil/samplefmt.h>
+}
+
+/// <summary>
+/// 已解码PCM缓存的键：文件路径、修改时间和输出格式
+/// </summary>
+struct ST_PCMCacheKey
+{
+    QString m_filePath;                                /// 文件路径
+    qint64 m_lastModified{0};                          /// 文件修改时间（毫秒）
+    int m_sampleRate{0};                               /// 输出采样率
+    AVSampleFormat m_sampleFormat{AV_SAMPLE_FMT_NONE}; /// 输出采样格式（交错）
+    int m_channels{0};                                 /// 输出声道数
+
+    bool operator==(const ST_PCMCacheKey& other) const
+    {
+        return m_filePath == other.m_filePath && m_lastModified == other.m_lastModified && m_sampleRate == other.m_sampleRate && m_sampleFormat == other.m_sampleFormat && m_channels == other.m_channels;
+    }
+};
+
+/// <summary>
+/// 已解码PCM缓存项：整首音轨转换为输出格式后的PCM数据
+/// </summary>
+struct ST_PCMCacheEntry
+{
+    ST_PCMCacheKey m_key;                                /// 缓存键
+    int m_sourceSampleRate{0};                           /// 源采样率，用于命中前协商输出格式
+    int m_sourceChannels{0};                             /// 源声道数
+    AVSampleFormat m_sourceFormat{AV_SAMPLE_FMT_NONE};   /// 源采样格式
+    double m_duration{0.0};                              /// 音轨时长（秒）
+    std::vector<uint8_t> m_pcm;                          /// PCM数据
+};
+
+/// <summary>
+/// 最近播放音轨的已解码PCM缓存
+/// 按字节预算做LRU淘汰，命中时重放和seek无需再打开、解码和重采样；线程安全
+/// </summary>
+class AudioPCMCache
+{
+public:
+    /// <summary>
+    /// 构造函数
+    /// </summary>
+    AudioPCMCache() = default;
+
+    AudioPCMCache(const AudioPCMCache&) = delete;
+    AudioPCMCache& operator=(const AudioPCMCache&) = delete;
+
+    /// <summary>
+    /// 获取文件修改时间（毫秒），文件不存在时返回-1
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    static qint64 GetLastModified(const QString& filePath);
+
+    /// <summary>
+    /// 设置缓存字节预算，超出时立即按LRU淘汰；0表示禁用缓存
+    /// </summary>
+    /// <param name="budgetBytes">字节预算</param>
+    void SetBudgetBytes(size_t budgetBytes);
+
+    /// <summary>
+    /// 获取缓存字节预算
+    /// </summary>
+    size_t GetBudgetBytes() const;
+
+    /// <summary>
+    /// 获取已缓存的字节数
+    /// </summary>
+    size_t GetUsedBytes() const;
+
+    /// <summary>
+    /// 查找缓存中记录的源格式，不计入命中统计
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="lastModified">文件修改时间（毫秒）</param>
+    /// <param name="sourceSampleRate">源采样率</param>
+    /// <param name="sourceChannels">源声道数</param>
+    /// <param name="sourceFormat">源采样格式</param>
+    /// <returns>是否存在该文件的缓存</returns>
+    bool FindSourceFormat(const QString& filePath, qint64 lastModified, int& sourceSampleRate, int& sourceChannels, AVSampleFormat& sourceFormat) const;
+
+    /// <summary>
+    /// 查找缓存项，命中时移到最近使用位置
+    /// </summary>
+    /// <param name="key">缓存键</param>
+    /// <returns>缓存项，未命中返回nullptr</returns>
+    std::shared_ptr<const ST_PCMCacheEntry> Find(const ST_PCMCacheKey& key);
+
+    /// <summary>
+    /// 插入缓存项，替换同键的旧项；超出预算的单项不缓存
+    /// </summary>
+    /// <param name="entry">缓存项</param>
+    void Insert(std::shared_ptr<const ST_PCMCacheEntry> entry);
+
+    /// <summary>
+    /// 清空缓存
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 获取命中次数
+    /// </summary>
+    uint64_t GetHitCount() const
+    {
+        return m_hitCount.load();
+    }
+
+    /// <summary>
+    /// 获取未命中次数
+    /// </summary>
+    uint64_t GetMissCount() const
+    {
+        return m_missCount.load();
+    }
+
+private:
+    /// <summary>
+    /// 按LRU淘汰直到不超出预算（调用方需持有m_mutex）
+    /// </summary>
+    void EvictToBudget();
+
+private:
+    static const size_t DEFAULT_BUDGET_BYTES{256 * 1024 * 1024}; /// 默认字节预算
+
+    mutable std::mutex m_mutex;                                   /// 缓存互斥锁
+    std::list<std::shared_ptr<const ST_PCMCacheEntry>> m_entries; /// 缓存项，表头为最近使用
+    size_t m_usedBytes{0};                                        /// 已缓存的字节数
+    size_t m_budgetBytes{DEFAULT_BUDGET_BYTES};                   /// 字节预算
+    std::atomic<uint64_t> m_hitCount{0};                          /// 命中次数
+    std::atomic<uint64_t> m_missCount{0};                         /// 未命中次数
+};
@@ -1,5 +1,8 @@
 ﻿#include "AudioPlayerUtils.h"
 
+#include <map>
+#include <mutex>
+#include "AudioOfflineDecoder.h"
 #include "BaseDataDefine/ST_AVFrame.h"
 #include "BaseDataDefine/ST_AVInputFormat.h"
 #include "BaseDataDefine/ST_AVPacket.h"
@@ -191,6 +194,31 @@ void AudioPlayerUtils::ProcessInt32Samples(AVFrame* frame, QVector<float>& wavef
     }
 }
 
+void AudioPlayerUtils::ProcessInterleavedFloat(const float* data, size_t samples, int channels, QVector<float>& waveformData, int samplesPerPixel, float& currentSum, int& sampleCount, float& maxSample)
+{
+    for (size_t i = 0; i < samples; i++)
+    {
+        float sample = 0.0f;
+        for (int ch = 0; ch < channels; ch++)
+        {
+            sample += std::abs(data[i * channels + ch]);
+        }
+        sample /= channels; // 取平均值
+
+        currentSum += sample;
+        sampleCount++;
+
+        if (sampleCount >= samplesPerPixel)
+        {
+            float average = currentSum / sampleCount;
+            waveformData.append(average);
+            maxSample = std::max(maxSample, average);
+            currentSum = 0.0f;
+            sampleCount = 0;
+        }
+    }
+}
+
 QStringList AudioPlayerUtils::GetInputAudioDevices()
 {
     QStringList devices;
@@ -211,54 +239,50 @@ bool AudioPlayerUtils::LoadAudioWaveform(const QString& filePath, QVector<float>
         return false;
     }
 
-    AV_TIMER_START("Audio", "WaveformFileOpen");
-    ST_OpenFileResult openFileResult;
-    openFileResult.OpenFilePath(filePath);
-
-    if (!openFileResult.m_formatCtx || !openFileResult.m_codecCtx)
-    {
-        LOG_WARN("LoadAudioWaveform() : Failed to open audio file");
-        TimeSystem::Instance().StopTimingWithLog("AudioWaveformLoading", EM_TimingLogLevel::Warning, EM_TimeUnit::Milliseconds, "Failed to open waveform file");
-        return false;
-    }
-
     // 清空之前的数据
     waveformData.clear();
 
-    // 读取音频数据并计算波形
-    ST_AVPacket packet;
-    ST_AVFrame frame;
+    // 以源采样率和声道数解码为交错浮点；分块起点按像素对齐，各分块可独立计算波形点
     const int SAMPLES_PER_PIXEL = 1024; // 每个像素点对应的采样数
-    float maxSample = 0.0f;
-    float currentSum = 0.0f;
-    int sampleCount = 0;
-
-    int processedPackets = 0;
+    ST_OfflineDecodeParams decodeParams;
+    decodeParams.m_filePath = filePath;
+    decodeParams.m_outFormat = AV_SAMPLE_FMT_FLT;
+    decodeParams.m_alignSamples = SAMPLES_PER_PIXEL;
 
-
-    while (packet.ReadPacket(openFileResult.m_formatCtx->GetRawContext()))
+    std::mutex chunkMutex;
+    std::map<int, QVector<float>> chunkWaveforms;
+    float maxSample = 0.0f;
+    const int chunkCount = AudioOfflineDecoder::DecodeChunks(decodeParams, [&](int chunkIndex, int64_t, const uint8_t* data, size_t samples)
     {
-        if (packet.GetStreamIndex() == openFileResult.m_audioStreamIdx)
+        QVector<float> chunkWaveform;
+        float chunkMax = 0.0f;
+        float currentSum = 0.0f;
+        int sampleCount = 0;
+        ProcessInterleavedFloat(reinterpret_cast<const float*>(data), samples, decodeParams.m_outChannels, chunkWaveform, SAMPLES_PER_PIXEL, currentSum, sampleCount, chunkMax);
+
+        // 处理剩余的样本（只有最后一个分块不满一个像素）
+        if (sampleCount > 0)
         {
-            if (packet.SendPacket(openFileResult.m_codecCtx->GetRawContext()))
-            {
-                while (frame.GetCodecFrame(openFileResult.m_codecCtx->GetRawContext()))
-                {
-                    // 处理不同的采样格式
-                    AudioPlayerUtils::ProcessAudioFrame(frame.GetRawFrame(), waveformData, SAMPLES_PER_PIXEL, currentSum, sampleCount, maxSample);
-                }
-            }
-            processedPackets++;
+            float average = currentSum / sampleCount;
+            chunkWaveform.append(average);
+            chunkMax = std::max(chunkMax, average);
         }
-        packet.UnrefPacket();
+
+        std::lock_guard<std::mutex> lock(chunkMutex);
+        chunkWaveforms[chunkIndex] = std::move(chunkWaveform);
+        maxSample = std::max(maxSample, chunkMax);
+    });
+
+    if (chunkCount < 0)
+    {
+        LOG_WARN("LoadAudioWaveform() : Failed to decode audio file");
+        TimeSystem::Instance().StopTimingWithLog("AudioWaveformLoading", EM_TimingLogLevel::Warning, EM_TimeUnit::Milliseconds, "Failed to decode waveform file");
+        return false;
     }
 
-    // 处理剩余的样本
-    if (sampleCount > 0)
+    for (const auto& chunkWaveform : chunkWaveforms)
     {
-        float average = currentSum / sampleCount;
-        waveformData.append(average);
-        maxSample = std::max(maxSample, average);
+        waveformData.append(chunkWaveform.second);
     }
 
     // 归一化波形数据
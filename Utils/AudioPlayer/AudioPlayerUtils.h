@@ -54,13 +54,21 @@ public:
     /// </summary>
     static void ProcessInt32Samples(AVFrame* frame, QVector<float>& waveformData, int samplesPerPixel, float& currentSum, int& sampleCount, float& maxSample);
 
+    /// <summary>
+    /// 处理交错浮点PCM数据
+    /// </summary>
+    /// <param name="data">交错浮点PCM数据</param>
+    /// <param name="samples">样本帧数</param>
+    /// <param name="channels">声道数</param>
+    static void ProcessInterleavedFloat(const float* data, size_t samples, int channels, QVector<float>& waveformData, int samplesPerPixel, float& currentSum, int& sampleCount, float& maxSample);
+
     /// <summary>
     /// 获取所有音频输入设备
     /// </summary>
     /// <returns>设备列表</returns>
     static QStringList GetInputAudioDevices();
     /// <summary>
-    /// 加载音频波形数据
+    /// 加载音频波形数据，长文件按分块并行解码
     /// </summary>
     /// <param name="filePath"></param>
     /// <param name="waveformData"></param>
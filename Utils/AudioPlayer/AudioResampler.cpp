@@ -1,12 +1,104 @@
 ﻿#include "AudioResampler.h"
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <mutex>
 #include <QDebug>
 #include <vector>
 #include "LogSystem/LogSystem.h"
 #include "TimeSystem/TimeSystem.h"
 
-AudioResampler::AudioResampler()
-    : m_lastInLayout(nullptr), m_lastOutLayout(nullptr)
+namespace
+{
+std::mutex s_defaultConfigMutex;
+ST_ResamplerConfig s_defaultConfigs[] = {{EM_ResamplerBackend::Swr, EM_ResampleQuality::Balanced}, {EM_ResamplerBackend::Swr, EM_ResampleQuality::High}};
+
+/// <summary>
+/// 构造交错浮点立体声的重采样参数，用于基准测试
+/// </summary>
+ST_ResampleParams MakeBenchmarkParams(int inRate, int outRate)
+{
+    ST_ResampleParams params;
+    params.GetInput().SetSampleRate(inRate);
+    params.GetInput().SetSampleFormat(ST_AVSampleFormat(AV_SAMPLE_FMT_FLT));
+    params.GetOutput().SetSampleRate(outRate);
+    params.GetOutput().SetSampleFormat(ST_AVSampleFormat(AV_SAMPLE_FMT_FLT));
+    for (ST_ResampleSimpleData* data : {&params.GetInput(), &params.GetOutput()})
+    {
+        auto layout = static_cast<AVChannelLayout*>(av_mallocz(sizeof(AVChannelLayout)));
+        if (layout)
+        {
+            av_channel_layout_default(layout, 2);
+            data->SetChannelLayout(ST_AVChannelLayout(layout));
+        }
+    }
+    return params;
+}
+
+/// <summary>
+/// 计算THD+N（dB）：对首声道的中间80%按最小二乘拟合已知频率的正弦和直流分量，残差能量与总能量之比
+/// </summary>
+double MeasureThdN(const std::vector<float>& interleaved, int channels, int sampleRate, double toneHz)
+{
+    const size_t samples = interleaved.size() / channels;
+    const size_t begin = samples / 10;
+    const size_t end = samples - samples / 10;
+    const double omega = 2.0 * 3.14159265358979323846 * toneHz / sampleRate;
+
+    // 正规方程 (A^T A) x = A^T y，基函数为cos、sin和常数
+    double normal[3][3] = {{0.0}};
+    double rhs[3] = {0.0};
+    for (size_t i = begin; i < end; ++i)
+    {
+        const double basis[3] = {std::cos(omega * i), std::sin(omega * i), 1.0};
+        const double value = interleaved[i * channels];
+        for (int row = 0; row < 3; ++row)
+        {
+            rhs[row] += basis[row] * value;
+            for (int col = 0; col < 3; ++col)
+            {
+                normal[row][col] += basis[row] * basis[col];
+            }
+        }
+    }
+    for (int pivot = 0; pivot < 3; ++pivot)
+    {
+        for (int row = pivot + 1; row < 3; ++row)
+        {
+            const double ratio = normal[row][pivot] / normal[pivot][pivot];
+            for (int col = 0; col < 3; ++col)
+            {
+                normal[row][col] -= ratio * normal[pivot][col];
+            }
+            rhs[row] -= ratio * rhs[pivot];
+        }
+    }
+    double fit[3] = {0.0};
+    for (int row = 2; row >= 0; --row)
+    {
+        double sum = rhs[row];
+        for (int col = row + 1; col < 3; ++col)
+        {
+            sum -= normal[row][col] * fit[col];
+        }
+        fit[row] = sum / normal[row][row];
+    }
+
+    double residualEnergy = 0.0;
+    double totalEnergy = 0.0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const double value = interleaved[i * channels];
+        const double residual = value - (fit[0] * std::cos(omega * i) + fit[1] * std::sin(omega * i) + fit[2]);
+        residualEnergy += residual * residual;
+        totalEnergy += value * value;
+    }
+    return (totalEnergy > 0.0 && residualEnergy > 0.0) ? 10.0 * std::log10(residualEnergy / totalEnergy) : -200.0;
+}
+} // namespace
+
+AudioResampler::AudioResampler(EM_ResampleUsage usage)
+    : m_lastInLayout(nullptr), m_lastOutLayout(nullptr), m_config(GetDefaultConfig(usage))
 {
     m_lastInFmt.sampleFormat = AV_SAMPLE_FMT_NONE;
     m_lastOutFmt.sampleFormat = AV_SAMPLE_FMT_NONE;
@@ -25,7 +117,7 @@ void AudioResampler::Resample(const uint8_t** inputData, int inputSamples, ST_Re
     }
 
     // 验证重采样器上下文
-    if (!m_swrCtx.GetRawContext())
+    if (!IsInitialized())
     {
         TIME_START("ResamplerInit");
         if (!InitializeResampler(params))
@@ -45,14 +137,8 @@ void AudioResampler::Resample(const uint8_t** inputData, int inputSamples, ST_Re
         return;
     }
 
-    // 计算输出样本数，使用更安全的计算方式
-    int64_t delay = m_swrCtx.GetDelayData(params.GetInput().GetSampleRate());
-    int outSamples = static_cast<int>(av_rescale_rnd(delay + inputSamples, params.GetOutput().GetSampleRate(), params.GetInput().GetSampleRate(), AV_ROUND_UP));
-
-    // 确保输出样本数合理，添加更多安全检查
-    outSamples = std::max(outSamples, inputSamples);
-    outSamples = std::max(outSamples, 1024);  // 最小缓冲区
-    outSamples = std::min(outSamples, 65536); // 最大缓冲区限制
+    // 计算输出样本数上限（含重采样器内部缓存的样本）
+    int outSamples = GetMaxOutputSamples(inputSamples, params);
 
     // 验证输出样本数
     if (outSamples <= 0)
@@ -80,62 +166,33 @@ void AudioResampler::Resample(const uint8_t** inputData, int inputSamples, ST_Re
         return;
     }
 
-    // 使用对齐分配以提高性能和避免访问冲突
-    auto alignedBuffer = static_cast<uint8_t*>(av_malloc(bufSize + AV_INPUT_BUFFER_PADDING_SIZE));
-    if (!alignedBuffer)
+    // 直接转换到结果缓冲区，不经过中间缓冲区
+    std::vector<uint8_t> outData(static_cast<size_t>(bufSize));
+    TIME_START("SwrConvert");
+    int realOutSamples = ResampleInto(inputData, inputSamples, outData.data(), outSamples, params);
+    double convertDuration = TimeSystem::Instance().StopTiming("SwrConvert", EM_TimeUnit::Microseconds);
+    if (realOutSamples <= 0)
     {
-        LOG_ERROR("Resample() : Failed to allocate aligned buffer");
         output.SetData(std::vector<uint8_t>());
-        return;
     }
-
-    // 清零padding区域
-    memset(alignedBuffer + bufSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
-
-        uint8_t* outBuf = alignedBuffer;
-
-        // 执行重采样
-        TIME_START("SwrConvert");
-        int realOutSamples = m_swrCtx.SwrConvert(&outBuf, outSamples, inputData, inputSamples);
-        double convertDuration = TimeSystem::Instance().StopTiming("SwrConvert", EM_TimeUnit::Microseconds);
-        if (realOutSamples <= 0)
+    else
+    {
+        // 只在转换耗时较长时记录
+        if (convertDuration > 500) // 大于0.5ms
         {
-            output.SetData(std::vector<uint8_t>());
+            LOG_DEBUG("Resampling conversion took " + std::to_string(convertDuration) + " μs");
         }
-        else
-        {
-            // 只在转换耗时较长时记录
-            if (convertDuration > 500) // 大于0.5ms
-            {
-                LOG_DEBUG("Resampling conversion took " + std::to_string(convertDuration) + " μs");
-            }
 
-            // 计算实际输出缓冲区大小
-            size_t realBufSize = av_samples_get_buffer_size(nullptr, outChannels, realOutSamples, params.GetOutput().GetSampleFormat().sampleFormat, 1);
+        outData.resize(av_samples_get_buffer_size(nullptr, outChannels, realOutSamples, params.GetOutput().GetSampleFormat().sampleFormat, 1));
+        output.SetData(std::move(outData));
 
-            if (realBufSize > 0 && realBufSize <= static_cast<size_t>(bufSize))
-            {
-                // 创建输出向量并复制数据
-                std::vector<uint8_t> tempData(realBufSize);
-                memcpy(tempData.data(), alignedBuffer, realBufSize);
-                output.SetData(std::move(tempData));
-
-                // 填充结果信息
-                output.SetSamples(realOutSamples);
-                output.SetChannels(outChannels);
-                output.SetSampleRate(params.GetOutput().GetSampleRate());
-                output.SetSampleFormat(params.GetOutput().GetSampleFormat());
-            }
-            else
-            {
-                LOG_WARN("Invalid real buffer size: " + std::to_string(realBufSize));
-                output.SetData(std::vector<uint8_t>());
-            }
-        }
+        // 填充结果信息
+        output.SetSamples(realOutSamples);
+        output.SetChannels(outChannels);
+        output.SetSampleRate(params.GetOutput().GetSampleRate());
+        output.SetSampleFormat(params.GetOutput().GetSampleFormat());
+    }
 
-    // 释放对齐的缓冲区
-    av_free(alignedBuffer);
-    
     // 只在较长耗时时记录
     double duration = TimeSystem::Instance().StopTiming("AudioResampler", EM_TimeUnit::Microseconds);
     if (duration > 1000) // 大于1ms才记录
@@ -144,19 +201,95 @@ void AudioResampler::Resample(const uint8_t** inputData, int inputSamples, ST_Re
     }
 }
 
+int AudioResampler::GetMaxOutputSamples(int inputSamples, ST_ResampleParams& params)
+{
+    if (!IsInitialized() && !InitializeResampler(params))
+    {
+        return -1;
+    }
+
+    // 格式转换不改变样本数，也没有内部缓存
+    if (m_bDirectConvert)
+    {
+        return inputSamples;
+    }
+    if (m_polyphase)
+    {
+        return m_polyphase->GetMaxOutputSamples(inputSamples);
+    }
+    return m_swrCtx.GetOutSamples(inputSamples);
+}
+
+int AudioResampler::ResampleInto(const uint8_t** inputData, int inputSamples, uint8_t* output, int maxOutputSamples, ST_ResampleParams& params)
+{
+    if (!inputData || !inputData[0] || inputSamples <= 0 || !output || maxOutputSamples <= 0)
+    {
+        LOG_ERROR("ResampleInto() : Invalid parameters");
+        return -1;
+    }
+
+    if (!IsInitialized() && !InitializeResampler(params))
+    {
+        LOG_ERROR("Failed to initialize resampler");
+        return -1;
+    }
+
+    if (m_bDirectConvert)
+    {
+        if (inputSamples > maxOutputSamples)
+        {
+            LOG_ERROR("ResampleInto() : Output buffer too small for direct convert");
+            return -1;
+        }
+        m_directConverter.Convert(inputData, inputSamples, output);
+        return inputSamples;
+    }
+
+    if (m_polyphase)
+    {
+        return m_polyphase->Process(inputData, inputSamples, output, maxOutputSamples);
+    }
+
+    // 输出为交错格式，只有一个数据平面
+    uint8_t* outBuf = output;
+    return m_swrCtx.SwrConvert(&outBuf, maxOutputSamples, inputData, inputSamples);
+}
+
+int AudioResampler::FlushInto(uint8_t* output, int maxOutputSamples)
+{
+    if (m_polyphase)
+    {
+        return m_polyphase->Flush(output, maxOutputSamples);
+    }
+
+    if (!m_swrCtx.GetRawContext() || !output || maxOutputSamples <= 0)
+    {
+        return 0;
+    }
+
+    uint8_t* outBuf = output;
+    return m_swrCtx.SwrConvert(&outBuf, maxOutputSamples, nullptr, 0);
+}
+
 void AudioResampler::Flush(ST_ResampleResult& output, ST_ResampleParams& params)
 {
     TIME_START("ResamplerFlush");
 
-    if (!m_swrCtx.GetRawContext())
+    // 格式转换快速路径没有内部缓存的样本
+    if (m_bDirectConvert)
+    {
+        output.SetData(std::vector<uint8_t>());
+        return;
+    }
+
+    if (!m_polyphase && !m_swrCtx.GetRawContext())
     {
         LOG_WARN("Flush() : No resampler context available");
         return;
     }
 
     // 估算剩余样本
-    
-    int delaySamples = m_swrCtx.GetDelayData(params.GetOutput().GetSampleRate());
+    int delaySamples = m_polyphase ? m_polyphase->GetMaxOutputSamples(0) : m_swrCtx.GetDelayData(params.GetOutput().GetSampleRate());
     if (delaySamples <= 0)
     {
         output.SetData(std::vector<uint8_t>());
@@ -170,7 +303,7 @@ void AudioResampler::Flush(ST_ResampleResult& output, ST_ResampleParams& params)
     uint8_t* outBuf = tempData.data();
 
     // 获取剩余数据
-    int realOutSamples = m_swrCtx.SwrConvert(&outBuf, delaySamples, nullptr, 0);
+    int realOutSamples = FlushInto(outBuf, delaySamples);
     if (realOutSamples < 0)
     {
         LOG_WARN("Flush() : Failed to flush resampler");
@@ -191,6 +324,18 @@ void AudioResampler::Flush(ST_ResampleResult& output, ST_ResampleParams& params)
     TimeSystem::Instance().StopTimingWithLog("ResamplerFlush", EM_TimingLogLevel::Debug, EM_TimeUnit::Microseconds, "Resampler flushed");
 }
 
+void AudioResampler::Reset()
+{
+    if (m_polyphase)
+    {
+        m_polyphase->Reset();
+    }
+    if (m_swrCtx.GetRawContext() && m_swrCtx.SwrContextReset() < 0)
+    {
+        LOG_WARN("Reset() : Failed to reset resampler context");
+    }
+}
+
 ST_ResampleParams AudioResampler::GetResampleParams(const QString& format)
 {
     ST_ResampleParams params;
@@ -241,6 +386,20 @@ bool AudioResampler::InitializeResampler(ST_ResampleParams& params)
         needReinit = true;
     }
 
+    // 后端可能在两次初始化之间切换，先释放多相重采样器
+    m_polyphase.reset();
+    if (InitializeDirectConvert(params))
+    {
+        TimeSystem::Instance().StopTimingWithLog("ResamplerContextInit", EM_TimingLogLevel::Debug, EM_TimeUnit::Microseconds, "Direct sample format converter initialized");
+        return true;
+    }
+
+    if (m_config.m_backend == EM_ResamplerBackend::Polyphase && InitializePolyphase(params))
+    {
+        TimeSystem::Instance().StopTimingWithLog("ResamplerContextInit", EM_TimingLogLevel::Debug, EM_TimeUnit::Microseconds, "Polyphase resampler initialized");
+        return true;
+    }
+
     // 如果上下文已存在且需要重新初始化，则创建新的上下文
     if (m_swrCtx.GetRawContext() && needReinit)
     {
@@ -271,6 +430,13 @@ bool AudioResampler::InitializeResampler(ST_ResampleParams& params)
         av_opt_set_int(m_swrCtx.GetRawContext(), "out_sample_rate", params.GetOutput().GetSampleRate(), 0);
         av_opt_set_sample_fmt(m_swrCtx.GetRawContext(), "out_sample_fmt", params.GetOutput().GetSampleFormat().sampleFormat, 0);
 
+        // 滤波器参数与多相后端使用同一质量预设，均衡预设即swr默认值
+        const ST_ResampleFilterParams filterParams = PolyphaseResampler::GetFilterParams(m_config.m_quality);
+        av_opt_set_int(m_swrCtx.GetRawContext(), "filter_type", SWR_FILTER_TYPE_KAISER, 0);
+        av_opt_set_int(m_swrCtx.GetRawContext(), "filter_size", filterParams.m_filterSize, 0);
+        av_opt_set_double(m_swrCtx.GetRawContext(), "cutoff", filterParams.m_cutoff, 0);
+        av_opt_set_double(m_swrCtx.GetRawContext(), "kaiser_beta", filterParams.m_kaiserBeta, 0);
+
         // 初始化重采样上下文
         if (m_swrCtx.SwrContextInit() < 0)
         {
@@ -292,3 +458,163 @@ bool AudioResampler::InitializeResampler(ST_ResampleParams& params)
     TimeSystem::Instance().StopTimingWithLog("ResamplerContextInit", EM_TimingLogLevel::Debug, EM_TimeUnit::Microseconds, "Resampler context initialized");
     return true;
 }
+
+bool AudioResampler::InitializeDirectConvert(ST_ResampleParams& params)
+{
+    m_bDirectConvert = false;
+    if (!m_bDirectConvertEnabled)
+    {
+        return false;
+    }
+
+    // 采样率不变且声道布局一致，才可以只做格式转换
+    if (params.GetInput().GetSampleRate() != params.GetOutput().GetSampleRate() || !IsSameChannelLayout(params))
+    {
+        return false;
+    }
+
+    const AVSampleFormat inFormat = params.GetInput().GetSampleFormat().sampleFormat;
+    const AVSampleFormat outFormat = params.GetOutput().GetSampleFormat().sampleFormat;
+    if (!m_directConverter.Init(inFormat, outFormat, params.GetOutput().GetChannels()))
+    {
+        return false;
+    }
+
+    m_bDirectConvert = true;
+    SaveLastParams(params);
+    LOG_INFO(std::string("Resampler using direct sample format conversion (") + av_get_sample_fmt_name(inFormat) + " -> " + av_get_sample_fmt_name(outFormat) + ", "
+             + AudioSampleConverter::GetSimdLevelName() + (m_directConverter.IsCopyOnly() ? ", copy only)" : ")"));
+    return true;
+}
+
+bool AudioResampler::IsSameChannelLayout(ST_ResampleParams& params)
+{
+    // 声道数相同且（多声道时）声道顺序一致
+    const AVChannelLayout* inLayout = params.GetInput().GetChannelLayout().GetRawLayout();
+    const AVChannelLayout* outLayout = params.GetOutput().GetChannelLayout().GetRawLayout();
+    return inLayout && outLayout && inLayout->nb_channels == outLayout->nb_channels && (outLayout->nb_channels <= 2 || av_channel_layout_compare(inLayout, outLayout) == 0);
+}
+
+bool AudioResampler::InitializePolyphase(ST_ResampleParams& params)
+{
+    m_polyphase.reset();
+    if (!IsSameChannelLayout(params))
+    {
+        LOG_INFO("Polyphase resampler does not remix channels, falling back to swr");
+        return false;
+    }
+
+    auto polyphase = std::make_unique<PolyphaseResampler>();
+    if (!polyphase->Init(params.GetInput().GetSampleRate(), params.GetOutput().GetSampleRate(), params.GetInput().GetSampleFormat().sampleFormat, params.GetOutput().GetSampleFormat().sampleFormat,
+                         params.GetOutput().GetChannels(), m_config.m_quality))
+    {
+        LOG_INFO("Polyphase resampler does not support this conversion, falling back to swr");
+        return false;
+    }
+
+    m_polyphase = std::move(polyphase);
+    SaveLastParams(params);
+    return true;
+}
+
+void AudioResampler::SaveLastParams(ST_ResampleParams& params)
+{
+    m_lastInRate = params.GetInput().GetSampleRate();
+    m_lastOutRate = params.GetOutput().GetSampleRate();
+    m_lastInFmt = params.GetInput().GetSampleFormat();
+    m_lastOutFmt = params.GetOutput().GetSampleFormat();
+    m_lastInLayout = params.GetInput().GetChannelLayout();
+    m_lastOutLayout = params.GetOutput().GetChannelLayout();
+}
+
+void AudioResampler::SetDefaultConfig(EM_ResampleUsage usage, const ST_ResamplerConfig& config)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_defaultConfigMutex);
+        s_defaultConfigs[static_cast<int>(usage)] = config;
+    }
+    if (config.m_backend == EM_ResamplerBackend::Polyphase)
+    {
+        PolyphaseResampler::PrecomputeCommonTables(config.m_quality);
+    }
+    LOG_INFO("Default resampler config for usage " + std::to_string(static_cast<int>(usage)) + ": backend=" + (config.m_backend == EM_ResamplerBackend::Polyphase ? "polyphase" : "swr")
+             + ", quality=" + std::to_string(static_cast<int>(config.m_quality)));
+}
+
+ST_ResamplerConfig AudioResampler::GetDefaultConfig(EM_ResampleUsage usage)
+{
+    std::lock_guard<std::mutex> lock(s_defaultConfigMutex);
+    return s_defaultConfigs[static_cast<int>(usage)];
+}
+
+void AudioResampler::BenchmarkBackends(int seconds)
+{
+    struct ST_RateCase
+    {
+        int m_inRate;
+        int m_outRate;
+    };
+    const ST_RateCase rateCases[] = {{44100, 48000}, {48000, 44100}, {48000, 96000}, {96000, 48000}, {44100, 88200}, {88200, 44100}};
+    const EM_ResampleQuality qualities[] = {EM_ResampleQuality::LowPower, EM_ResampleQuality::Balanced, EM_ResampleQuality::High};
+    const EM_ResamplerBackend backends[] = {EM_ResamplerBackend::Swr, EM_ResamplerBackend::Polyphase};
+    const double toneFrequencies[] = {1000.0, 10000.0};
+    const int channels = 2;
+    const int chunkSamples = 1024;
+    const double pi = 3.14159265358979323846;
+
+    for (const ST_RateCase& rateCase : rateCases)
+    {
+        for (double toneHz : toneFrequencies)
+        {
+            // -6 dBFS正弦，两个声道相同
+            const size_t inputSamples = static_cast<size_t>(std::max(seconds, 1)) * rateCase.m_inRate;
+            std::vector<float> input(inputSamples * channels);
+            for (size_t i = 0; i < inputSamples; ++i)
+            {
+                const auto value = static_cast<float>(0.5 * std::sin(2.0 * pi * toneHz * i / rateCase.m_inRate));
+                input[i * channels] = value;
+                input[i * channels + 1] = value;
+            }
+
+            for (EM_ResampleQuality quality : qualities)
+            {
+                for (EM_ResamplerBackend backend : backends)
+                {
+                    AudioResampler resampler;
+                    resampler.SetConfig(ST_ResamplerConfig{backend, quality});
+                    ST_ResampleParams params = MakeBenchmarkParams(rateCase.m_inRate, rateCase.m_outRate);
+                    std::vector<float> output;
+                    output.reserve((inputSamples * rateCase.m_outRate / rateCase.m_inRate + chunkSamples) * channels);
+
+                    using Clock = std::chrono::steady_clock;
+                    auto start = Clock::now();
+                    for (size_t offset = 0; offset < inputSamples; offset += chunkSamples)
+                    {
+                        const int samples = static_cast<int>(std::min(inputSamples - offset, static_cast<size_t>(chunkSamples)));
+                        const uint8_t* inputPtr = reinterpret_cast<const uint8_t*>(input.data() + offset * channels);
+                        const int maxSamples = resampler.GetMaxOutputSamples(samples, params);
+                        const size_t outOffset = output.size();
+                        output.resize(outOffset + static_cast<size_t>(std::max(maxSamples, 0)) * channels);
+                        const int produced = resampler.ResampleInto(&inputPtr, samples, reinterpret_cast<uint8_t*>(output.data() + outOffset), maxSamples, params);
+                        output.resize(outOffset + static_cast<size_t>(std::max(produced, 0)) * channels);
+                    }
+                    const int flushSamples = resampler.GetMaxOutputSamples(0, params);
+                    if (flushSamples > 0)
+                    {
+                        const size_t outOffset = output.size();
+                        output.resize(outOffset + static_cast<size_t>(flushSamples) * channels);
+                        const int produced = resampler.FlushInto(reinterpret_cast<uint8_t*>(output.data() + outOffset), flushSamples);
+                        output.resize(outOffset + static_cast<size_t>(std::max(produced, 0)) * channels);
+                    }
+                    double elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+                    const bool bPolyphase = resampler.m_polyphase != nullptr;
+                    const double realtimeFactor = elapsedSeconds > 0.0 ? static_cast<double>(inputSamples) / rateCase.m_inRate / elapsedSeconds : 0.0;
+                    LOG_INFO("Resampler benchmark [" + std::string(bPolyphase ? "polyphase" : "swr") + ", quality " + std::to_string(static_cast<int>(quality)) + "] " + std::to_string(rateCase.m_inRate) + "->"
+                             + std::to_string(rateCase.m_outRate) + " Hz, " + std::to_string(static_cast<int>(toneHz)) + " Hz tone: " + std::to_string(realtimeFactor) + "x realtime, THD+N "
+                             + std::to_string(MeasureThdN(output, channels, rateCase.m_outRate, toneHz)) + " dB");
+                }
+            }
+        }
+    }
+}
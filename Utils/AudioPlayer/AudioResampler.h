@@ -1,6 +1,9 @@
 ﻿#pragma once
 #include <cstdint>
+#include <memory>
 #include <QDebug>
+#include "AudioSampleConverter.h"
+#include "PolyphaseResampler.h"
 #include "BaseDataDefine/ST_SwrContext.h"
 #include "DataDefine/ST_ResampleParams.h"
 #include "DataDefine/ST_ResampleResult.h"
@@ -18,16 +21,45 @@ extern "C"
 #include <libavutil/opt.h>
 }
 
+/// <summary>
+/// 重采样后端
+/// </summary>
+enum class EM_ResamplerBackend
+{
+    Swr,      /// FFmpeg libswresample
+    Polyphase /// 内置SIMD多相重采样器（比例或格式不支持时回退到swr）
+};
+
+/// <summary>
+/// 重采样用途，不同用途可使用不同的后端和质量预设
+/// </summary>
+enum class EM_ResampleUsage
+{
+    Playback, /// 实时播放
+    Offline   /// 离线处理（预解码缓存、导出等）
+};
+
+/// <summary>
+/// 重采样器配置
+/// </summary>
+struct ST_ResamplerConfig
+{
+    EM_ResamplerBackend m_backend{EM_ResamplerBackend::Swr};   /// 后端
+    EM_ResampleQuality m_quality{EM_ResampleQuality::Balanced}; /// 质量预设，swr后端同样生效
+};
+
 /// <summary>
 /// 音频重采样器类（支持连续重采样）
+/// 采样率和声道布局不变时只做格式转换或拷贝，不创建SwrContext
 /// </summary>
 class AudioResampler
 {
 public:
     /// <summary>
-    /// 构造函数
+    /// 构造函数，使用该用途的默认配置
     /// </summary>
-    AudioResampler();
+    /// <param name="usage">重采样用途</param>
+    explicit AudioResampler(EM_ResampleUsage usage = EM_ResampleUsage::Playback);
 
     /// <summary>
     /// 析构函数
@@ -43,6 +75,33 @@ public:
     /// <param name="params">重采样参数</param>
     void Resample(const uint8_t** inputData, int inputSamples, ST_ResampleResult& output, ST_ResampleParams& params);
 
+    /// <summary>
+    /// 获取输入指定样本数时输出样本数的上限，用于确定ResampleInto所需的输出空间
+    /// </summary>
+    /// <param name="inputSamples">输入样本数，0表示刷新</param>
+    /// <param name="params">重采样参数</param>
+    /// <returns>输出样本数上限，失败返回负值</returns>
+    int GetMaxOutputSamples(int inputSamples, ST_ResampleParams& params);
+
+    /// <summary>
+    /// 重采样并直接写入调用方提供的交错输出空间，不分配内存、不做额外拷贝
+    /// </summary>
+    /// <param name="inputData">输入数据</param>
+    /// <param name="inputSamples">输入样本数</param>
+    /// <param name="output">输出空间</param>
+    /// <param name="maxOutputSamples">输出空间可容纳的样本数</param>
+    /// <param name="params">重采样参数</param>
+    /// <returns>实际输出的样本数，失败返回负值</returns>
+    int ResampleInto(const uint8_t** inputData, int inputSamples, uint8_t* output, int maxOutputSamples, ST_ResampleParams& params);
+
+    /// <summary>
+    /// 取出重采样器中的剩余数据，直接写入调用方提供的输出空间
+    /// </summary>
+    /// <param name="output">输出空间</param>
+    /// <param name="maxOutputSamples">输出空间可容纳的样本数</param>
+    /// <returns>实际输出的样本数，失败返回负值</returns>
+    int FlushInto(uint8_t* output, int maxOutputSamples);
+
     /// <summary>
     /// 刷新重采样器（获取剩余数据）
     /// </summary>
@@ -50,6 +109,11 @@ public:
     /// <param name="params">重采样参数</param>
     void Flush(ST_ResampleResult& output, ST_ResampleParams& params);
 
+    /// <summary>
+    /// 重置重采样器（seek后调用，丢弃内部残留样本）
+    /// </summary>
+    void Reset();
+
     /// <summary>
     /// 根据音频格式获取重采样参数
     /// </summary>
@@ -63,7 +127,93 @@ public:
     /// <returns>默认输出参数</returns>
     ST_ResampleSimpleData GetDefaultOutputParams() const;
 
+    /// <summary>
+    /// 是否允许在只需格式转换时绕过swr（用于对比测试，默认允许）
+    /// </summary>
+    /// <param name="bEnabled">是否允许</param>
+    void SetDirectConvertEnabled(bool bEnabled)
+    {
+        m_bDirectConvertEnabled = bEnabled;
+    }
+
+    /// <summary>
+    /// 设置本实例的后端和质量预设，在下一次初始化时生效
+    /// </summary>
+    /// <param name="config">重采样器配置</param>
+    void SetConfig(const ST_ResamplerConfig& config)
+    {
+        m_config = config;
+    }
+
+    /// <summary>
+    /// 获取本实例的配置
+    /// </summary>
+    const ST_ResamplerConfig& GetConfig() const
+    {
+        return m_config;
+    }
+
+    /// <summary>
+    /// 设置指定用途的默认配置，之后创建的重采样器使用该配置；选择多相后端时预先计算常用比例的系数表
+    /// </summary>
+    /// <param name="usage">重采样用途</param>
+    /// <param name="config">重采样器配置</param>
+    static void SetDefaultConfig(EM_ResampleUsage usage, const ST_ResamplerConfig& config);
+
+    /// <summary>
+    /// 获取指定用途的默认配置
+    /// </summary>
+    /// <param name="usage">重采样用途</param>
+    static ST_ResamplerConfig GetDefaultConfig(EM_ResampleUsage usage);
+
+    /// <summary>
+    /// 后端基准测试：在常用比例和各质量预设下分别用swr和多相后端重采样正弦信号，
+    /// 统计吞吐量（实时倍数）和THD+N并写入日志
+    /// </summary>
+    /// <param name="seconds">每项测试的信号时长（秒）</param>
+    static void BenchmarkBackends(int seconds = 20);
+
+    /// <summary>
+    /// 当前是否使用格式转换快速路径
+    /// </summary>
+    bool IsDirectConvert() const
+    {
+        return m_bDirectConvert;
+    }
+
 private:
+    /// <summary>
+    /// 是否已初始化（快速路径或SwrContext）
+    /// </summary>
+    bool IsInitialized() const
+    {
+        return m_bDirectConvert || m_polyphase || m_swrCtx.GetRawContext();
+    }
+
+    /// <summary>
+    /// 输入输出声道布局是否一致（快速路径和多相后端不做声道混合）
+    /// </summary>
+    static bool IsSameChannelLayout(ST_ResampleParams& params);
+
+    /// <summary>
+    /// 配置为多相后端时初始化多相重采样器
+    /// </summary>
+    /// <param name="params">重采样参数</param>
+    /// <returns>可以使用多相后端返回true</returns>
+    bool InitializePolyphase(ST_ResampleParams& params);
+
+    /// <summary>
+    /// 保存当前参数
+    /// </summary>
+    void SaveLastParams(ST_ResampleParams& params);
+
+    /// <summary>
+    /// 采样率和声道布局一致时初始化格式转换快速路径
+    /// </summary>
+    /// <param name="params">重采样参数</param>
+    /// <returns>可以使用快速路径返回true</returns>
+    bool InitializeDirectConvert(ST_ResampleParams& params);
+
     /// <summary>
     /// 初始化重采样上下文
     /// </summary>
@@ -79,4 +229,9 @@ private:
     int m_lastOutRate{0};               /// 上次输出采样率
     ST_AVSampleFormat m_lastInFmt;      /// 上次输入格式
     ST_AVSampleFormat m_lastOutFmt;     /// 上次输出格式
+    AudioSampleConverter m_directConverter; /// 格式转换快速路径
+    bool m_bDirectConvert{false};       /// 是否使用格式转换快速路径
+    bool m_bDirectConvertEnabled{true}; /// 是否允许使用格式转换快速路径
+    ST_ResamplerConfig m_config;        /// 后端和质量预设
+    std::unique_ptr<PolyphaseResampler> m_polyphase; /// 多相重采样器，为空表示未使用多相后端
 };
@@ -0,0 +1,601 @@
+#include "AudioSampleConverter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "AudioSimd.h"
+#include "BaseDataDefine/ST_SwrContext.h"
+#include "LogSystem/LogSystem.h"
+
+extern "C"
+{
+#include <libavutil/channel_layout.h>
+#include <libswresample/swresample.h>
+}
+
+namespace
+{
+// 换算系数与swr的默认转换一致：整数→浮点按满幅缩放，浮点→整数四舍五入到偶数并饱和
+const float S16_SCALE = 32768.0f;
+const float S16_TO_FLT_SCALE = 1.0f / 32768.0f;
+const float S32_TO_FLT_SCALE = 1.0f / 2147483648.0f;
+
+inline int16_t FloatToS16(float value)
+{
+    const float scaled = std::min(std::max(value * S16_SCALE, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(lrintf(scaled));
+}
+
+// ---------------- 标量实现 ----------------
+
+void FltToS16Scalar(const float* in, int16_t* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = FloatToS16(in[i]);
+    }
+}
+
+void S32ToS16Scalar(const int32_t* in, int16_t* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = static_cast<int16_t>(in[i] >> 16);
+    }
+}
+
+void S16ToFltScalar(const int16_t* in, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = in[i] * S16_TO_FLT_SCALE;
+    }
+}
+
+void S32ToFltScalar(const int32_t* in, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = in[i] * S32_TO_FLT_SCALE;
+    }
+}
+
+void DblToFltScalar(const double* in, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
+
+void S16ToS32Scalar(const int16_t* in, int32_t* out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = static_cast<int32_t>(static_cast<uint32_t>(in[i]) << 16);
+    }
+}
+
+template <typename T>
+void InterleaveScalar(const uint8_t* const* planes, int channels, size_t samples, uint8_t* output)
+{
+    T* out = reinterpret_cast<T*>(output);
+    for (size_t i = 0; i < samples; ++i)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            *out++ = reinterpret_cast<const T*>(planes[ch])[i];
+        }
+    }
+}
+
+#if AUDIO_X86_SIMD
+// ---------------- SSE2实现 ----------------
+
+void FltToS16Sse2(const float* in, int16_t* out, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    const __m128 minValue = _mm_set1_ps(-32768.0f);
+    const __m128 maxValue = _mm_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // cvtps2dq对超出int32范围的值返回0x80000000，先限幅再转换，packs负责饱和到int16
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), minValue), maxValue);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale), minValue), maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+    }
+    FltToS16Scalar(in + i, out + i, count - i);
+}
+
+void S32ToS16Sse2(const int32_t* in, int16_t* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i a = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), 16);
+        __m128i b = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4)), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+    }
+    S32ToS16Scalar(in + i, out + i, count - i);
+}
+
+void S16ToFltSse2(const int16_t* in, float* out, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(S16_TO_FLT_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // 与自身交错后算术右移16位完成符号扩展
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    S16ToFltScalar(in + i, out + i, count - i);
+}
+
+void S32ToFltSse2(const int32_t* in, float* out, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(S32_TO_FLT_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+    }
+    S32ToFltScalar(in + i, out + i, count - i);
+}
+
+void DblToFltSse2(const double* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+        __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+        _mm_storeu_ps(out + i, _mm_movelh_ps(a, b));
+    }
+    DblToFltScalar(in + i, out + i, count - i);
+}
+
+void S16ToS32Sse2(const int16_t* in, int32_t* out, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // 低16位补零即左移16位
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(zero, value));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(zero, value));
+    }
+    S16ToS32Scalar(in + i, out + i, count - i);
+}
+
+template <typename T>
+void InterleaveStereoSse2(const T* left, const T* right, T* out, size_t samples)
+{
+    const size_t step = 16 / sizeof(T);
+    size_t i = 0;
+    for (; i + step <= samples; i += step)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+        __m128i lo;
+        __m128i hi;
+        if constexpr (sizeof(T) == 2)
+        {
+            lo = _mm_unpacklo_epi16(l, r);
+            hi = _mm_unpackhi_epi16(l, r);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            lo = _mm_unpacklo_epi32(l, r);
+            hi = _mm_unpackhi_epi32(l, r);
+        }
+        else
+        {
+            lo = _mm_unpacklo_epi64(l, r);
+            hi = _mm_unpackhi_epi64(l, r);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + step), hi);
+    }
+    for (; i < samples; ++i)
+    {
+        out[2 * i] = left[i];
+        out[2 * i + 1] = right[i];
+    }
+}
+
+// ---------------- AVX2实现 ----------------
+
+AUDIO_TARGET_AVX2 void FltToS16Avx2(const float* in, int16_t* out, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(S16_SCALE);
+    const __m256 minValue = _mm256_set1_ps(-32768.0f);
+    const __m256 maxValue = _mm256_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), minValue), maxValue);
+        __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale), minValue), maxValue);
+        // packs按128位通道分别打包，重排64位块恢复顺序
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    FltToS16Scalar(in + i, out + i, count - i);
+}
+
+AUDIO_TARGET_AVX2 void S32ToS16Avx2(const int32_t* in, int16_t* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i a = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), 16);
+        __m256i b = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 8)), 16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8));
+    }
+    S32ToS16Scalar(in + i, out + i, count - i);
+}
+
+AUDIO_TARGET_AVX2 void S16ToFltAvx2(const int16_t* in, float* out, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(S16_TO_FLT_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+    S16ToFltScalar(in + i, out + i, count - i);
+}
+
+AUDIO_TARGET_AVX2 void S32ToFltAvx2(const int32_t* in, float* out, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(S32_TO_FLT_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 8));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), scale));
+    }
+    S32ToFltScalar(in + i, out + i, count - i);
+}
+
+AUDIO_TARGET_AVX2 void DblToFltAvx2(const double* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+        _mm_storeu_ps(out + i + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i + 4)));
+    }
+    DblToFltScalar(in + i, out + i, count - i);
+}
+
+AUDIO_TARGET_AVX2 void S16ToS32Avx2(const int16_t* in, int32_t* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(lo, 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8), _mm256_slli_epi32(hi, 16));
+    }
+    S16ToS32Scalar(in + i, out + i, count - i);
+}
+#endif
+
+template <typename T>
+void InterleavePlanes(const uint8_t* const* planes, int channels, size_t samples, uint8_t* output)
+{
+#if AUDIO_X86_SIMD
+    // 立体声是最常见的平面格式，SSE2解包一次交错一个寄存器宽度
+    if constexpr (sizeof(T) > 1)
+    {
+        if (channels == 2)
+        {
+            InterleaveStereoSse2(reinterpret_cast<const T*>(planes[0]), reinterpret_cast<const T*>(planes[1]), reinterpret_cast<T*>(output), samples);
+            return;
+        }
+    }
+#endif
+    InterleaveScalar<T>(planes, channels, samples, output);
+}
+
+/// <summary>
+/// 将按样本类型实现的转换函数适配为按字节指针调用的转换核心
+/// </summary>
+template <typename TIn, typename TOut, void (*Func)(const TIn*, TOut*, size_t)>
+void KernelAdapter(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    Func(reinterpret_cast<const TIn*>(src), reinterpret_cast<TOut*>(dst), count);
+}
+
+#if AUDIO_X86_SIMD
+#define AUDIO_CONVERT_SIMD_KERNELS(TIn, TOut, Name) &KernelAdapter<TIn, TOut, &Name##Sse2>, &KernelAdapter<TIn, TOut, &Name##Avx2>
+#else
+#define AUDIO_CONVERT_SIMD_KERNELS(TIn, TOut, Name) nullptr, nullptr
+#endif
+
+struct ST_ConvertKernelEntry
+{
+    AVSampleFormat m_inFormat;                      /// 输入格式（交错）
+    AVSampleFormat m_outFormat;                     /// 输出格式（交错）
+    AudioSampleConverter::ConvertKernel m_scalar;   /// 标量实现
+    AudioSampleConverter::ConvertKernel m_sse2;     /// SSE2实现
+    AudioSampleConverter::ConvertKernel m_avx2;     /// AVX2实现
+};
+
+const ST_ConvertKernelEntry CONVERT_KERNELS[] = {
+    {AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_S16, &KernelAdapter<float, int16_t, &FltToS16Scalar>, AUDIO_CONVERT_SIMD_KERNELS(float, int16_t, FltToS16)},
+    {AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_S16, &KernelAdapter<int32_t, int16_t, &S32ToS16Scalar>, AUDIO_CONVERT_SIMD_KERNELS(int32_t, int16_t, S32ToS16)},
+    {AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_FLT, &KernelAdapter<int16_t, float, &S16ToFltScalar>, AUDIO_CONVERT_SIMD_KERNELS(int16_t, float, S16ToFlt)},
+    {AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_FLT, &KernelAdapter<int32_t, float, &S32ToFltScalar>, AUDIO_CONVERT_SIMD_KERNELS(int32_t, float, S32ToFlt)},
+    {AV_SAMPLE_FMT_DBL, AV_SAMPLE_FMT_FLT, &KernelAdapter<double, float, &DblToFltScalar>, AUDIO_CONVERT_SIMD_KERNELS(double, float, DblToFlt)},
+    {AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_S32, &KernelAdapter<int16_t, int32_t, &S16ToS32Scalar>, AUDIO_CONVERT_SIMD_KERNELS(int16_t, int32_t, S16ToS32)},
+};
+
+AudioSampleConverter::ConvertKernel SelectKernel(AVSampleFormat inFormat, AVSampleFormat outFormat)
+{
+    for (const ST_ConvertKernelEntry& entry : CONVERT_KERNELS)
+    {
+        if (entry.m_inFormat != inFormat || entry.m_outFormat != outFormat)
+        {
+            continue;
+        }
+
+        switch (GetAudioSimdLevel())
+        {
+            case EM_SimdLevel::Avx2:
+                return entry.m_avx2 ? entry.m_avx2 : entry.m_scalar;
+            case EM_SimdLevel::Sse2:
+                return entry.m_sse2 ? entry.m_sse2 : entry.m_scalar;
+            default:
+                return entry.m_scalar;
+        }
+    }
+    return nullptr;
+}
+
+/// <summary>
+/// 按交错格式写入一个合成样本
+/// </summary>
+void WriteSyntheticSample(uint8_t* dst, AVSampleFormat packedFormat, double value)
+{
+    switch (packedFormat)
+    {
+        case AV_SAMPLE_FMT_S16:
+        {
+            const auto sample = static_cast<int16_t>(std::max(std::min(value * 32768.0, 32767.0), -32768.0));
+            memcpy(dst, &sample, sizeof(sample));
+            break;
+        }
+        case AV_SAMPLE_FMT_S32:
+        {
+            const auto sample = static_cast<int32_t>(std::max(std::min(value * 2147483648.0, 2147483647.0), -2147483648.0));
+            memcpy(dst, &sample, sizeof(sample));
+            break;
+        }
+        case AV_SAMPLE_FMT_FLT:
+        {
+            const auto sample = static_cast<float>(value);
+            memcpy(dst, &sample, sizeof(sample));
+            break;
+        }
+        case AV_SAMPLE_FMT_DBL:
+            memcpy(dst, &value, sizeof(value));
+            break;
+        default:
+            break;
+    }
+}
+} // namespace
+
+bool AudioSampleConverter::Init(AVSampleFormat inFormat, AVSampleFormat outFormat, int channels)
+{
+    m_kernel = nullptr;
+    if (channels <= 0 || channels > MAX_CHANNELS || outFormat == AV_SAMPLE_FMT_NONE || av_sample_fmt_is_planar(outFormat))
+    {
+        return false;
+    }
+
+    const AVSampleFormat packedInFormat = av_get_packed_sample_fmt(inFormat);
+    if (packedInFormat != outFormat)
+    {
+        m_kernel = SelectKernel(packedInFormat, outFormat);
+        if (!m_kernel)
+        {
+            return false;
+        }
+    }
+
+    m_channels = channels;
+    m_bPlanar = av_sample_fmt_is_planar(inFormat) != 0;
+    m_inSampleBytes = static_cast<size_t>(av_get_bytes_per_sample(inFormat));
+    m_outSampleBytes = static_cast<size_t>(av_get_bytes_per_sample(outFormat));
+    return true;
+}
+
+void AudioSampleConverter::Convert(const uint8_t* const* inputData, int samples, uint8_t* output) const
+{
+    if (samples <= 0)
+    {
+        return;
+    }
+
+    const size_t count = static_cast<size_t>(samples);
+    if (!m_bPlanar || m_channels == 1)
+    {
+        // 交错输入与输出布局相同，整段连续转换
+        const size_t values = count * m_channels;
+        if (m_kernel)
+        {
+            m_kernel(inputData[0], output, values);
+        }
+        else
+        {
+            memcpy(output, inputData[0], values * m_inSampleBytes);
+        }
+        return;
+    }
+
+    if (!m_kernel)
+    {
+        Interleave(inputData, count, output);
+        return;
+    }
+
+    // 平面输入且需要转换：逐块将各声道转换到块缓冲区后交错，块缓冲区常驻L1缓存
+    uint8_t block[MAX_CHANNELS][BLOCK_SAMPLES * MAX_OUT_SAMPLE_BYTES];
+    const uint8_t* planes[MAX_CHANNELS];
+    const size_t frameBytes = m_outSampleBytes * m_channels;
+    const size_t blockSize = BLOCK_SAMPLES;
+    for (size_t offset = 0; offset < count; offset += blockSize)
+    {
+        const size_t blockSamples = std::min(count - offset, blockSize);
+        for (int ch = 0; ch < m_channels; ++ch)
+        {
+            m_kernel(inputData[ch] + offset * m_inSampleBytes, block[ch], blockSamples);
+            planes[ch] = block[ch];
+        }
+        Interleave(planes, blockSamples, output + offset * frameBytes);
+    }
+}
+
+void AudioSampleConverter::Interleave(const uint8_t* const* planes, size_t samples, uint8_t* output) const
+{
+    switch (m_outSampleBytes)
+    {
+        case 1:
+            InterleavePlanes<uint8_t>(planes, m_channels, samples, output);
+            break;
+        case 2:
+            InterleavePlanes<int16_t>(planes, m_channels, samples, output);
+            break;
+        case 4:
+            InterleavePlanes<int32_t>(planes, m_channels, samples, output);
+            break;
+        case 8:
+            InterleavePlanes<int64_t>(planes, m_channels, samples, output);
+            break;
+        default:
+            break;
+    }
+}
+
+const char* AudioSampleConverter::GetSimdLevelName()
+{
+    return GetAudioSimdLevelName(GetAudioSimdLevel());
+}
+
+bool AudioSampleConverter::Benchmark(int seconds)
+{
+    struct ST_BenchmarkCase
+    {
+        AVSampleFormat m_inFormat;
+        AVSampleFormat m_outFormat;
+    };
+    const ST_BenchmarkCase benchmarkCases[] = {{AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16}, {AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_S16}, {AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_S16}, {AV_SAMPLE_FMT_S32P, AV_SAMPLE_FMT_S16},
+                                               {AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_S16}, {AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_FLT}, {AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_FLT}, {AV_SAMPLE_FMT_DBLP, AV_SAMPLE_FMT_FLT},
+                                               {AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_S32}, {AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_FLT}};
+    const int sampleRate = 48000;
+    const int channels = 2;
+    const int chunkSamples = 1024; // 与常见编码器的帧长相当，模拟逐帧转换
+    const double pi = 3.14159265358979323846;
+    const size_t totalSamples = static_cast<size_t>(std::max(seconds, 1)) * sampleRate;
+
+    AVChannelLayout layout;
+    av_channel_layout_default(&layout, channels);
+
+    bool bAllIdentical = true;
+    for (const ST_BenchmarkCase& benchmarkCase : benchmarkCases)
+    {
+        const std::string caseName = std::string(av_get_sample_fmt_name(benchmarkCase.m_inFormat)) + "->" + av_get_sample_fmt_name(benchmarkCase.m_outFormat);
+        AudioSampleConverter converter;
+        SwrContext* rawSwr = nullptr;
+        if (!converter.Init(benchmarkCase.m_inFormat, benchmarkCase.m_outFormat, channels)
+            || swr_alloc_set_opts2(&rawSwr, &layout, benchmarkCase.m_outFormat, sampleRate, &layout, benchmarkCase.m_inFormat, sampleRate, 0, nullptr) < 0)
+        {
+            LOG_WARN("AudioSampleConverter::Benchmark() : Unsupported case " + caseName);
+            bAllIdentical = false;
+            continue;
+        }
+        ST_SwrContext swrCtx;
+        swrCtx.SetRawContext(rawSwr);
+        if (swrCtx.SwrContextInit() < 0)
+        {
+            LOG_WARN("AudioSampleConverter::Benchmark() : Failed to init swr for " + caseName);
+            bAllIdentical = false;
+            continue;
+        }
+
+        // 合成信号：频率扫描的正弦叠加少量超出满幅的峰值，覆盖饱和路径
+        const bool bPlanar = av_sample_fmt_is_planar(benchmarkCase.m_inFormat) != 0;
+        const AVSampleFormat packedInFormat = av_get_packed_sample_fmt(benchmarkCase.m_inFormat);
+        const size_t inSampleBytes = static_cast<size_t>(av_get_bytes_per_sample(benchmarkCase.m_inFormat));
+        const int planeCount = bPlanar ? channels : 1;
+        std::vector<std::vector<uint8_t>> inputPlanes(planeCount, std::vector<uint8_t>(totalSamples * inSampleBytes * channels / planeCount));
+        for (size_t i = 0; i < totalSamples; ++i)
+        {
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                const double t = static_cast<double>(i) / sampleRate;
+                const double value = 1.1 * std::sin(2.0 * pi * (220.0 + 40.0 * t) * t + ch);
+                uint8_t* dst = bPlanar ? inputPlanes[ch].data() + i * inSampleBytes : inputPlanes[0].data() + (i * channels + ch) * inSampleBytes;
+                WriteSyntheticSample(dst, packedInFormat, value);
+            }
+        }
+
+        const size_t outFrameBytes = static_cast<size_t>(av_get_bytes_per_sample(benchmarkCase.m_outFormat)) * channels;
+        std::vector<uint8_t> directOutput(totalSamples * outFrameBytes);
+        std::vector<uint8_t> swrOutput(totalSamples * outFrameBytes);
+        const uint8_t* inputPtrs[MAX_CHANNELS] = {nullptr};
+
+        using Clock = std::chrono::steady_clock;
+        auto directStart = Clock::now();
+        for (size_t offset = 0; offset < totalSamples; offset += chunkSamples)
+        {
+            const int samples = static_cast<int>(std::min(totalSamples - offset, static_cast<size_t>(chunkSamples)));
+            for (int plane = 0; plane < planeCount; ++plane)
+            {
+                inputPtrs[plane] = inputPlanes[plane].data() + offset * inSampleBytes * channels / planeCount;
+            }
+            converter.Convert(inputPtrs, samples, directOutput.data() + offset * outFrameBytes);
+        }
+        double directMs = std::chrono::duration<double, std::milli>(Clock::now() - directStart).count();
+
+        auto swrStart = Clock::now();
+        for (size_t offset = 0; offset < totalSamples; offset += chunkSamples)
+        {
+            const int samples = static_cast<int>(std::min(totalSamples - offset, static_cast<size_t>(chunkSamples)));
+            for (int plane = 0; plane < planeCount; ++plane)
+            {
+                inputPtrs[plane] = inputPlanes[plane].data() + offset * inSampleBytes * channels / planeCount;
+            }
+            uint8_t* outPtr = swrOutput.data() + offset * outFrameBytes;
+            swrCtx.SwrConvert(&outPtr, samples, inputPtrs, samples);
+        }
+        double swrMs = std::chrono::duration<double, std::milli>(Clock::now() - swrStart).count();
+
+        const bool bIdentical = memcmp(directOutput.data(), swrOutput.data(), directOutput.size()) == 0;
+        bAllIdentical = bAllIdentical && bIdentical;
+        LOG_INFO("Sample convert benchmark [" + caseName + ", " + GetSimdLevelName() + "] " + std::to_string(seconds) + " s stereo: direct " + std::to_string(directMs) + " ms, swr " + std::to_string(swrMs) + " ms, speedup "
+                 + std::to_string(directMs > 0.0 ? swrMs / directMs : 0.0) + "x, output " + (bIdentical ? "identical" : "MISMATCH"));
+    }
+    av_channel_layout_uninit(&layout);
+    return bAllIdentical;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C"
+{
+#include <libavutil/samplefmt.h>
+}
+
+/// <summary>
+/// 采样率和声道布局不变时的采样格式转换器
+/// 只做格式转换（如FLTP→S16、S32→S16、S16P→S16）或直接拷贝，不经过SwrContext；
+/// 转换核心按CPU支持情况选择AVX2、SSE2或标量实现，结果与swr的默认转换（无抖动）一致
+/// </summary>
+class AudioSampleConverter
+{
+public:
+    AudioSampleConverter() = default;
+
+    /// <summary>
+    /// 按输入输出格式选择转换核心
+    /// </summary>
+    /// <param name="inFormat">输入采样格式（交错或平面）</param>
+    /// <param name="outFormat">输出采样格式（必须为交错格式）</param>
+    /// <param name="channels">声道数</param>
+    /// <returns>支持该组合返回true，否则需要使用swr</returns>
+    bool Init(AVSampleFormat inFormat, AVSampleFormat outFormat, int channels);
+
+    /// <summary>
+    /// 转换并写入交错输出
+    /// </summary>
+    /// <param name="inputData">输入数据，平面格式时每个声道一个指针</param>
+    /// <param name="samples">每个声道的样本数</param>
+    /// <param name="output">输出空间，至少可容纳samples个样本帧</param>
+    void Convert(const uint8_t* const* inputData, int samples, uint8_t* output) const;
+
+    /// <summary>
+    /// 是否只是拷贝（格式相同，平面格式时仅交错）
+    /// </summary>
+    bool IsCopyOnly() const
+    {
+        return m_kernel == nullptr;
+    }
+
+    /// <summary>
+    /// 获取当前CPU使用的指令集名称，用于日志
+    /// </summary>
+    static const char* GetSimdLevelName();
+
+    /// <summary>
+    /// 格式转换基准测试：分别用本转换器和swr将相同的合成信号转换为交错S16/FLT，
+    /// 统计耗时、校验两者输出一致并写入日志
+    /// </summary>
+    /// <param name="seconds">合成信号时长（秒，48kHz立体声）</param>
+    /// <returns>所有组合输出均与swr一致返回true</returns>
+    static bool Benchmark(int seconds = 60);
+
+    /// <summary>
+    /// 转换核心：将count个连续样本从输入格式转换为输出格式
+    /// </summary>
+    using ConvertKernel = void (*)(const uint8_t* src, uint8_t* dst, size_t count);
+
+private:
+    /// <summary>
+    /// 将各声道的平面数据交错写入输出
+    /// </summary>
+    /// <param name="planes">各声道数据（已是输出格式）</param>
+    /// <param name="samples">每个声道的样本数</param>
+    /// <param name="output">交错输出</param>
+    void Interleave(const uint8_t* const* planes, size_t samples, uint8_t* output) const;
+
+private:
+    static const int MAX_CHANNELS{8};           /// 支持的最大声道数（与AVFrame数据指针数一致）
+    static const int BLOCK_SAMPLES{256};        /// 平面格式转换时每块的样本数，块缓冲区保持在L1缓存内
+    static const int MAX_OUT_SAMPLE_BYTES{4};   /// 需要转换时输出样本的最大字节数
+
+    ConvertKernel m_kernel{nullptr};            /// 转换核心，为空表示格式相同只需拷贝
+    int m_channels{0};                          /// 声道数
+    bool m_bPlanar{false};                      /// 输入是否为平面格式
+    size_t m_inSampleBytes{0};                  /// 输入单个样本的字节数
+    size_t m_outSampleBytes{0};                 /// 输出单个样本的字节数
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+extern "C"
+{
+#include <libavutil/cpu.h>
+}
+
+// x86上SSE2为基础指令集，AVX2按函数开启并在运行时检测
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_X86_SIMD 1
+#include <immintrin.h>
+// GCC/Clang需要按函数开启AVX2指令，MSVC可直接使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIO_TARGET_AVX2
+#endif
+#else
+#define AUDIO_X86_SIMD 0
+#endif
+
+/// <summary>
+/// 音频处理可用的SIMD指令集
+/// </summary>
+enum class EM_SimdLevel
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+/// <summary>
+/// 获取当前CPU可用的最高SIMD指令集
+/// </summary>
+inline EM_SimdLevel GetAudioSimdLevel()
+{
+#if AUDIO_X86_SIMD
+    const int cpuFlags = av_get_cpu_flags();
+    if (cpuFlags & AV_CPU_FLAG_AVX2)
+    {
+        return EM_SimdLevel::Avx2;
+    }
+    if (cpuFlags & AV_CPU_FLAG_SSE2)
+    {
+        return EM_SimdLevel::Sse2;
+    }
+#endif
+    return EM_SimdLevel::Scalar;
+}
+
+/// <summary>
+/// 获取SIMD指令集名称，用于日志
+/// </summary>
+inline const char* GetAudioSimdLevelName(EM_SimdLevel level)
+{
+    switch (level)
+    {
+        case EM_SimdLevel::Avx2:
+            return "avx2";
+        case EM_SimdLevel::Sse2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
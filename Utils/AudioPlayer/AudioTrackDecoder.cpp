@@ -0,0 +1,625 @@
+#include "AudioTrackDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "../BasePlayer/FFmpegPublicUtils.h"
+#include "LogSystem/LogSystem.h"
+#include "TimeSystem/TimeSystem.h"
+
+bool AudioTrackDecoder::Init(std::unique_ptr<ST_OpenFileResult> openFileResult, const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels, EM_ResampleUsage usage)
+{
+    if (!openFileResult || !openFileResult->m_formatCtx || !openFileResult->m_formatCtx->GetRawContext() || !openFileResult->m_codecCtx || openFileResult->m_audioStreamIdx < 0)
+    {
+        LOG_WARN("AudioTrackDecoder::Init() : Invalid open file result: " + filePath.toStdString());
+        return false;
+    }
+
+    m_openFileResult = std::move(openFileResult);
+    m_filePath = filePath;
+    m_audioStreamIdx = m_openFileResult->m_audioStreamIdx;
+    m_duration = static_cast<double>(m_openFileResult->m_formatCtx->GetRawContext()->duration) / AV_TIME_BASE;
+    m_resampler = std::make_unique<AudioResampler>(usage);
+    m_resampleParams = std::make_unique<ST_ResampleParams>();
+    m_bResampleParamsUpdated = false;
+    m_bFirstOutputPending = true;
+    m_firstOutputSample = AV_NOPTS_VALUE;
+
+    // 获取音频参数
+    AVStream* audioStream = m_openFileResult->m_formatCtx->GetRawContext()->streams[m_audioStreamIdx];
+    AVCodecParameters* codecpar = audioStream->codecpar;
+    AVCodecContext* codecCtx = m_openFileResult->m_codecCtx->GetRawContext();
+
+    // 设置实际的输入参数（优先使用解码器上下文的参数）
+    int inputSampleRate = (codecCtx->sample_rate > 0) ? codecCtx->sample_rate : codecpar->sample_rate;
+    AVSampleFormat inputFormat = (codecCtx->sample_fmt != AV_SAMPLE_FMT_NONE) ? codecCtx->sample_fmt : static_cast<AVSampleFormat>(codecpar->format);
+    m_sourceSampleRate = inputSampleRate;
+    m_sourceChannels = (codecCtx->ch_layout.nb_channels > 0) ? codecCtx->ch_layout.nb_channels : codecpar->ch_layout.nb_channels;
+    m_sourceFormat = inputFormat;
+
+    // 如果格式仍然是NONE，则设置一个默认值
+    if (inputFormat == AV_SAMPLE_FMT_NONE)
+    {
+        LOG_WARN("Audio format is AV_SAMPLE_FMT_NONE, will update from first decoded frame");
+        inputFormat = AV_SAMPLE_FMT_FLTP;
+    }
+
+    m_resampleParams->GetInput().SetSampleRate(inputSampleRate);
+    m_resampleParams->GetInput().SetSampleFormat(ST_AVSampleFormat(inputFormat));
+
+    // 设置输入通道布局
+    AVChannelLayoutRAII inLayout;
+    if (codecCtx->ch_layout.nb_channels > 0)
+    {
+        inLayout = AVChannelLayoutRAII::copyFrom(&codecCtx->ch_layout);
+    }
+    else
+    {
+        inLayout = AVChannelLayoutRAII::copyFrom(&codecpar->ch_layout);
+    }
+
+    if (inLayout)
+    {
+        m_resampleParams->GetInput().SetChannelLayout(ST_AVChannelLayout(inLayout.release()));
+    }
+
+    SetOutputParams(outSampleRate, outFormat, outChannels);
+
+    LOG_INFO("Audio parameters - Input: " + std::to_string(inputSampleRate) + "Hz, " + std::to_string(codecpar->ch_layout.nb_channels) + " channels");
+    LOG_INFO("Audio parameters - Output: " + std::to_string(outSampleRate) + "Hz, " + std::to_string(outChannels) + " channels, " + std::string(av_get_sample_fmt_name(outFormat)) + " format");
+    return true;
+}
+
+bool AudioTrackDecoder::InitMappedWav(std::unique_ptr<ST_MappedWavFile> mappedWav, const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels)
+{
+    if (!mappedWav || !mappedWav->GetData())
+    {
+        return false;
+    }
+
+    if (mappedWav->GetSampleRate() != outSampleRate || mappedWav->GetSampleFormat() != outFormat || mappedWav->GetChannels() != outChannels)
+    {
+        LOG_INFO("Mapped WAV format differs from output, fallback to decoding: " + filePath.toStdString());
+        return false;
+    }
+
+    m_mappedWav = std::move(mappedWav);
+    m_filePath = filePath;
+    m_duration = m_mappedWav->GetDuration();
+    m_sourceSampleRate = m_mappedWav->GetSampleRate();
+    m_sourceChannels = m_mappedWav->GetChannels();
+    m_sourceFormat = m_mappedWav->GetSampleFormat();
+    m_resampleParams = std::make_unique<ST_ResampleParams>();
+    SetOutputParams(outSampleRate, outFormat, outChannels);
+    SetMemorySource(m_mappedWav->GetData(), m_mappedWav->GetDataSize(), m_mappedWav->GetSampleRate(), m_mappedWav->GetBlockAlign());
+
+    LOG_INFO("Mapped WAV track: " + filePath.toStdString() + ", " + std::to_string(m_mappedWav->GetDataSize()) + " bytes of PCM, " + std::to_string(m_duration) + " seconds");
+    return true;
+}
+
+bool AudioTrackDecoder::InitCachedPCM(std::shared_ptr<const ST_PCMCacheEntry> cacheEntry)
+{
+    if (!cacheEntry || cacheEntry->m_pcm.empty())
+    {
+        return false;
+    }
+
+    const ST_PCMCacheKey& key = cacheEntry->m_key;
+    const int blockAlign = key.m_channels * av_get_bytes_per_sample(key.m_sampleFormat);
+    if (key.m_sampleRate <= 0 || blockAlign <= 0)
+    {
+        return false;
+    }
+
+    m_cachedPCM = std::move(cacheEntry);
+    m_filePath = key.m_filePath;
+    m_duration = m_cachedPCM->m_duration;
+    m_sourceSampleRate = m_cachedPCM->m_sourceSampleRate;
+    m_sourceChannels = m_cachedPCM->m_sourceChannels;
+    m_sourceFormat = m_cachedPCM->m_sourceFormat;
+    m_resampleParams = std::make_unique<ST_ResampleParams>();
+    SetOutputParams(key.m_sampleRate, key.m_sampleFormat, key.m_channels);
+    SetMemorySource(m_cachedPCM->m_pcm.data(), m_cachedPCM->m_pcm.size(), key.m_sampleRate, blockAlign);
+
+    LOG_INFO("Cached PCM track: " + m_filePath.toStdString() + ", " + std::to_string(m_cachedPCM->m_pcm.size()) + " bytes of PCM, " + std::to_string(m_duration) + " seconds");
+    return true;
+}
+
+void AudioTrackDecoder::SetMemorySource(const uint8_t* data, size_t size, int sampleRate, int blockAlign)
+{
+    m_memoryData = data;
+    m_memorySize = size - size % blockAlign;
+    m_memoryReadOffset = 0;
+    m_memorySampleRate = sampleRate;
+    m_memoryBlockAlign = blockAlign;
+    m_bResampleParamsUpdated = true;
+    m_bPassthrough = true;
+}
+
+const uint8_t* AudioTrackDecoder::PeekMemoryPCM(size_t& availableBytes) const
+{
+    if (!m_memoryData)
+    {
+        availableBytes = 0;
+        return nullptr;
+    }
+
+    availableBytes = m_memorySize - m_memoryReadOffset;
+    return m_memoryData + m_memoryReadOffset;
+}
+
+void AudioTrackDecoder::ConsumeMemoryPCM(size_t bytes)
+{
+    if (m_memoryData)
+    {
+        m_memoryReadOffset = std::min(m_memoryReadOffset + bytes, m_memorySize);
+    }
+}
+
+void AudioTrackDecoder::EnableCapture(size_t maxBytes)
+{
+    if (m_memoryData || maxBytes == 0)
+    {
+        return;
+    }
+
+    m_bCapturing = true;
+    m_captureLimit = maxBytes;
+    m_capturePCM.clear();
+
+    // 按时长预留空间，避免整首解码过程中反复扩容拷贝
+    const ST_AVSampleFormat& outFormat = m_resampleParams->GetOutput().GetSampleFormat();
+    const int outChannels = m_resampleParams->GetOutput().GetChannelLayout().GetRawLayout() ? m_resampleParams->GetOutput().GetChannelLayout().GetRawLayout()->nb_channels : 0;
+    const double estimatedBytes = m_duration * m_resampleParams->GetOutput().GetSampleRate() * outChannels * av_get_bytes_per_sample(outFormat.sampleFormat);
+    if (estimatedBytes > 0 && estimatedBytes <= static_cast<double>(maxBytes))
+    {
+        m_capturePCM.reserve(static_cast<size_t>(estimatedBytes) + static_cast<size_t>(estimatedBytes) / 64);
+    }
+}
+
+bool AudioTrackDecoder::TakeCapturedPCM(std::vector<uint8_t>& outPCM)
+{
+    if (!m_bCapturing || m_capturePCM.empty())
+    {
+        return false;
+    }
+
+    outPCM = std::move(m_capturePCM);
+    m_capturePCM = std::vector<uint8_t>();
+    m_bCapturing = false;
+    return true;
+}
+
+void AudioTrackDecoder::GetSourceFormat(int& sampleRate, int& channels, AVSampleFormat& sampleFormat) const
+{
+    sampleRate = m_sourceSampleRate;
+    channels = m_sourceChannels;
+    sampleFormat = m_sourceFormat;
+}
+
+void AudioTrackDecoder::CapturePCM(const uint8_t* data, size_t bytes)
+{
+    if (!m_bCapturing || bytes == 0)
+    {
+        return;
+    }
+
+    if (m_capturePCM.size() + bytes > m_captureLimit)
+    {
+        LOG_INFO("Audio track exceeds PCM cache budget, stop capturing: " + m_filePath.toStdString());
+        CancelCapture();
+        return;
+    }
+    m_capturePCM.insert(m_capturePCM.end(), data, data + bytes);
+}
+
+void AudioTrackDecoder::CancelCapture()
+{
+    m_bCapturing = false;
+    m_capturePCM = std::vector<uint8_t>();
+}
+
+bool AudioTrackDecoder::Seek(double seconds, bool bAccurate)
+{
+    if (m_memoryData)
+    {
+        // 内存音轨直接按样本帧计算偏移，天然样本精确
+        const size_t blockAlign = static_cast<size_t>(m_memoryBlockAlign);
+        const size_t targetFrame = static_cast<size_t>(std::max<int64_t>(std::llround(seconds * m_memorySampleRate), 0));
+        m_memoryReadOffset = std::min(targetFrame * blockAlign, m_memorySize);
+        m_prerollPCM.clear();
+        m_bPrerollEOF = false;
+        return true;
+    }
+
+    if (!m_openFileResult)
+    {
+        return false;
+    }
+
+    // 回到开头时重新保存，seek到其他位置则无法得到完整音轨
+    if (m_bCapturing)
+    {
+        if (seconds <= 0.0)
+        {
+            m_capturePCM.clear();
+        }
+        else
+        {
+            CancelCapture();
+        }
+    }
+
+    m_seekTargetSeconds = seconds;
+    m_bTrimPending = bAccurate;
+    m_bFirstOutputPending = true;
+    m_firstOutputSample = AV_NOPTS_VALUE;
+    m_prerollPCM.clear();
+    m_bPrerollEOF = false;
+
+    // 丢弃重采样器中seek前的残留样本
+    if (m_resampler)
+    {
+        m_resampler->Reset();
+    }
+
+    return FFmpegPublicUtils::SeekAudio(m_openFileResult->m_formatCtx->GetRawContext(), m_openFileResult->m_codecCtx->GetRawContext(), seconds);
+}
+
+bool AudioTrackDecoder::DecodePacket(std::vector<uint8_t>& outPCM)
+{
+    ST_PCMOutput output(outPCM);
+    return DecodePacket(output);
+}
+
+bool AudioTrackDecoder::DecodePacket(ST_PCMOutput& output)
+{
+    if (m_memoryData)
+    {
+        // 内存音轨按固定块大小拷贝，正常播放时由调用方通过PeekMemoryPCM直接写入环形缓冲区
+        static const size_t MEMORY_CHUNK_SIZE{65536};
+        size_t availableBytes = 0;
+        const uint8_t* data = PeekMemoryPCM(availableBytes);
+        if (availableBytes == 0)
+        {
+            return false;
+        }
+        const size_t bytes = std::min(availableBytes, MEMORY_CHUNK_SIZE);
+        memcpy(output.Reserve(bytes), data, bytes);
+        output.Commit(bytes);
+        ConsumeMemoryPCM(bytes);
+        return true;
+    }
+
+    if (!m_openFileResult)
+    {
+        return false;
+    }
+
+    if (!m_packet.ReadPacket(m_openFileResult->m_formatCtx->GetRawContext()))
+    {
+        return false;
+    }
+
+    if (m_packet.GetRawPacket()->stream_index != m_audioStreamIdx)
+    {
+        m_packet.UnrefPacket();
+        return true;
+    }
+
+    // 发送数据包到解码器
+    if (!m_packet.SendPacket(m_openFileResult->m_codecCtx->GetRawContext()))
+    {
+        return true;
+    }
+    m_packet.UnrefPacket();
+
+    // 接收解码后的帧
+    while (m_frame.GetCodecFrame(m_openFileResult->m_codecCtx->GetRawContext()))
+    {
+        AVFrame* rawFrame = m_frame.GetRawFrame();
+
+        int trimSamples = CalculateTrimSamples(rawFrame);
+        if (trimSamples < 0)
+        {
+            continue;
+        }
+
+        if (m_bFirstOutputPending)
+        {
+            m_firstOutputSample = GetFrameStartSample(rawFrame);
+            if (m_firstOutputSample != AV_NOPTS_VALUE)
+            {
+                m_firstOutputSample += trimSamples;
+            }
+            m_bFirstOutputPending = false;
+        }
+
+        // 在第一次获取解码帧时更新重采样参数
+        if (!m_bResampleParamsUpdated)
+        {
+            UpdateResampleParamsFromFrame(rawFrame);
+        }
+
+        ResampleFrame(rawFrame, trimSamples, output);
+    }
+
+    return true;
+}
+
+void AudioTrackDecoder::Flush(std::vector<uint8_t>& outPCM)
+{
+    ST_PCMOutput output(outPCM);
+    Flush(output);
+}
+
+void AudioTrackDecoder::Flush(ST_PCMOutput& output)
+{
+    LogConvertStats();
+    if (!m_resampler || !m_resampleParams || m_bPassthrough)
+    {
+        return;
+    }
+
+    const int maxSamples = m_resampler->GetMaxOutputSamples(0, *m_resampleParams);
+    if (maxSamples <= 0)
+    {
+        return;
+    }
+
+    const size_t frameBytes = GetOutputFrameBytes();
+    uint8_t* dst = output.Reserve(static_cast<size_t>(maxSamples) * frameBytes);
+    const int samples = m_resampler->FlushInto(dst, maxSamples);
+    const size_t bytes = samples > 0 ? static_cast<size_t>(samples) * frameBytes : 0;
+    output.Commit(bytes);
+    CapturePCM(dst, bytes);
+}
+
+void AudioTrackDecoder::Preroll(size_t bytes)
+{
+    // 内存音轨无需预解码，衔接时直接从内存读取
+    if (m_memoryData)
+    {
+        return;
+    }
+
+    TIME_START("AudioTrackPreroll");
+    m_prerollPCM.reserve(bytes + bytes / 4);
+    while (m_prerollPCM.size() < bytes)
+    {
+        if (!DecodePacket(m_prerollPCM))
+        {
+            Flush(m_prerollPCM);
+            m_bPrerollEOF = true;
+            break;
+        }
+    }
+    TimeSystem::Instance().StopTimingWithLog("AudioTrackPreroll", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Prerolled " + std::to_string(m_prerollPCM.size()) + " bytes of " + m_filePath.toStdString());
+}
+
+bool AudioTrackDecoder::TakePrerollPCM(std::vector<uint8_t>& outPCM)
+{
+    outPCM.insert(outPCM.end(), m_prerollPCM.begin(), m_prerollPCM.end());
+    m_prerollPCM.clear();
+    m_prerollPCM.shrink_to_fit();
+    return m_bPrerollEOF;
+}
+
+void AudioTrackDecoder::SetOutputParams(int outSampleRate, AVSampleFormat outFormat, int outChannels)
+{
+    m_resampleParams->GetOutput().SetSampleRate(outSampleRate);
+    m_resampleParams->GetOutput().SetSampleFormat(ST_AVSampleFormat(outFormat));
+
+    // 设置输出通道布局
+    auto outLayout = AVChannelLayoutRAII::createDefault(outChannels);
+    if (outLayout)
+    {
+        m_resampleParams->GetOutput().SetChannelLayout(ST_AVChannelLayout(outLayout.release()));
+    }
+}
+
+void AudioTrackDecoder::UpdateResampleParamsFromFrame(const AVFrame* rawFrame)
+{
+    // 从实际解码的帧获取正确的音频格式
+    auto actualFormat = static_cast<AVSampleFormat>(rawFrame->format);
+    int actualSampleRate = rawFrame->sample_rate;
+
+    LOG_INFO("Updating resample params from first decoded frame:");
+    LOG_INFO("  Actual format: " + std::to_string(static_cast<int>(actualFormat)) + " (" + std::string(av_get_sample_fmt_name(actualFormat)) + ")");
+    LOG_INFO("  Actual sample rate: " + std::to_string(actualSampleRate));
+    LOG_INFO("  Actual channels: " + std::to_string(rawFrame->ch_layout.nb_channels));
+
+    // 更新重采样参数
+    m_resampleParams->GetInput().SetSampleFormat(ST_AVSampleFormat(actualFormat));
+    if (actualSampleRate > 0)
+    {
+        m_resampleParams->GetInput().SetSampleRate(actualSampleRate);
+    }
+
+    // 使用RAII包装器更新通道布局
+    if (rawFrame->ch_layout.nb_channels > 0)
+    {
+        auto inLayout = AVChannelLayoutRAII::copyFrom(&rawFrame->ch_layout);
+        if (inLayout)
+        {
+            m_resampleParams->GetInput().SetChannelLayout(ST_AVChannelLayout(inLayout.release()));
+        }
+    }
+
+    m_bResampleParamsUpdated = true;
+
+    // 采样率、声道布局和（交错后的）采样格式均与输出一致时无需重采样；多声道要求声道顺序一致
+    const AVChannelLayout* outLayout = m_resampleParams->GetOutput().GetChannelLayout().GetRawLayout();
+    bool bSameLayout = outLayout && rawFrame->ch_layout.nb_channels == outLayout->nb_channels
+                       && (outLayout->nb_channels <= 2 || av_channel_layout_compare(&rawFrame->ch_layout, outLayout) == 0);
+    m_bPassthrough = actualSampleRate == m_resampleParams->GetOutput().GetSampleRate()
+                     && bSameLayout
+                     && av_get_packed_sample_fmt(actualFormat) == m_resampleParams->GetOutput().GetSampleFormat().sampleFormat;
+    LOG_INFO(std::string("Audio output mode: ") + (m_bPassthrough ? "passthrough (no resampling)" : "resample"));
+}
+
+int64_t AudioTrackDecoder::GetFrameStartSample(const AVFrame* rawFrame) const
+{
+    int64_t framePts = (rawFrame->pts != AV_NOPTS_VALUE) ? rawFrame->pts : rawFrame->best_effort_timestamp;
+    if (framePts == AV_NOPTS_VALUE || rawFrame->sample_rate <= 0)
+    {
+        return AV_NOPTS_VALUE;
+    }
+    AVStream* audioStream = m_openFileResult->m_formatCtx->GetRawContext()->streams[m_audioStreamIdx];
+    return av_rescale_q(framePts, audioStream->time_base, AVRational{1, rawFrame->sample_rate});
+}
+
+int AudioTrackDecoder::CalculateTrimSamples(const AVFrame* rawFrame)
+{
+    if (!m_bTrimPending)
+    {
+        return 0;
+    }
+
+    // seek后按样本精度定位：整帧位于目标之前则丢弃，跨越目标的帧只保留目标之后的样本
+    int trimSamples = 0;
+    int64_t frameStartSample = GetFrameStartSample(rawFrame);
+    if (frameStartSample != AV_NOPTS_VALUE)
+    {
+        // 以样本为单位计算目标位置相对帧起点的偏移，避免浮点秒数比较带来的误差
+        int64_t targetSample = static_cast<int64_t>(std::llround(m_seekTargetSeconds * rawFrame->sample_rate));
+        int64_t offsetSamples = targetSample - frameStartSample;
+        if (offsetSamples >= rawFrame->nb_samples)
+        {
+            LOG_DEBUG("Skipping early audio frame after seek: frameStart=" + std::to_string(frameStartSample) + ", target=" + std::to_string(targetSample));
+            return -1;
+        }
+        trimSamples = static_cast<int>(std::max<int64_t>(offsetSamples, 0));
+    }
+
+    // 找到第一个跨越目标的帧，重置标记
+    m_bTrimPending = false;
+    LOG_INFO("Found first audio frame after seek: target=" + std::to_string(m_seekTargetSeconds) + " seconds, trimmed " + std::to_string(trimSamples) + " of " + std::to_string(rawFrame->nb_samples) + " samples");
+    return trimSamples;
+}
+
+void AudioTrackDecoder::ResampleFrame(const AVFrame* rawFrame, int trimSamples, ST_PCMOutput& output)
+{
+    if (m_bPassthrough)
+    {
+        CopyFrame(rawFrame, trimSamples, output);
+        return;
+    }
+
+    // 准备输入数据指针数组
+    const uint8_t* inputDataPtrs[AV_NUM_DATA_POINTERS] = {0};
+
+    // 检查是否为平面格式
+    auto frameFormat = static_cast<AVSampleFormat>(rawFrame->format);
+    bool isPlanar = av_sample_fmt_is_planar(frameFormat);
+    int channels = rawFrame->ch_layout.nb_channels;
+    int bytesPerSample = av_get_bytes_per_sample(frameFormat);
+
+    if (isPlanar)
+    {
+        // 平面格式：每个通道分别存储，跳过裁剪掉的样本
+        for (int ch = 0; ch < channels && ch < AV_NUM_DATA_POINTERS; ch++)
+        {
+            inputDataPtrs[ch] = rawFrame->data[ch] + static_cast<size_t>(trimSamples) * bytesPerSample;
+        }
+    }
+    else
+    {
+        // 交错格式：所有通道数据交错存储，跳过裁剪掉的样本
+        inputDataPtrs[0] = rawFrame->data[0] + static_cast<size_t>(trimSamples) * bytesPerSample * channels;
+    }
+
+    const int inputSamples = rawFrame->nb_samples - trimSamples;
+    const int maxSamples = m_resampler->GetMaxOutputSamples(inputSamples, *m_resampleParams);
+    if (maxSamples <= 0)
+    {
+        LOG_WARN("AudioTrackDecoder::ResampleFrame() : Failed to get output sample count");
+        return;
+    }
+
+    // 预留输出上限后直接转换到输出目标，提交实际输出的字节数
+    const size_t frameBytes = GetOutputFrameBytes();
+    uint8_t* dst = output.Reserve(static_cast<size_t>(maxSamples) * frameBytes);
+    TIME_START("AudioResample");
+    const int samples = m_resampler->ResampleInto(inputDataPtrs, inputSamples, dst, maxSamples, *m_resampleParams);
+    double resampleDuration = TimeSystem::Instance().StopTiming("AudioResample", EM_TimeUnit::Microseconds);
+    const size_t bytes = samples > 0 ? static_cast<size_t>(samples) * frameBytes : 0;
+    output.Commit(bytes);
+    CapturePCM(dst, bytes);
+    m_convertMicroseconds += resampleDuration;
+    m_convertedSamples += samples > 0 ? samples : 0;
+
+    // 只在耗时较长时记录重采样时间
+    if (resampleDuration > 1000) // 大于1ms才记录
+    {
+        LOG_DEBUG("Frame resampling took " + std::to_string(resampleDuration) + " μs");
+    }
+}
+
+void AudioTrackDecoder::CopyFrame(const AVFrame* rawFrame, int trimSamples, ST_PCMOutput& output)
+{
+    TIME_START("AudioPassthrough");
+    auto frameFormat = static_cast<AVSampleFormat>(rawFrame->format);
+    const int channels = rawFrame->ch_layout.nb_channels;
+    const size_t bytesPerSample = static_cast<size_t>(av_get_bytes_per_sample(frameFormat));
+    const size_t samples = static_cast<size_t>(rawFrame->nb_samples - trimSamples);
+    const size_t frameBytes = bytesPerSample * channels;
+
+    uint8_t* dst = output.Reserve(samples * frameBytes);
+
+    if (!av_sample_fmt_is_planar(frameFormat))
+    {
+        // 交错格式与输出布局相同，直接拷贝
+        memcpy(dst, rawFrame->extended_data[0] + trimSamples * frameBytes, samples * frameBytes);
+    }
+    else if (m_planarInterleaver.Init(frameFormat, av_get_packed_sample_fmt(frameFormat), channels))
+    {
+        // 平面格式：按声道交错（立体声使用SIMD解包）
+        const uint8_t* planes[AV_NUM_DATA_POINTERS] = {nullptr};
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            planes[ch] = rawFrame->extended_data[ch] + trimSamples * bytesPerSample;
+        }
+        m_planarInterleaver.Convert(planes, static_cast<int>(samples), dst);
+    }
+    else
+    {
+        // 声道数超出交错器支持范围：逐样本按声道交错
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const uint8_t* src = rawFrame->extended_data[ch] + trimSamples * bytesPerSample;
+            uint8_t* out = dst + ch * bytesPerSample;
+            for (size_t i = 0; i < samples; ++i)
+            {
+                memcpy(out, src, bytesPerSample);
+                src += bytesPerSample;
+                out += frameBytes;
+            }
+        }
+    }
+
+    output.Commit(samples * frameBytes);
+    CapturePCM(dst, samples * frameBytes);
+    m_convertMicroseconds += TimeSystem::Instance().StopTiming("AudioPassthrough", EM_TimeUnit::Microseconds);
+    m_convertedSamples += static_cast<int64_t>(samples);
+}
+
+size_t AudioTrackDecoder::GetOutputFrameBytes() const
+{
+    const auto& outParams = m_resampleParams->GetOutput();
+    return static_cast<size_t>(av_get_bytes_per_sample(outParams.GetSampleFormat().sampleFormat)) * outParams.GetChannels();
+}
+
+void AudioTrackDecoder::LogConvertStats() const
+{
+    const int outSampleRate = m_resampleParams ? m_resampleParams->GetOutput().GetSampleRate() : 0;
+    if (m_convertedSamples <= 0 || outSampleRate <= 0)
+    {
+        return;
+    }
+
+    // 折算为每小时音频的转换耗时，便于比较直通和重采样两种模式
+    double audioHours = static_cast<double>(m_convertedSamples) / outSampleRate / 3600.0;
+    LOG_INFO(std::string("Audio convert stats (") + (m_bPassthrough ? "passthrough" : "resample") + "): " + std::to_string(m_convertMicroseconds / 1000.0) + " ms for " + std::to_string(m_convertedSamples) + " samples, "
+             + std::to_string(m_convertMicroseconds / 1000.0 / audioHours) + " ms per hour of audio");
+}
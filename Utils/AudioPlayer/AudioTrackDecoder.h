@@ -0,0 +1,319 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <QString>
+#include "AudioPCMCache.h"
+#include "AudioResampler.h"
+#include "AudioSampleConverter.h"
+#include "BaseDataDefine/ST_AVFrame.h"
+#include "BaseDataDefine/ST_AVPacket.h"
+#include "DataDefine/ST_MappedWavFile.h"
+#include "DataDefine/ST_OpenFileResult.h"
+#include "DataDefine/ST_PCMOutput.h"
+#include "DataDefine/ST_ResampleParams.h"
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavutil/samplefmt.h>
+}
+
+/// <summary>
+/// 单个音轨的流式解码器
+/// 持有打开的解码上下文和重采样器，按数据包将音频解码为统一输出格式的PCM
+/// </summary>
+class AudioTrackDecoder
+{
+public:
+    /// <summary>
+    /// 构造函数
+    /// </summary>
+    AudioTrackDecoder() = default;
+
+    /// <summary>
+    /// 析构函数
+    /// </summary>
+    ~AudioTrackDecoder() = default;
+
+    AudioTrackDecoder(const AudioTrackDecoder&) = delete;
+    AudioTrackDecoder& operator=(const AudioTrackDecoder&) = delete;
+
+    /// <summary>
+    /// 使用已打开的文件初始化解码器和重采样参数
+    /// </summary>
+    /// <param name="openFileResult">打开文件结果（转移所有权）</param>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outSampleRate">输出采样率</param>
+    /// <param name="outFormat">输出采样格式</param>
+    /// <param name="outChannels">输出声道数</param>
+    /// <param name="usage">重采样用途，决定重采样后端和质量预设</param>
+    /// <returns>是否初始化成功</returns>
+    bool Init(std::unique_ptr<ST_OpenFileResult> openFileResult, const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels, EM_ResampleUsage usage = EM_ResampleUsage::Playback);
+
+    /// <summary>
+    /// 使用内存映射的WAV文件初始化，样本格式与输出格式完全一致时才可用，读取时不经过解码和重采样
+    /// </summary>
+    /// <param name="mappedWav">已映射的WAV文件（转移所有权）</param>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="outSampleRate">输出采样率</param>
+    /// <param name="outFormat">输出采样格式</param>
+    /// <param name="outChannels">输出声道数</param>
+    /// <returns>格式一致且初始化成功返回true</returns>
+    bool InitMappedWav(std::unique_ptr<ST_MappedWavFile> mappedWav, const QString& filePath, int outSampleRate, AVSampleFormat outFormat, int outChannels);
+
+    /// <summary>
+    /// 使用缓存的已解码PCM初始化，读取时不经过解码和重采样
+    /// </summary>
+    /// <param name="cacheEntry">缓存项（共享所有权，缓存淘汰后仍可继续播放）</param>
+    /// <returns>是否初始化成功</returns>
+    bool InitCachedPCM(std::shared_ptr<const ST_PCMCacheEntry> cacheEntry);
+
+    /// <summary>
+    /// 是否为内存中的PCM音轨（映射的WAV文件或PCM缓存）
+    /// </summary>
+    bool IsInMemory() const
+    {
+        return m_memoryData != nullptr;
+    }
+
+    /// <summary>
+    /// 获取内存音轨中尚未读取的PCM数据（仅内存音轨）
+    /// </summary>
+    /// <param name="availableBytes">剩余字节数</param>
+    /// <returns>读取位置的数据指针</returns>
+    const uint8_t* PeekMemoryPCM(size_t& availableBytes) const;
+
+    /// <summary>
+    /// 前移内存音轨的读取位置（仅内存音轨）
+    /// </summary>
+    /// <param name="bytes">已消费的字节数</param>
+    void ConsumeMemoryPCM(size_t bytes);
+
+    /// <summary>
+    /// 从开头解码时保存全部输出PCM，供解码结束后放入PCM缓存；超出上限或seek到其他位置时放弃
+    /// </summary>
+    /// <param name="maxBytes">保存的字节数上限</param>
+    void EnableCapture(size_t maxBytes);
+
+    /// <summary>
+    /// 取出从开头完整解码到结尾的PCM数据（需在Flush之后调用）
+    /// </summary>
+    /// <param name="outPCM">输出PCM数据</param>
+    /// <returns>是否有完整的PCM数据</returns>
+    bool TakeCapturedPCM(std::vector<uint8_t>& outPCM);
+
+    /// <summary>
+    /// 获取源音频参数（容器中声明的格式）
+    /// </summary>
+    /// <param name="sampleRate">源采样率</param>
+    /// <param name="channels">源声道数</param>
+    /// <param name="sampleFormat">源采样格式</param>
+    void GetSourceFormat(int& sampleRate, int& channels, AVSampleFormat& sampleFormat) const;
+
+    /// <summary>
+    /// 定位到指定位置，精确定位时之后解码的第一帧按样本精度裁剪到目标位置
+    /// </summary>
+    /// <param name="seconds">目标位置（秒）</param>
+    /// <param name="bAccurate">是否精确定位，否则从目标前的数据包直接开始输出（用于拖动预览）</param>
+    /// <returns>是否定位成功</returns>
+    bool Seek(double seconds, bool bAccurate = true);
+
+    /// <summary>
+    /// 读取并解码一个数据包，重采样结果追加到outPCM
+    /// </summary>
+    /// <param name="outPCM">输出PCM缓冲区</param>
+    /// <returns>文件读取结束返回false</returns>
+    bool DecodePacket(std::vector<uint8_t>& outPCM);
+
+    /// <summary>
+    /// 读取并解码一个数据包，重采样结果直接写入输出目标（如环形缓冲区的写入窗口），不经过中间缓冲区
+    /// </summary>
+    /// <param name="output">输出目标</param>
+    /// <returns>文件读取结束返回false</returns>
+    bool DecodePacket(ST_PCMOutput& output);
+
+    /// <summary>
+    /// 取出重采样器中的剩余数据，追加到outPCM
+    /// </summary>
+    /// <param name="outPCM">输出PCM缓冲区</param>
+    void Flush(std::vector<uint8_t>& outPCM);
+
+    /// <summary>
+    /// 取出重采样器中的剩余数据，直接写入输出目标
+    /// </summary>
+    /// <param name="output">输出目标</param>
+    void Flush(ST_PCMOutput& output);
+
+    /// <summary>
+    /// 预解码音轨开头的数据，供无缝切换时直接写入
+    /// </summary>
+    /// <param name="bytes">预解码的字节数</param>
+    void Preroll(size_t bytes);
+
+    /// <summary>
+    /// 取出预解码的数据，追加到outPCM
+    /// </summary>
+    /// <param name="outPCM">输出PCM缓冲区</param>
+    /// <returns>预解码阶段是否已读到文件结尾</returns>
+    bool TakePrerollPCM(std::vector<uint8_t>& outPCM);
+
+    /// <summary>
+    /// 获取初始化或seek后首个输出样本在源音轨中的位置（源采样率下的样本序号，按帧时间戳计算）
+    /// </summary>
+    /// <returns>尚未输出或帧没有时间戳时返回AV_NOPTS_VALUE</returns>
+    int64_t GetFirstOutputSample() const
+    {
+        return m_firstOutputSample;
+    }
+
+    /// <summary>
+    /// 获取文件路径
+    /// </summary>
+    const QString& GetFilePath() const
+    {
+        return m_filePath;
+    }
+
+    /// <summary>
+    /// 获取音轨时长（秒）
+    /// </summary>
+    double GetDuration() const
+    {
+        return m_duration;
+    }
+
+    /// <summary>
+    /// 是否直通输出（源格式与输出格式一致，不经过重采样）
+    /// </summary>
+    bool IsPassthrough() const
+    {
+        return m_bPassthrough;
+    }
+
+    /// <summary>
+    /// 获取重采样参数
+    /// </summary>
+    ST_ResampleParams& GetResampleParams()
+    {
+        return *m_resampleParams;
+    }
+
+    /// <summary>
+    /// 获取打开文件结果
+    /// </summary>
+    ST_OpenFileResult* GetOpenFileResult() const
+    {
+        return m_openFileResult.get();
+    }
+
+private:
+    /// <summary>
+    /// 设置重采样输出参数
+    /// </summary>
+    /// <param name="outSampleRate">输出采样率</param>
+    /// <param name="outFormat">输出采样格式</param>
+    /// <param name="outChannels">输出声道数</param>
+    void SetOutputParams(int outSampleRate, AVSampleFormat outFormat, int outChannels);
+
+    /// <summary>
+    /// 根据首个解码帧的实际格式更新重采样输入参数
+    /// </summary>
+    /// <param name="rawFrame">解码帧</param>
+    void UpdateResampleParamsFromFrame(const AVFrame* rawFrame);
+
+    /// <summary>
+    /// 按时间戳计算解码帧首个样本在源音轨中的位置
+    /// </summary>
+    /// <param name="rawFrame">解码帧</param>
+    /// <returns>帧没有时间戳时返回AV_NOPTS_VALUE</returns>
+    int64_t GetFrameStartSample(const AVFrame* rawFrame) const;
+
+    /// <summary>
+    /// 计算seek后首帧需要裁剪的样本数
+    /// </summary>
+    /// <param name="rawFrame">解码帧</param>
+    /// <returns>需要裁剪的样本数，整帧位于目标之前时返回-1</returns>
+    int CalculateTrimSamples(const AVFrame* rawFrame);
+
+    /// <summary>
+    /// 对解码帧执行重采样，结果直接写入输出目标
+    /// </summary>
+    /// <param name="rawFrame">解码帧</param>
+    /// <param name="trimSamples">帧开头需要跳过的样本数</param>
+    /// <param name="output">输出目标</param>
+    void ResampleFrame(const AVFrame* rawFrame, int trimSamples, ST_PCMOutput& output);
+
+    /// <summary>
+    /// 直通输出：交错格式直接拷贝，平面格式按声道交错，结果直接写入输出目标
+    /// </summary>
+    /// <param name="rawFrame">解码帧</param>
+    /// <param name="trimSamples">帧开头需要跳过的样本数</param>
+    /// <param name="output">输出目标</param>
+    void CopyFrame(const AVFrame* rawFrame, int trimSamples, ST_PCMOutput& output);
+
+    /// <summary>
+    /// 获取输出格式每个样本帧（所有声道）的字节数
+    /// </summary>
+    size_t GetOutputFrameBytes() const;
+
+    /// <summary>
+    /// 输出格式转换耗时统计
+    /// </summary>
+    void LogConvertStats() const;
+
+    /// <summary>
+    /// 设置内存音轨的数据区
+    /// </summary>
+    /// <param name="data">PCM数据</param>
+    /// <param name="size">数据大小（字节）</param>
+    /// <param name="sampleRate">采样率</param>
+    /// <param name="blockAlign">每个样本帧的字节数</param>
+    void SetMemorySource(const uint8_t* data, size_t size, int sampleRate, int blockAlign);
+
+    /// <summary>
+    /// 将本次输出的数据追加到保存缓冲区
+    /// </summary>
+    /// <param name="data">输出数据</param>
+    /// <param name="bytes">字节数</param>
+    void CapturePCM(const uint8_t* data, size_t bytes);
+
+    /// <summary>
+    /// 放弃保存
+    /// </summary>
+    void CancelCapture();
+
+private:
+    std::unique_ptr<ST_OpenFileResult> m_openFileResult{nullptr}; /// 解码上下文
+    std::unique_ptr<AudioResampler> m_resampler{nullptr};         /// 重采样器
+    std::unique_ptr<ST_ResampleParams> m_resampleParams{nullptr}; /// 重采样参数
+    ST_AVPacket m_packet;                                          /// 复用的数据包
+    ST_AVFrame m_frame;                                            /// 复用的解码帧
+    QString m_filePath;                                            /// 文件路径
+    double m_duration{0.0};                                        /// 音轨时长（秒）
+    int m_audioStreamIdx{-1};                                      /// 音频流索引
+    bool m_bResampleParamsUpdated{false};                          /// 重采样参数是否已根据首帧更新
+    bool m_bPassthrough{false};                                    /// 是否直通输出，不经过重采样
+    AudioSampleConverter m_planarInterleaver;                      /// 直通输出时平面格式的声道交错
+    double m_convertMicroseconds{0.0};                             /// 格式转换累计耗时（微秒）
+    int64_t m_convertedSamples{0};                                 /// 格式转换累计输出样本数
+    double m_seekTargetSeconds{0.0};                               /// seek目标位置（秒）
+    bool m_bTrimPending{false};                                    /// 是否处于seek后按样本裁剪阶段
+    bool m_bFirstOutputPending{true};                              /// 是否尚未输出初始化或seek后的首帧
+    int64_t m_firstOutputSample{AV_NOPTS_VALUE};                   /// 初始化或seek后首个输出样本的位置
+    int m_sourceSampleRate{0};                                     /// 源采样率
+    int m_sourceChannels{0};                                       /// 源声道数
+    AVSampleFormat m_sourceFormat{AV_SAMPLE_FMT_NONE};             /// 源采样格式
+    std::unique_ptr<ST_MappedWavFile> m_mappedWav{nullptr};       /// 内存映射的WAV文件
+    std::shared_ptr<const ST_PCMCacheEntry> m_cachedPCM{nullptr}; /// 缓存的已解码PCM
+    const uint8_t* m_memoryData{nullptr};                          /// 内存音轨的数据区
+    size_t m_memorySize{0};                                        /// 内存音轨的数据大小（字节）
+    size_t m_memoryReadOffset{0};                                  /// 内存音轨的读取偏移（字节）
+    int m_memorySampleRate{0};                                     /// 内存音轨的采样率
+    int m_memoryBlockAlign{0};                                     /// 内存音轨每个样本帧的字节数
+    bool m_bCapturing{false};                                      /// 是否正在保存输出PCM
+    size_t m_captureLimit{0};                                      /// 保存的字节数上限
+    std::vector<uint8_t> m_capturePCM;                             /// 从开头保存的输出PCM
+    std::vector<uint8_t> m_prerollPCM;                             /// 预解码的PCM数据
+    bool m_bPrerollEOF{false};                                     /// 预解码阶段是否已读到文件结尾
+};
@@ -0,0 +1,394 @@
+#include "PolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+#include "AudioSimd.h"
+#include "LogSystem/LogSystem.h"
+#include "TimeSystem/TimeSystem.h"
+
+/// <summary>
+/// 指定比例和质量的多相系数表
+/// </summary>
+struct PolyphaseResampler::ST_FilterBank
+{
+    int m_upFactor{1};              /// 升采样因子L，即相位数
+    int m_downFactor{1};            /// 降采样因子M
+    int m_tapCount{0};              /// 有效抽头数
+    int m_center{0};                /// 窗口中心相对窗口起点的偏移
+    size_t m_paddedTaps{0};         /// 按SIMD宽度补零后的抽头数
+    std::vector<float> m_coeffs;    /// 各相位的系数，每个相位m_paddedTaps个
+};
+
+namespace
+{
+const size_t TAP_ALIGNMENT = 8; // 抽头数按AVX2宽度对齐，点积无需处理尾部
+
+/// <summary>
+/// 第一类零阶修正贝塞尔函数，用于Kaiser窗
+/// </summary>
+double BesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfSquare = x * x / 4.0;
+    for (int k = 1; k < 100; ++k)
+    {
+        term *= halfSquare / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+float DotScalar(const float* coeffs, const float* samples, size_t count)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += coeffs[i] * samples[i];
+    }
+    return sum;
+}
+
+#if AUDIO_X86_SIMD
+float DotSse2(const float* coeffs, const float* samples, size_t count)
+{
+    // 两组累加器隐藏乘加延迟，count为8的倍数
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (size_t i = 0; i < count; i += 8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(coeffs + i), _mm_loadu_ps(samples + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(coeffs + i + 4), _mm_loadu_ps(samples + i + 4)));
+    }
+    __m128 sum = _mm_add_ps(acc0, acc1);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+AUDIO_TARGET_AVX2 float DotAvx2(const float* coeffs, const float* samples, size_t count)
+{
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t i = 0; i < count; i += 8)
+    {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(coeffs + i), _mm256_loadu_ps(samples + i)));
+    }
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+#endif
+} // namespace
+
+ST_ResampleFilterParams PolyphaseResampler::GetFilterParams(EM_ResampleQuality quality)
+{
+    ST_ResampleFilterParams params;
+    switch (quality)
+    {
+        case EM_ResampleQuality::LowPower:
+            params.m_filterSize = 16;
+            params.m_cutoff = 0.91;
+            params.m_kaiserBeta = 6.0;
+            break;
+        case EM_ResampleQuality::High:
+            params.m_filterSize = 64;
+            params.m_cutoff = 0.97;
+            params.m_kaiserBeta = 12.0;
+            break;
+        default:
+            break;
+    }
+    return params;
+}
+
+void PolyphaseResampler::PrecomputeCommonTables(EM_ResampleQuality quality)
+{
+    TIME_START("PolyphasePrecompute");
+    const int commonRates[][2] = {{44100, 48000}, {48000, 44100}, {48000, 96000}, {96000, 48000}, {44100, 88200}, {88200, 44100}};
+    for (const auto& rates : commonRates)
+    {
+        const int divisor = std::gcd(rates[0], rates[1]);
+        GetFilterBank(rates[1] / divisor, rates[0] / divisor, quality);
+    }
+    TimeSystem::Instance().StopTimingWithLog("PolyphasePrecompute", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Polyphase coefficient tables precomputed");
+}
+
+std::shared_ptr<const PolyphaseResampler::ST_FilterBank> PolyphaseResampler::GetFilterBank(int upFactor, int downFactor, EM_ResampleQuality quality)
+{
+    static std::mutex s_cacheMutex;
+    static std::map<std::tuple<int, int, int>, std::shared_ptr<const ST_FilterBank>> s_cache;
+
+    const auto key = std::make_tuple(upFactor, downFactor, static_cast<int>(quality));
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    auto it = s_cache.find(key);
+    if (it != s_cache.end())
+    {
+        return it->second;
+    }
+
+    // 与swr的build_filter相同的设计：截止频率按较低一侧的奈奎斯特频率缩放，降采样时滤波器按比例加长
+    const ST_ResampleFilterParams filterParams = GetFilterParams(quality);
+    const double pi = 3.14159265358979323846;
+    const double factor = std::min(static_cast<double>(upFactor) * filterParams.m_cutoff / downFactor, 1.0);
+    auto bank = std::make_shared<ST_FilterBank>();
+    bank->m_upFactor = upFactor;
+    bank->m_downFactor = downFactor;
+    bank->m_tapCount = std::max(static_cast<int>(std::ceil(filterParams.m_filterSize / factor)), 1);
+    bank->m_tapCount += bank->m_tapCount % 2;
+    bank->m_center = (bank->m_tapCount - 1) / 2;
+    bank->m_paddedTaps = (static_cast<size_t>(bank->m_tapCount) + TAP_ALIGNMENT - 1) / TAP_ALIGNMENT * TAP_ALIGNMENT;
+    bank->m_coeffs.assign(bank->m_paddedTaps * upFactor, 0.0f);
+
+    const double windowNorm = BesselI0(filterParams.m_kaiserBeta);
+    std::vector<double> taps(bank->m_tapCount);
+    for (int phase = 0; phase < upFactor; ++phase)
+    {
+        double norm = 0.0;
+        for (int i = 0; i < bank->m_tapCount; ++i)
+        {
+            const double x = pi * (static_cast<double>(i - bank->m_center) - static_cast<double>(phase) / upFactor) * factor;
+            double y = (x == 0.0) ? 1.0 : std::sin(x) / x;
+            const double w = 2.0 * x / (factor * bank->m_tapCount * pi);
+            y *= BesselI0(filterParams.m_kaiserBeta * std::sqrt(std::max(1.0 - w * w, 0.0))) / windowNorm;
+            taps[i] = y;
+            norm += y;
+        }
+
+        // 每个相位单独归一化，保证直流增益为1
+        float* phaseCoeffs = bank->m_coeffs.data() + bank->m_paddedTaps * phase;
+        for (int i = 0; i < bank->m_tapCount; ++i)
+        {
+            phaseCoeffs[i] = static_cast<float>(taps[i] / norm);
+        }
+    }
+
+    LOG_INFO("Polyphase filter bank built: L=" + std::to_string(upFactor) + ", M=" + std::to_string(downFactor) + ", taps=" + std::to_string(bank->m_tapCount) + ", quality=" + std::to_string(static_cast<int>(quality)));
+    s_cache.emplace(key, bank);
+    return bank;
+}
+
+bool PolyphaseResampler::Init(int inRate, int outRate, AVSampleFormat inFormat, AVSampleFormat outFormat, int channels, EM_ResampleQuality quality)
+{
+    if (inRate <= 0 || outRate <= 0 || channels <= 0)
+    {
+        return false;
+    }
+
+    const int divisor = std::gcd(inRate, outRate);
+    const int upFactor = outRate / divisor;
+    const int downFactor = inRate / divisor;
+    if (upFactor > MAX_PHASES)
+    {
+        LOG_INFO("PolyphaseResampler::Init() : Ratio " + std::to_string(inRate) + "->" + std::to_string(outRate) + " needs too many phases");
+        return false;
+    }
+
+    // 平面浮点输入直接拷贝到各声道历史缓冲区，其余格式先转为交错浮点
+    if ((inFormat != AV_SAMPLE_FMT_FLTP && !m_inputConverter.Init(inFormat, AV_SAMPLE_FMT_FLT, channels)) || !m_outputConverter.Init(AV_SAMPLE_FMT_FLT, outFormat, channels))
+    {
+        return false;
+    }
+
+    m_bank = GetFilterBank(upFactor, downFactor, quality);
+    m_inFormat = inFormat;
+    m_outFormat = outFormat;
+    m_channels = channels;
+    m_history.assign(channels, std::vector<float>());
+
+    switch (GetAudioSimdLevel())
+    {
+#if AUDIO_X86_SIMD
+        case EM_SimdLevel::Avx2:
+            m_dotKernel = &DotAvx2;
+            break;
+        case EM_SimdLevel::Sse2:
+            m_dotKernel = &DotSse2;
+            break;
+#endif
+        default:
+            m_dotKernel = &DotScalar;
+            break;
+    }
+
+    Reset();
+    LOG_INFO("Polyphase resampler: " + std::to_string(inRate) + "Hz -> " + std::to_string(outRate) + "Hz, " + std::to_string(m_bank->m_tapCount) + " taps, " + GetAudioSimdLevelName(GetAudioSimdLevel()));
+    return true;
+}
+
+int PolyphaseResampler::GetMaxOutputSamples(int inputSamples) const
+{
+    if (!m_bank || inputSamples < 0)
+    {
+        return -1;
+    }
+
+    const size_t padding = (inputSamples == 0) ? m_bank->m_paddedTaps : 0;
+    const size_t available = m_historyLength + static_cast<size_t>(inputSamples) + padding;
+    if (available < m_inputIndex + m_bank->m_paddedTaps)
+    {
+        return 0;
+    }
+
+    // 第n个输出样本的窗口起点为 m_inputIndex + (m_phase + n*M) / L，不能超过 available - taps
+    const int64_t maxStart = static_cast<int64_t>(available - m_bank->m_paddedTaps - m_inputIndex);
+    const int64_t limit = (maxStart + 1) * m_bank->m_upFactor - m_phase;
+    return static_cast<int>((limit + m_bank->m_downFactor - 1) / m_bank->m_downFactor);
+}
+
+int PolyphaseResampler::Process(const uint8_t* const* inputData, int inputSamples, uint8_t* output, int maxOutputSamples)
+{
+    if (!m_bank || !inputData || inputSamples < 0 || !output || maxOutputSamples <= 0)
+    {
+        return -1;
+    }
+
+    AppendInput(inputData, inputSamples);
+    return Produce(output, maxOutputSamples);
+}
+
+int PolyphaseResampler::Flush(uint8_t* output, int maxOutputSamples)
+{
+    if (!m_bank || !output || maxOutputSamples <= 0)
+    {
+        return 0;
+    }
+
+    // 末尾补零使最后的输入样本也能位于窗口中心，输出总数按输入总数换算截断
+    AppendSilence(m_bank->m_paddedTaps);
+    const int64_t expectedTotal = (m_totalInput * m_bank->m_upFactor + m_bank->m_downFactor - 1) / m_bank->m_downFactor;
+    const int64_t remaining = std::max<int64_t>(expectedTotal - m_totalOutput, 0);
+    const int produced = Produce(output, static_cast<int>(std::min<int64_t>(remaining, maxOutputSamples)));
+    Reset();
+    return produced;
+}
+
+void PolyphaseResampler::Reset()
+{
+    if (!m_bank)
+    {
+        return;
+    }
+
+    // 窗口中心之前补零，第一个输出样本与第一个输入样本对齐，不引入延迟
+    m_historyLength = static_cast<size_t>(m_bank->m_center);
+    for (std::vector<float>& channelHistory : m_history)
+    {
+        channelHistory.assign(std::max(channelHistory.size(), m_historyLength), 0.0f);
+    }
+    m_inputIndex = 0;
+    m_phase = 0;
+    m_totalInput = 0;
+    m_totalOutput = 0;
+}
+
+int PolyphaseResampler::GetTapCount() const
+{
+    return m_bank ? m_bank->m_tapCount : 0;
+}
+
+void PolyphaseResampler::AppendInput(const uint8_t* const* inputData, int inputSamples)
+{
+    const size_t count = static_cast<size_t>(inputSamples);
+    for (std::vector<float>& channelHistory : m_history)
+    {
+        if (channelHistory.size() < m_historyLength + count)
+        {
+            channelHistory.resize(m_historyLength + count);
+        }
+    }
+
+    if (m_inFormat == AV_SAMPLE_FMT_FLTP)
+    {
+        for (int ch = 0; ch < m_channels; ++ch)
+        {
+            memcpy(m_history[ch].data() + m_historyLength, inputData[ch], count * sizeof(float));
+        }
+    }
+    else
+    {
+        m_inputScratch.resize(count * m_channels);
+        m_inputConverter.Convert(inputData, inputSamples, reinterpret_cast<uint8_t*>(m_inputScratch.data()));
+        for (int ch = 0; ch < m_channels; ++ch)
+        {
+            float* dst = m_history[ch].data() + m_historyLength;
+            const float* src = m_inputScratch.data() + ch;
+            for (size_t i = 0; i < count; ++i)
+            {
+                dst[i] = src[i * m_channels];
+            }
+        }
+    }
+
+    m_historyLength += count;
+    m_totalInput += static_cast<int64_t>(count);
+}
+
+void PolyphaseResampler::AppendSilence(size_t samples)
+{
+    for (std::vector<float>& channelHistory : m_history)
+    {
+        if (channelHistory.size() < m_historyLength + samples)
+        {
+            channelHistory.resize(m_historyLength + samples);
+        }
+        std::fill_n(channelHistory.begin() + m_historyLength, samples, 0.0f);
+    }
+    m_historyLength += samples;
+}
+
+int PolyphaseResampler::Produce(uint8_t* output, int maxOutputSamples)
+{
+    // 浮点输出直接写入调用方空间，其余格式先写入临时缓冲区再转换
+    float* dst = reinterpret_cast<float*>(output);
+    if (m_outFormat != AV_SAMPLE_FMT_FLT)
+    {
+        m_outputScratch.resize(static_cast<size_t>(std::max(maxOutputSamples, 0)) * m_channels);
+        dst = m_outputScratch.data();
+    }
+
+    const ST_FilterBank& bank = *m_bank;
+    int produced = 0;
+    while (produced < maxOutputSamples && m_inputIndex + bank.m_paddedTaps <= m_historyLength)
+    {
+        const float* coeffs = bank.m_coeffs.data() + bank.m_paddedTaps * m_phase;
+        for (int ch = 0; ch < m_channels; ++ch)
+        {
+            *dst++ = m_dotKernel(coeffs, m_history[ch].data() + m_inputIndex, bank.m_paddedTaps);
+        }
+        ++produced;
+
+        m_phase += bank.m_downFactor;
+        m_inputIndex += static_cast<size_t>(m_phase / bank.m_upFactor);
+        m_phase %= bank.m_upFactor;
+    }
+
+    if (m_outFormat != AV_SAMPLE_FMT_FLT && produced > 0)
+    {
+        const uint8_t* scratch = reinterpret_cast<const uint8_t*>(m_outputScratch.data());
+        m_outputConverter.Convert(&scratch, produced, output);
+    }
+    m_totalOutput += produced;
+
+    // 丢弃之后的输出不再需要的输入样本
+    if (m_inputIndex > 0)
+    {
+        const size_t discard = std::min(m_inputIndex, m_historyLength);
+        for (std::vector<float>& channelHistory : m_history)
+        {
+            memmove(channelHistory.data(), channelHistory.data() + discard, (m_historyLength - discard) * sizeof(float));
+        }
+        m_historyLength -= discard;
+        m_inputIndex -= discard;
+    }
+    return produced;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AudioSampleConverter.h"
+
+extern "C"
+{
+#include <libavutil/samplefmt.h>
+}
+
+/// <summary>
+/// 重采样质量预设
+/// </summary>
+enum class EM_ResampleQuality
+{
+    LowPower, /// 低功耗：短滤波器，适合播放
+    Balanced, /// 均衡：与swr默认参数一致
+    High      /// 高质量：长滤波器、高阻带衰减，适合离线处理
+};
+
+/// <summary>
+/// 重采样滤波器参数，swr和多相重采样器使用同一组参数，便于在相同设置下对比
+/// </summary>
+struct ST_ResampleFilterParams
+{
+    int m_filterSize{32};       /// 滤波器长度（升采样时的抽头数，降采样时按比例加长，与swr的filter_size含义相同）
+    double m_cutoff{0.97};      /// 截止频率（相对较低一侧的奈奎斯特频率）
+    double m_kaiserBeta{9.0};   /// Kaiser窗参数，越大阻带衰减越高、过渡带越宽
+};
+
+/// <summary>
+/// 加窗sinc多相重采样器
+/// 按输入输出采样率的最简比L/M为每个相位预先计算一组滤波系数（按比例和质量缓存共享），
+/// 每个输出样本只需一次相位系数与输入窗口的点积，点积按CPU支持情况使用AVX2、SSE2或标量实现；
+/// 内部按声道以32位浮点处理，输入输出格式转换由AudioSampleConverter完成
+/// </summary>
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler() = default;
+    ~PolyphaseResampler() = default;
+
+    PolyphaseResampler(const PolyphaseResampler&) = delete;
+    PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+    /// <summary>
+    /// 获取质量预设对应的滤波器参数
+    /// </summary>
+    static ST_ResampleFilterParams GetFilterParams(EM_ResampleQuality quality);
+
+    /// <summary>
+    /// 预先计算常用比例（44.1k↔48k、48k↔96k、44.1k↔88.2k）的系数表，避免首次打开文件时计算
+    /// </summary>
+    /// <param name="quality">质量预设</param>
+    static void PrecomputeCommonTables(EM_ResampleQuality quality);
+
+    /// <summary>
+    /// 初始化
+    /// </summary>
+    /// <param name="inRate">输入采样率</param>
+    /// <param name="outRate">输出采样率</param>
+    /// <param name="inFormat">输入采样格式（交错或平面）</param>
+    /// <param name="outFormat">输出采样格式（交错）</param>
+    /// <param name="channels">声道数（输入输出相同，不做声道混合）</param>
+    /// <param name="quality">质量预设</param>
+    /// <returns>比例或格式不支持时返回false，调用方应回退到swr</returns>
+    bool Init(int inRate, int outRate, AVSampleFormat inFormat, AVSampleFormat outFormat, int channels, EM_ResampleQuality quality);
+
+    /// <summary>
+    /// 获取输入指定样本数后可输出的样本数
+    /// </summary>
+    /// <param name="inputSamples">输入样本数，0表示刷新</param>
+    int GetMaxOutputSamples(int inputSamples) const;
+
+    /// <summary>
+    /// 重采样并写入交错输出
+    /// </summary>
+    /// <param name="inputData">输入数据，平面格式时每个声道一个指针</param>
+    /// <param name="inputSamples">输入样本数</param>
+    /// <param name="output">输出空间</param>
+    /// <param name="maxOutputSamples">输出空间可容纳的样本数</param>
+    /// <returns>实际输出的样本数</returns>
+    int Process(const uint8_t* const* inputData, int inputSamples, uint8_t* output, int maxOutputSamples);
+
+    /// <summary>
+    /// 输入结束，输出剩余样本
+    /// </summary>
+    /// <param name="output">输出空间</param>
+    /// <param name="maxOutputSamples">输出空间可容纳的样本数</param>
+    /// <returns>实际输出的样本数</returns>
+    int Flush(uint8_t* output, int maxOutputSamples);
+
+    /// <summary>
+    /// 丢弃缓存的输入样本（seek后调用）
+    /// </summary>
+    void Reset();
+
+    /// <summary>
+    /// 获取每个输出样本的滤波器抽头数
+    /// </summary>
+    int GetTapCount() const;
+
+private:
+    struct ST_FilterBank;
+
+    /// <summary>
+    /// 获取（必要时计算并缓存）指定比例和质量的系数表
+    /// </summary>
+    /// <param name="upFactor">升采样因子L（输出采样率/最大公约数）</param>
+    /// <param name="downFactor">降采样因子M（输入采样率/最大公约数）</param>
+    /// <param name="quality">质量预设</param>
+    static std::shared_ptr<const ST_FilterBank> GetFilterBank(int upFactor, int downFactor, EM_ResampleQuality quality);
+
+    /// <summary>
+    /// 将输入转换为浮点并追加到各声道的历史缓冲区
+    /// </summary>
+    void AppendInput(const uint8_t* const* inputData, int inputSamples);
+
+    /// <summary>
+    /// 在各声道的历史缓冲区末尾追加静音
+    /// </summary>
+    void AppendSilence(size_t samples);
+
+    /// <summary>
+    /// 计算窗口内可用的输出样本，写入交错输出后丢弃不再需要的输入
+    /// </summary>
+    int Produce(uint8_t* output, int maxOutputSamples);
+
+private:
+    static const int MAX_PHASES{1024};          /// 支持的最大相位数（最简比的L）
+
+    using DotKernel = float (*)(const float* coeffs, const float* samples, size_t count);
+
+    std::shared_ptr<const ST_FilterBank> m_bank;    /// 系数表
+    DotKernel m_dotKernel{nullptr};                 /// 点积实现
+    AudioSampleConverter m_inputConverter;          /// 输入格式→交错浮点
+    AudioSampleConverter m_outputConverter;         /// 交错浮点→输出格式
+    AVSampleFormat m_inFormat{AV_SAMPLE_FMT_NONE};  /// 输入采样格式
+    AVSampleFormat m_outFormat{AV_SAMPLE_FMT_NONE}; /// 输出采样格式
+    int m_channels{0};                              /// 声道数
+    std::vector<std::vector<float>> m_history;      /// 各声道的输入历史
+    size_t m_historyLength{0};                      /// 历史缓冲区中的有效样本数
+    size_t m_inputIndex{0};                         /// 下一个输出样本的窗口起点
+    int m_phase{0};                                 /// 下一个输出样本的相位
+    int64_t m_totalInput{0};                        /// 累计输入样本数
+    int64_t m_totalOutput{0};                       /// 累计输出样本数
+    std::vector<float> m_inputScratch;              /// 输入转换的临时缓冲区
+    std::vector<float> m_outputScratch;             /// 输出转换的临时缓冲区
+};
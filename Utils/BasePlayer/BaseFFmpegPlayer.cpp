@@ -29,6 +29,7 @@ bool BaseFFmpegPlayer::IsRecording()
 
 double BaseFFmpegPlayer::GetDuration()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     return m_duration;
 }
 
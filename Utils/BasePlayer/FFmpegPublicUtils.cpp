@@ -1,11 +1,22 @@
 #include "FFmpegPublicUtils.h"
+#include <chrono>
 #include <qDebug>
 #include <QFileInfo>
+#include <random>
 #include <string>
 #include <unordered_map>
+#include "BaseDataDefine/ST_AVCodec.h"
+#include "BaseDataDefine/ST_AVFrame.h"
+#include "BaseDataDefine/ST_AVPacket.h"
 #include "FileSystem/FileSystem.h"
 #include "LogSystem/LogSystem.h"
 #include "SDL3/SDL_init.h"
+#include "SDL3/SDL_audio.h"
+
+extern "C"
+{
+#include <libswresample/swresample.h>
+}
 
 const AVCodec* FFmpegPublicUtils::FindEncoder(const char* formatName)
 {
@@ -669,3 +680,317 @@ bool FFmpegPublicUtils::GetMediaFileInfo(const QString& filePath, QString& fileN
 
     return true;
 }
+
+bool FFmpegPublicUtils::BenchmarkInputIO(const QString& filePath, int seekCount)
+{
+    if (!ValidateFilePath(filePath))
+    {
+        return false;
+    }
+
+    struct ST_IOModeCase
+    {
+        EM_InputIOMode m_mode;
+        const char* m_name;
+    };
+    const ST_IOModeCase ioModes[] = {{EM_InputIOMode::FFmpegDefault, "ffmpeg file protocol"}, {EM_InputIOMode::ReadAhead, "read-ahead"}, {EM_InputIOMode::MemoryMapped, "memory mapped"}};
+
+    bool bAllSucceeded = true;
+    for (const ST_IOModeCase& ioMode : ioModes)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto openStart = Clock::now();
+        ST_AVFormatContext formatCtx;
+        if (!formatCtx.OpenInputFilePath(filePath.toUtf8().constData(), nullptr, nullptr, ioMode.m_mode) || avformat_find_stream_info(formatCtx.GetRawContext(), nullptr) < 0)
+        {
+            LOG_WARN("BenchmarkInputIO() : Failed to open file with " + std::string(ioMode.m_name) + ": " + filePath.toStdString());
+            bAllSucceeded = false;
+            continue;
+        }
+        double openMs = std::chrono::duration<double, std::milli>(Clock::now() - openStart).count();
+
+        // 顺序读取全部数据包
+        AVPacket* packet = av_packet_alloc();
+        int64_t totalBytes = 0;
+        int64_t packetCount = 0;
+        auto readStart = Clock::now();
+        while (av_read_frame(formatCtx.GetRawContext(), packet) >= 0)
+        {
+            totalBytes += packet->size;
+            ++packetCount;
+            av_packet_unref(packet);
+        }
+        double readMs = std::chrono::duration<double, std::milli>(Clock::now() - readStart).count();
+
+        // 随机seek后读取一个数据包，各方式使用相同的seek序列
+        std::mt19937 random(12345);
+        const int64_t duration = formatCtx.GetRawContext()->duration > 0 ? formatCtx.GetRawContext()->duration : 0;
+        auto seekStart = Clock::now();
+        for (int i = 0; i < seekCount && duration > 0; i++)
+        {
+            int64_t target = static_cast<int64_t>(random() % static_cast<uint64_t>(duration));
+            if (av_seek_frame(formatCtx.GetRawContext(), -1, target, AVSEEK_FLAG_BACKWARD) >= 0 && av_read_frame(formatCtx.GetRawContext(), packet) >= 0)
+            {
+                av_packet_unref(packet);
+            }
+        }
+        double seekMs = std::chrono::duration<double, std::milli>(Clock::now() - seekStart).count();
+        av_packet_free(&packet);
+
+        double throughputMBps = readMs > 0.0 ? (totalBytes / (1024.0 * 1024.0)) / (readMs / 1000.0) : 0.0;
+        LOG_INFO("Input IO benchmark [" + std::string(ioMode.m_name) + "] " + filePath.toStdString() + ": open " + std::to_string(openMs) + " ms, read " + std::to_string(packetCount) + " packets / " + std::to_string(totalBytes) + " bytes in " + std::to_string(readMs) + " ms (" + std::to_string(throughputMBps) + " MB/s), " + std::to_string(seekCount) + " seeks in " + std::to_string(seekMs) + " ms");
+    }
+    return bAllSucceeded;
+}
+
+bool FFmpegPublicUtils::BenchmarkDecodeThreads(const QString& filePath, int maxFrames)
+{
+    if (!ValidateFilePath(filePath) || maxFrames <= 0)
+    {
+        return false;
+    }
+
+    ST_AVFormatContext formatCtx;
+    if (!formatCtx.OpenInputFilePath(filePath.toUtf8().constData()) || avformat_find_stream_info(formatCtx.GetRawContext(), nullptr) < 0)
+    {
+        LOG_WARN("BenchmarkDecodeThreads() : Failed to open file: " + filePath.toStdString());
+        return false;
+    }
+
+    int videoStreamIndex = formatCtx.FindBestStream(AVMEDIA_TYPE_VIDEO);
+    if (videoStreamIndex < 0)
+    {
+        LOG_WARN("BenchmarkDecodeThreads() : No video stream found: " + filePath.toStdString());
+        return false;
+    }
+    const AVCodecParameters* codecPar = formatCtx.GetRawContext()->streams[videoStreamIndex]->codecpar;
+    ST_AVCodec decoder(codecPar->codec_id);
+    if (!decoder.GetRawCodec())
+    {
+        LOG_WARN("BenchmarkDecodeThreads() : Decoder not found for codec ID: " + std::to_string(codecPar->codec_id));
+        return false;
+    }
+
+    // 预先读入数据包，各配置只统计解码耗时
+    std::vector<ST_AVPacket> packets;
+    ST_AVPacket packet;
+    while (static_cast<int>(packets.size()) < maxFrames && packet.ReadPacket(formatCtx.GetRawContext()))
+    {
+        if (packet.GetStreamIndex() == videoStreamIndex)
+        {
+            packets.push_back(std::move(packet));
+            packet = ST_AVPacket();
+        }
+        else
+        {
+            packet.UnrefPacket();
+        }
+    }
+    if (packets.empty())
+    {
+        LOG_WARN("BenchmarkDecodeThreads() : No video packets read: " + filePath.toStdString());
+        return false;
+    }
+
+    struct ST_ThreadCase
+    {
+        ST_DecodeThreadPolicy m_policy;
+        const char* m_name;
+    };
+    std::vector<ST_ThreadCase> threadCases;
+    threadCases.push_back({{1, EM_DecodeThreadType::Auto, false}, "single"});
+    for (int threadCount : {2, 4, 8, 16, 0})
+    {
+        threadCases.push_back({{threadCount, EM_DecodeThreadType::Frame, false}, "frame"});
+        threadCases.push_back({{threadCount, EM_DecodeThreadType::Slice, false}, "slice"});
+    }
+    threadCases.push_back({{0, EM_DecodeThreadType::Auto, true}, "low latency"});
+
+    bool bAllSucceeded = true;
+    for (const ST_ThreadCase& threadCase : threadCases)
+    {
+        ST_AVCodecContext codecCtx(decoder.GetRawCodec());
+        codecCtx.SetThreadPolicy(threadCase.m_policy);
+        if (!codecCtx.BindParamToContext(codecPar) || !codecCtx.OpenCodec(decoder.GetRawCodec()))
+        {
+            LOG_WARN("BenchmarkDecodeThreads() : Failed to open decoder for " + std::string(threadCase.m_name) + " threading");
+            bAllSucceeded = false;
+            continue;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        ST_AVFrame frame;
+        int64_t decodedFrames = 0;
+        auto decodeStart = Clock::now();
+        for (ST_AVPacket& videoPacket : packets)
+        {
+            if (avcodec_send_packet(codecCtx.GetRawContext(), videoPacket.GetRawPacket()) < 0)
+            {
+                continue;
+            }
+            while (frame.GetCodecFrame(codecCtx.GetRawContext()))
+            {
+                ++decodedFrames;
+            }
+        }
+        // 取出帧级并行缓存在各线程中的帧
+        avcodec_send_packet(codecCtx.GetRawContext(), nullptr);
+        while (frame.GetCodecFrame(codecCtx.GetRawContext()))
+        {
+            ++decodedFrames;
+        }
+        double decodeMs = std::chrono::duration<double, std::milli>(Clock::now() - decodeStart).count();
+
+        double fps = decodeMs > 0.0 ? decodedFrames / (decodeMs / 1000.0) : 0.0;
+        LOG_INFO("Decode thread benchmark [" + std::string(threadCase.m_name) + ", requested " + (threadCase.m_policy.m_threadCount > 0 ? std::to_string(threadCase.m_policy.m_threadCount) : std::string("auto")) + " threads, active " + std::to_string(codecCtx.GetRawContext()->thread_count) + "] " + filePath.toStdString() + ": "
+                 + std::to_string(decodedFrames) + " frames in " + std::to_string(decodeMs) + " ms (" + std::to_string(fps) + " fps)");
+    }
+    return bAllSucceeded;
+}
+
+bool FFmpegPublicUtils::BenchmarkAudioResample(const QString& filePath, int deviceSampleRate)
+{
+    if (!ValidateFilePath(filePath) || deviceSampleRate <= 0)
+    {
+        return false;
+    }
+
+    struct ST_ConvertCase
+    {
+        bool m_bConvert;
+        bool m_bDeviceRate;
+        const char* m_name;
+    };
+    // 保留源采样率时播放器把源采样率数据交给SDL音频流，由SDL转换到设备采样率，该开销一并计入
+    const ST_ConvertCase convertCases[] = {{false, false, "decode only"}, {true, false, "source rate + SDL stream"}, {true, true, "device rate"}};
+    double msPerHour[3] = {0.0, 0.0, 0.0};
+
+    bool bAllSucceeded = true;
+    for (int caseIndex = 0; caseIndex < 3; ++caseIndex)
+    {
+        const ST_ConvertCase& convertCase = convertCases[caseIndex];
+        ST_OpenFileResult openFileResult;
+        if (!openFileResult.OpenFilePath(filePath) || !openFileResult.m_codecCtx)
+        {
+            LOG_WARN("BenchmarkAudioResample() : Failed to open audio stream: " + filePath.toStdString());
+            return false;
+        }
+        AVFormatContext* formatCtx = openFileResult.m_formatCtx->GetRawContext();
+        AVCodecContext* codecCtx = openFileResult.m_codecCtx->GetRawContext();
+        const int sourceSampleRate = codecCtx->sample_rate;
+
+        // 与播放器协商的输出格式一致：交错格式，SDL不支持的格式转为32位浮点
+        AVSampleFormat outFormat = av_get_packed_sample_fmt(codecCtx->sample_fmt);
+        if (outFormat != AV_SAMPLE_FMT_U8 && outFormat != AV_SAMPLE_FMT_S16 && outFormat != AV_SAMPLE_FMT_S32 && outFormat != AV_SAMPLE_FMT_FLT)
+        {
+            outFormat = AV_SAMPLE_FMT_FLT;
+        }
+        const int outSampleRate = convertCase.m_bDeviceRate ? deviceSampleRate : sourceSampleRate;
+        const int outFrameBytes = av_get_bytes_per_sample(outFormat) * codecCtx->ch_layout.nb_channels;
+
+        SwrContext* swrCtx = nullptr;
+        if (convertCase.m_bConvert && (swr_alloc_set_opts2(&swrCtx, &codecCtx->ch_layout, outFormat, outSampleRate, &codecCtx->ch_layout, codecCtx->sample_fmt, sourceSampleRate, 0, nullptr) < 0 || swr_init(swrCtx) < 0))
+        {
+            LOG_WARN("BenchmarkAudioResample() : Failed to init swr for " + std::string(convertCase.m_name));
+            swr_free(&swrCtx);
+            bAllSucceeded = false;
+            continue;
+        }
+
+        SDL_AudioStream* sdlStream = nullptr;
+        if (convertCase.m_bConvert && !convertCase.m_bDeviceRate && sourceSampleRate != deviceSampleRate)
+        {
+            const SDL_AudioSpec sourceSpec{FFmpegToSDLFormat(outFormat), codecCtx->ch_layout.nb_channels, sourceSampleRate};
+            const SDL_AudioSpec deviceSpec{FFmpegToSDLFormat(outFormat), codecCtx->ch_layout.nb_channels, deviceSampleRate};
+            sdlStream = SDL_CreateAudioStream(&sourceSpec, &deviceSpec);
+            if (!sdlStream)
+            {
+                LOG_WARN("BenchmarkAudioResample() : Failed to create SDL audio stream: " + std::string(SDL_GetError()));
+                swr_free(&swrCtx);
+                bAllSucceeded = false;
+                continue;
+            }
+        }
+
+        using Clock = std::chrono::steady_clock;
+        std::vector<uint8_t> outBuffer;
+        std::vector<uint8_t> deviceBuffer;
+        ST_AVPacket packet;
+        ST_AVFrame frame;
+        int64_t decodedSamples = 0;
+        // 取出SDL音频流转换后的数据，与音频设备从流中取数据的开销一致
+        auto drainStream = [&]()
+        {
+            int availableBytes = SDL_GetAudioStreamAvailable(sdlStream);
+            if (availableBytes > 0)
+            {
+                deviceBuffer.resize(static_cast<size_t>(availableBytes));
+                SDL_GetAudioStreamData(sdlStream, deviceBuffer.data(), availableBytes);
+            }
+        };
+        auto receiveFrames = [&]()
+        {
+            while (frame.GetCodecFrame(codecCtx))
+            {
+                AVFrame* rawFrame = frame.GetRawFrame();
+                decodedSamples += rawFrame->nb_samples;
+                if (!swrCtx)
+                {
+                    continue;
+                }
+
+                int maxOutSamples = swr_get_out_samples(swrCtx, rawFrame->nb_samples);
+                if (maxOutSamples <= 0)
+                {
+                    continue;
+                }
+                outBuffer.resize(static_cast<size_t>(maxOutSamples) * outFrameBytes);
+                uint8_t* outData[1] = {outBuffer.data()};
+                int outSamples = swr_convert(swrCtx, outData, maxOutSamples, const_cast<const uint8_t**>(rawFrame->extended_data), rawFrame->nb_samples);
+                if (sdlStream && outSamples > 0)
+                {
+                    SDL_PutAudioStreamData(sdlStream, outBuffer.data(), outSamples * outFrameBytes);
+                    drainStream();
+                }
+            }
+        };
+
+        auto decodeStart = Clock::now();
+        while (packet.ReadPacket(formatCtx))
+        {
+            if (packet.GetStreamIndex() == openFileResult.m_audioStreamIdx && avcodec_send_packet(codecCtx, packet.GetRawPacket()) >= 0)
+            {
+                receiveFrames();
+            }
+            packet.UnrefPacket();
+        }
+        avcodec_send_packet(codecCtx, nullptr);
+        receiveFrames();
+        if (sdlStream)
+        {
+            SDL_FlushAudioStream(sdlStream);
+            drainStream();
+        }
+        double decodeMs = std::chrono::duration<double, std::milli>(Clock::now() - decodeStart).count();
+        swr_free(&swrCtx);
+        SDL_DestroyAudioStream(sdlStream);
+
+        double audioHours = sourceSampleRate > 0 ? static_cast<double>(decodedSamples) / sourceSampleRate / 3600.0 : 0.0;
+        if (audioHours <= 0.0)
+        {
+            LOG_WARN("BenchmarkAudioResample() : No audio decoded: " + filePath.toStdString());
+            return false;
+        }
+        msPerHour[caseIndex] = decodeMs / audioHours;
+        LOG_INFO("Audio resample benchmark [" + std::string(convertCase.m_name) + ", " + std::to_string(sourceSampleRate) + " Hz -> " + (convertCase.m_bConvert ? std::to_string(outSampleRate) + " Hz " + av_get_sample_fmt_name(outFormat) + (sdlStream ? " -> SDL " + std::to_string(deviceSampleRate) + " Hz" : std::string()) : std::string("none")) + "] "
+                 + filePath.toStdString() + ": " + std::to_string(decodeMs) + " ms for " + std::to_string(audioHours * 3600.0) + " s of audio, " + std::to_string(msPerHour[caseIndex]) + " ms per hour of audio");
+    }
+
+    if (bAllSucceeded)
+    {
+        // 差值为负表示交给SDL转换比解码侧重采样更慢
+        LOG_INFO("Audio resample benchmark " + filePath.toStdString() + ": keeping the source rate (including SDL stream conversion) saves " + std::to_string(msPerHour[2] - msPerHour[1]) + " ms of CPU per hour of audio versus resampling to " + std::to_string(deviceSampleRate) + " Hz in the decoder (conversion overhead over decode: source rate + SDL "
+                 + std::to_string(msPerHour[1] - msPerHour[0]) + " ms, device rate " + std::to_string(msPerHour[2] - msPerHour[0]) + " ms)");
+    }
+    return bAllSucceeded;
+}
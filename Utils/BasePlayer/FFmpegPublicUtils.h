@@ -226,4 +226,31 @@ public:
     static bool GetMediaFileInfo(const QString& filePath, QString& fileName, qint64& fileSize, 
                                 double& duration, QString& format, int& bitrate, 
                                 int& width, int& height, int& sampleRate, int& channels);
+
+    /// <summary>
+    /// 输入IO方式基准测试：分别用FFmpeg默认file协议、后台预读和内存映射打开文件，
+    /// 统计打开探测、顺序读取全部数据包和随机seek的耗时并写入日志
+    /// </summary>
+    /// <param name="filePath">文件路径（建议使用大体积的FLAC和MKV文件）</param>
+    /// <param name="seekCount">随机seek次数</param>
+    /// <returns>是否全部方式都测试成功</returns>
+    static bool BenchmarkInputIO(const QString& filePath, int seekCount = 50);
+
+    /// <summary>
+    /// 视频解码线程基准测试：按不同线程数和多线程方式（帧级、片级、低延迟）解码文件开头的视频帧，
+    /// 统计解码帧率并写入日志
+    /// </summary>
+    /// <param name="filePath">文件路径（建议使用4K H.264和HEVC样片）</param>
+    /// <param name="maxFrames">每种配置最多解码的帧数</param>
+    /// <returns>是否全部配置都测试成功</returns>
+    static bool BenchmarkDecodeThreads(const QString& filePath, int maxFrames = 600);
+
+    /// <summary>
+    /// 音频输出转换基准测试：完整解码文件的音频流，分别统计只解码、按源采样率转换为交错格式后由SDL音频流转换到设备采样率、
+    /// 解码侧重采样到设备采样率三种方式的耗时，折算为每小时音频的耗时并写入日志，比较保留源采样率的实际CPU开销
+    /// </summary>
+    /// <param name="filePath">文件路径（建议使用48kHz的AAC文件）</param>
+    /// <param name="deviceSampleRate">模拟的设备采样率</param>
+    /// <returns>是否全部方式都测试成功</returns>
+    static bool BenchmarkAudioResample(const QString& filePath, int deviceSampleRate = 44100);
 };
@@ -2,8 +2,11 @@
 #include <QFileInfo>
 #include <QMutexLocker>
 #include "AVFileSystem.h"
+#include "BaseDataDefine/ST_StreamInfoCache.h"
+#include "CoreServerGlobal.h"
 #include "FileSystem/FileSystem.h"
 #include "LogSystem/LogSystem.h"
+#include "TimeSystem/TimeSystem.h"
 
 extern "C"
 {
@@ -37,6 +40,12 @@ MediaPlayerManager::MediaPlayerManager(QObject* parent)
     m_audioPlayer = std::make_unique<AudioFFmpegPlayer>(this);
     m_videoPlayer = std::make_unique<VideoFFmpegPlayer>(this);
     
+    // 进度条拖动时合并seek请求
+    m_seekTimer = new QTimer(this);
+    m_seekTimer->setSingleShot(true);
+    m_seekTimer->setInterval(SEEK_COALESCE_INTERVAL_MS);
+    connect(m_seekTimer, &QTimer::timeout, this, &MediaPlayerManager::OnSeekTimer);
+
     // 连接信号槽
     ConnectPlayerSignals();
 
@@ -64,11 +73,18 @@ MediaPlayerManager::~MediaPlayerManager()
     
     m_currentMediaType = EM_MediaType::Unknown;
     m_currentFilePath.clear();
+    m_audioDuration = 0.0;
 }
 
 void MediaPlayerManager::ConnectPlayerSignals()
 {
     connect(m_audioPlayer.get(), &AudioFFmpegPlayer::SigAudioPlayerFinished, this, &MediaPlayerManager::SigPlayerFinished);
+    connect(m_audioPlayer.get(), &AudioFFmpegPlayer::SigAudioTrackChanged, this, [this](const QString& filePath)
+    {
+        m_currentFilePath = filePath;
+        m_audioDuration = m_audioPlayer->GetDuration();
+        emit SigTrackChanged(filePath);
+    });
 }
 
 void MediaPlayerManager::ResizeVideoWindows(int width, int height)
@@ -110,6 +126,7 @@ bool MediaPlayerManager::PlayMedia(const QString& filePath, double startPosition
             m_audioPlayer->StartPlay(filePath, true, startPosition, args);
             success = true;
             m_currentMediaType = EM_MediaType::Audio;
+            m_audioDuration = m_audioPlayer->GetDuration();
         }
     }
     else if (mediaType == EM_MediaType::Video)
@@ -147,6 +164,156 @@ bool MediaPlayerManager::PlayMedia(const QString& filePath, double startPosition
     return success;
 }
 
+void MediaPlayerManager::PlayMediaAsync(const QString& filePath, double startPosition, const QStringList& args)
+{
+    // 新请求使尚未完成的请求失效；当前播放由UI线程停止，没有请求在准备时停止不会等待打开文件
+    CancelPendingPlayRequest();
+    ResetPendingSeek();
+    StopCurrentPlayer();
+    m_currentMediaType = EM_MediaType::Unknown;
+    m_currentFilePath.clear();
+    m_audioDuration = 0.0;
+
+    if (filePath.isEmpty())
+    {
+        LOG_WARN("MediaPlayerManager::PlayMediaAsync() : Empty file path");
+        emit SigMediaPlayFailed(filePath);
+        return;
+    }
+
+    uint64_t requestId = ++m_playRequestId;
+    m_bLoading = true;
+    LOG_INFO("Queued media play request " + std::to_string(requestId) + ": " + filePath.toStdString());
+    CoreServerGlobal::Instance().GetThreadPool().Submit([this, requestId, filePath, startPosition, args]()
+    {
+        ExecutePlayRequest(requestId, filePath, startPosition, args);
+    }, EM_TaskPriority::Normal);
+}
+
+bool MediaPlayerManager::IsLoading() const
+{
+    return m_bLoading;
+}
+
+void MediaPlayerManager::ExecutePlayRequest(uint64_t requestId, const QString& filePath, double startPosition, const QStringList& args)
+{
+    std::lock_guard<std::mutex> requestLock(m_playRequestMutex);
+    if (requestId != m_playRequestId.load())
+    {
+        LOG_INFO("Skipping superseded media play request " + std::to_string(requestId));
+        return;
+    }
+
+    // 请求串行执行，计时名称不会冲突
+    TIME_START("MediaPlayRequest");
+
+    // 检测媒体类型（视频需要探测流信息）
+    EM_MediaType mediaType = DetectMediaType(filePath);
+    bool bAudioStarted = false;
+    auto videoFile = std::make_shared<std::unique_ptr<ST_OpenFileResult>>();
+    double audioDuration = 0.0;
+
+    // 音频播放器只操作SDL音频和解码线程，可在工作线程中启动
+    if (mediaType == EM_MediaType::Audio || mediaType == EM_MediaType::VideoWithAudio)
+    {
+        m_audioPlayer->StartPlay(filePath, true, startPosition, args);
+        bAudioStarted = m_audioPlayer->IsPlaying();
+        if (!bAudioStarted)
+        {
+            mediaType = EM_MediaType::Unknown;
+        }
+        audioDuration = m_audioPlayer->GetDuration();
+    }
+    else
+    {
+        // 之前被取消的请求可能已启动音频
+        m_audioPlayer->StopPlay();
+    }
+
+    // 视频播放器需要在UI线程创建窗口，这里只打开文件和探测流信息
+    if (mediaType == EM_MediaType::Video || mediaType == EM_MediaType::VideoWithAudio)
+    {
+        *videoFile = std::make_unique<ST_OpenFileResult>();
+        (*videoFile)->OpenFilePath(filePath);
+        if (!(*videoFile)->m_formatCtx || !(*videoFile)->m_formatCtx->GetRawContext())
+        {
+            LOG_WARN("MediaPlayerManager::ExecutePlayRequest() : Failed to open video file: " + filePath.toStdString());
+            videoFile->reset();
+            mediaType = EM_MediaType::Unknown;
+        }
+    }
+
+    // 准备期间已被新的请求取代：停止本请求启动的音频，新的请求在本任务之后执行
+    if (requestId != m_playRequestId.load() || mediaType == EM_MediaType::Unknown)
+    {
+        if (bAudioStarted)
+        {
+            m_audioPlayer->StopPlay();
+        }
+    }
+
+    TimeSystem::Instance().StopTimingWithLog("MediaPlayRequest", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, "Media play request " + std::to_string(requestId) + " prepared off the UI thread");
+    // 音轨路径和时长随完成通知交给UI线程，UI线程不读取工作线程正在写入的播放器状态
+    QMetaObject::invokeMethod(this, [this, requestId, filePath, mediaType, startPosition, audioDuration, videoFile]()
+    {
+        OnPlayRequestPrepared(requestId, filePath, mediaType, startPosition, audioDuration, videoFile);
+    }, Qt::QueuedConnection);
+}
+
+void MediaPlayerManager::OnPlayRequestPrepared(uint64_t requestId, const QString& filePath, EM_MediaType mediaType, double startPosition, double audioDuration, std::shared_ptr<std::unique_ptr<ST_OpenFileResult>> videoFile)
+{
+    // 过期的请求已由准备任务或取消任务清理
+    if (requestId != m_playRequestId.load())
+    {
+        return;
+    }
+    m_bLoading = false;
+
+    if ((mediaType == EM_MediaType::Video || mediaType == EM_MediaType::VideoWithAudio) && !m_videoPlayer->StartPlayWithOpenedFile(filePath, std::move(*videoFile), startPosition))
+    {
+        if (mediaType == EM_MediaType::VideoWithAudio)
+        {
+            m_audioPlayer->StopPlay();
+        }
+        mediaType = EM_MediaType::Unknown;
+    }
+
+    if (mediaType == EM_MediaType::Unknown)
+    {
+        LOG_WARN("Failed to start media playback: " + filePath.toStdString());
+        emit SigMediaPlayFailed(filePath);
+        return;
+    }
+
+    m_currentMediaType = mediaType;
+    m_currentFilePath = filePath;
+    m_audioDuration = audioDuration;
+    LOG_INFO("Media playback started successfully: " + filePath.toStdString() + ", type: " + std::to_string(static_cast<int>(mediaType)));
+    emit SigMediaPlayStarted(filePath, startPosition);
+}
+
+void MediaPlayerManager::CancelPendingPlayRequest()
+{
+    if (!m_bLoading)
+    {
+        return;
+    }
+
+    m_bLoading = false;
+    uint64_t cancelId = ++m_playRequestId;
+    LOG_INFO("Cancelling pending media play request");
+
+    // 准备任务可能已启动音频且结果尚未投递，排在其后停止；期间又有新请求时由新请求接管
+    CoreServerGlobal::Instance().GetThreadPool().Submit([this, cancelId]()
+    {
+        std::lock_guard<std::mutex> requestLock(m_playRequestMutex);
+        if (cancelId == m_playRequestId.load())
+        {
+            m_audioPlayer->StopPlay();
+        }
+    }, EM_TaskPriority::Normal);
+}
+
 void MediaPlayerManager::PausePlay()
 {
     if (m_currentMediaType == EM_MediaType::Audio && m_audioPlayer)
@@ -197,25 +364,100 @@ void MediaPlayerManager::ResumePlay()
 
 void MediaPlayerManager::StopPlay()
 {
+    CancelPendingPlayRequest();
+    ResetPendingSeek();
     StopCurrentPlayer();
     m_currentMediaType = EM_MediaType::Unknown;
     m_currentFilePath.clear();
+    m_audioDuration = 0.0;
 }
 
 void MediaPlayerManager::SeekPlay(double seconds)
 {
-    LOG_INFO("MediaPlayerManager::SeekPlay - Seek to " + std::to_string(seconds) + " seconds");
-    
+    // 直接定位时丢弃尚未执行的拖动请求
+    ResetPendingSeek();
+    ExecuteSeek(seconds, true);
+}
+
+void MediaPlayerManager::RequestSeek(double seconds)
+{
+    m_pendingSeekSeconds = seconds;
+    m_bSeekPending = true;
+    if (!m_seekTimer->isActive())
+    {
+        m_seekTimer->start();
+    }
+}
+
+void MediaPlayerManager::BeginSeekDrag()
+{
+    m_bSeekDragging = true;
+}
+
+void MediaPlayerManager::EndSeekDrag()
+{
+    m_bSeekDragging = false;
+
+    // 松开时可能还会产生最后一次位置变化，合并间隔到期后再对最后的目标执行精确定位
+    if ((m_bPreviewSeeked || m_bSeekPending) && !m_seekTimer->isActive())
+    {
+        m_seekTimer->start();
+    }
+}
+
+void MediaPlayerManager::OnSeekTimer()
+{
+    if (m_bSeekPending)
+    {
+        // 合并间隔内只执行最新的目标；拖动中使用关键帧预览，避免逐帧解码到目标
+        m_bSeekPending = false;
+        ExecuteSeek(m_pendingSeekSeconds, !m_bSeekDragging);
+        m_bPreviewSeeked = m_bSeekDragging;
+    }
+    else if (m_bPreviewSeeked && !m_bSeekDragging)
+    {
+        // 拖动结束后对最后的目标执行一次精确定位
+        m_bPreviewSeeked = false;
+        ExecuteSeek(m_pendingSeekSeconds, true);
+    }
+}
+
+void MediaPlayerManager::ResetPendingSeek()
+{
+    m_seekTimer->stop();
+    m_bSeekPending = false;
+    m_bPreviewSeeked = false;
+}
+
+void MediaPlayerManager::ExecuteSeek(double seconds, bool bAccurate)
+{
+    LOG_INFO("MediaPlayerManager::SeekPlay - Seek to " + std::to_string(seconds) + " seconds" + (bAccurate ? "" : " (preview)"));
+    TIME_START("MediaSeek");
+
     if (m_currentMediaType == EM_MediaType::Audio && m_audioPlayer)
     {
         m_audioPlayer->PausePlay();
-        m_audioPlayer->SeekPlay(seconds);
+        if (bAccurate)
+        {
+            m_audioPlayer->SeekPlay(seconds);
+        }
+        else
+        {
+            m_audioPlayer->PreviewSeek(seconds);
+        }
         m_audioPlayer->ResumePlay();
     }
     else if (m_currentMediaType == EM_MediaType::Video && m_videoPlayer)
     {
         m_videoPlayer->PausePlay();
-        m_videoPlayer->SeekPlay(seconds);
+        if (bAccurate)
+        {
+            m_videoPlayer->SeekPlay(seconds);
+        }
+        else
+        {
+            m_videoPlayer->PreviewSeek(seconds);
+        }
         m_videoPlayer->ResumePlay();
     }
     else if (m_currentMediaType == EM_MediaType::VideoWithAudio)
@@ -231,11 +473,25 @@ void MediaPlayerManager::SeekPlay(double seconds)
         }
         if (m_videoPlayer)
         {
-            m_videoPlayer->SeekPlay(seconds);
+            if (bAccurate)
+            {
+                m_videoPlayer->SeekPlay(seconds);
+            }
+            else
+            {
+                m_videoPlayer->PreviewSeek(seconds);
+            }
         }
         if (m_audioPlayer)
         {
-            m_audioPlayer->SeekPlay(seconds);
+            if (bAccurate)
+            {
+                m_audioPlayer->SeekPlay(seconds);
+            }
+            else
+            {
+                m_audioPlayer->PreviewSeek(seconds);
+            }
         }
         // seek后统一调用ResumePlay，确保时间基准同步
         LOG_INFO("MediaPlayerManager::SeekPlay - Synchronized resume after seek with target: " + std::to_string(seconds));
@@ -248,6 +504,25 @@ void MediaPlayerManager::SeekPlay(double seconds)
             m_videoPlayer->ResumePlay();
         }
     }
+    TimeSystem::Instance().StopTimingWithLog("MediaSeek", EM_TimingLogLevel::Info, EM_TimeUnit::Milliseconds, std::string(bAccurate ? "Accurate" : "Preview") + " seek to " + std::to_string(seconds) + " seconds");
+}
+
+bool MediaPlayerManager::PrepareNextTrack(const QString& filePath)
+{
+    if (!m_audioPlayer)
+    {
+        return false;
+    }
+
+    // 无缝衔接只支持纯音频播放，视频和音视频同播仍按播放完毕处理
+    if (filePath.isEmpty() || m_currentMediaType != EM_MediaType::Audio || DetectMediaType(filePath) != EM_MediaType::Audio)
+    {
+        m_audioPlayer->PrepareNextTrack(QString());
+        return false;
+    }
+
+    m_audioPlayer->PrepareNextTrack(filePath);
+    return true;
 }
 
 void MediaPlayerManager::StartRecording(const QString& outputPath, EM_MediaType mediaType)
@@ -364,7 +639,7 @@ double MediaPlayerManager::GetDuration() const
 {
     if (m_currentMediaType == EM_MediaType::Audio && m_audioPlayer)
     {
-        return m_audioPlayer->GetDuration();
+        return m_audioDuration;
     }
     else if (m_currentMediaType == EM_MediaType::Video && m_videoPlayer)
     {
@@ -457,42 +732,58 @@ EM_MediaType MediaPlayerManager::DetectMediaType(const QString& filePath)
 
 EM_MediaType MediaPlayerManager::DetectVideoWithAudio(const QString& filePath)
 {
-    AVFormatContext* formatCtx = nullptr;
     bool hasVideo = false;
     bool hasAudio = false;
 
-    // 打开输入文件
-    if (avformat_open_input(&formatCtx, filePath.toUtf8().constData(), nullptr, nullptr) < 0)
+    // 已探测过的文件直接使用缓存的流布局，无需打开文件；未命中时完整探测并写入缓存，供随后的打开使用
+    ST_StreamProbeInfo probeInfo;
+    if (ST_StreamInfoCache::Instance().Find(filePath, probeInfo))
     {
-        LOG_WARN("Failed to open file for stream detection: " + filePath.toStdString());
-        return EM_MediaType::Unknown;
+        for (const ST_CachedStreamInfo& streamInfo : probeInfo.m_streams)
+        {
+            hasVideo = hasVideo || streamInfo.m_codecType == AVMEDIA_TYPE_VIDEO;
+            hasAudio = hasAudio || streamInfo.m_codecType == AVMEDIA_TYPE_AUDIO;
+        }
     }
-
-    // 获取流信息
-    if (avformat_find_stream_info(formatCtx, nullptr) < 0)
+    else
     {
-        LOG_WARN("Failed to find stream info: " + filePath.toStdString());
-        avformat_close_input(&formatCtx);
-        return EM_MediaType::Unknown;
-    }
+        AVFormatContext* formatCtx = nullptr;
 
-    // 检查所有流
-    for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
-    {
-        AVCodecParameters* codecParams = formatCtx->streams[i]->codecpar;
+        // 打开输入文件
+        if (avformat_open_input(&formatCtx, filePath.toUtf8().constData(), nullptr, nullptr) < 0)
+        {
+            LOG_WARN("Failed to open file for stream detection: " + filePath.toStdString());
+            return EM_MediaType::Unknown;
+        }
 
-        if (codecParams->codec_type == AVMEDIA_TYPE_VIDEO)
+        // 获取流信息
+        if (avformat_find_stream_info(formatCtx, nullptr) < 0)
         {
-            hasVideo = true;
+            LOG_WARN("Failed to find stream info: " + filePath.toStdString());
+            avformat_close_input(&formatCtx);
+            return EM_MediaType::Unknown;
         }
-        else if (codecParams->codec_type == AVMEDIA_TYPE_AUDIO)
+
+        // 检查所有流
+        for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
         {
-            hasAudio = true;
+            AVCodecParameters* codecParams = formatCtx->streams[i]->codecpar;
+
+            if (codecParams->codec_type == AVMEDIA_TYPE_VIDEO)
+            {
+                hasVideo = true;
+            }
+            else if (codecParams->codec_type == AVMEDIA_TYPE_AUDIO)
+            {
+                hasAudio = true;
+            }
         }
-    }
 
-    // 清理资源
-    avformat_close_input(&formatCtx);
+        ST_StreamInfoCache::Instance().Store(filePath, formatCtx);
+
+        // 清理资源
+        avformat_close_input(&formatCtx);
+    }
 
     // 根据检测结果返回对应的媒体类型
     if (hasVideo && hasAudio)
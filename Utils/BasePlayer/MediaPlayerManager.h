@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 #include "../AudioPlayer/AudioFFmpegPlayer.h"
 #include "../VideoPlayer/VideoFFmpegPlayer.h"
 #include <atomic>
@@ -65,6 +66,20 @@ public:
     /// <returns>是否成功开始播放</returns>
     bool PlayMedia(const QString& filePath, double startPosition = 0.0, const QStringList& args = QStringList());
 
+    /// <summary>
+    /// 异步播放媒体文件：检测媒体类型、打开文件和启动音频在线程池中完成，UI线程不阻塞
+    /// 完成后发出SigMediaPlayStarted或SigMediaPlayFailed；新的播放或停止请求会取消尚未完成的请求
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    /// <param name="args">播放参数</param>
+    void PlayMediaAsync(const QString& filePath, double startPosition = 0.0, const QStringList& args = QStringList());
+
+    /// <summary>
+    /// 是否有正在准备的异步播放请求
+    /// </summary>
+    bool IsLoading() const;
+
     /// <summary>
     /// 暂停播放
     /// </summary>
@@ -86,6 +101,29 @@ public:
     /// <param name="seconds">目标时间（秒）</param>
     void SeekPlay(double seconds);
 
+    /// <summary>
+    /// 进度条产生的seek请求：只执行最新的目标，拖动中使用关键帧预览定位，拖动结束后执行一次精确定位
+    /// </summary>
+    /// <param name="seconds">目标时间（秒）</param>
+    void RequestSeek(double seconds);
+
+    /// <summary>
+    /// 进度条滑块按下，之后的seek请求使用预览定位
+    /// </summary>
+    void BeginSeekDrag();
+
+    /// <summary>
+    /// 进度条滑块松开，对最后的目标补一次精确定位
+    /// </summary>
+    void EndSeekDrag();
+
+    /// <summary>
+    /// 预备下一首音轨，当前音轨播放结束时无缝衔接（仅当前和下一首均为音频文件时生效）
+    /// </summary>
+    /// <param name="filePath">下一首文件路径，为空时取消预备</param>
+    /// <returns>是否已开始预备</returns>
+    bool PrepareNextTrack(const QString& filePath);
+
     /// <summary>
     /// 开始录制
     /// </summary>
@@ -171,6 +209,22 @@ signals:
     /// 播放完毕
     /// </summary>
     void SigPlayerFinished();
+    /// <summary>
+    /// 无缝切换到下一首音轨
+    /// </summary>
+    /// <param name="filePath">新音轨文件路径</param>
+    void SigTrackChanged(const QString& filePath);
+    /// <summary>
+    /// 异步播放已开始
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    void SigMediaPlayStarted(const QString& filePath, double startPosition);
+    /// <summary>
+    /// 异步播放失败
+    /// </summary>
+    /// <param name="filePath">文件路径</param>
+    void SigMediaPlayFailed(const QString& filePath);
 private:
     /// <summary>
     /// 私有构造函数（单例模式）
@@ -207,6 +261,48 @@ private:
     /// </summary>
     void StopCurrentPlayer();
 
+    /// <summary>
+    /// 在线程池中执行播放请求：检测类型、启动音频、打开视频文件，完成后投递到UI线程（持有m_playRequestMutex串行执行）
+    /// </summary>
+    /// <param name="requestId">播放请求序号</param>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    /// <param name="args">播放参数</param>
+    void ExecutePlayRequest(uint64_t requestId, const QString& filePath, double startPosition, const QStringList& args);
+
+    /// <summary>
+    /// UI线程中完成播放请求：启动视频播放并更新当前媒体状态
+    /// </summary>
+    /// <param name="requestId">播放请求序号</param>
+    /// <param name="filePath">文件路径</param>
+    /// <param name="mediaType">媒体类型，Unknown表示准备失败</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    /// <param name="audioDuration">工作线程中打开的音轨时长（秒）</param>
+    /// <param name="videoFile">已打开的视频文件（仅视频类型）</param>
+    void OnPlayRequestPrepared(uint64_t requestId, const QString& filePath, EM_MediaType mediaType, double startPosition, double audioDuration, std::shared_ptr<std::unique_ptr<ST_OpenFileResult>> videoFile);
+
+    /// <summary>
+    /// 取消尚未完成的播放请求，已由该请求启动的音频在线程池中停止，UI线程不等待
+    /// </summary>
+    void CancelPendingPlayRequest();
+
+    /// <summary>
+    /// 暂停、定位并恢复当前播放器
+    /// </summary>
+    /// <param name="seconds">目标时间（秒）</param>
+    /// <param name="bAccurate">是否精确定位，否则为关键帧预览定位</param>
+    void ExecuteSeek(double seconds, bool bAccurate);
+
+    /// <summary>
+    /// seek合并定时器到期：执行最新的目标，拖动已结束时对预览过的目标补一次精确定位
+    /// </summary>
+    void OnSeekTimer();
+
+    /// <summary>
+    /// 丢弃尚未执行的seek请求
+    /// </summary>
+    void ResetPendingSeek();
+
     /// <summary>
     /// 连接信号槽
     /// </summary>
@@ -242,4 +338,54 @@ private:
     /// 当前文件路径
     /// </summary>
     QString m_currentFilePath;
+
+    /// <summary>
+    /// 当前音轨时长（秒），由播放请求完成通知和音轨切换通知在UI线程中更新
+    /// </summary>
+    double m_audioDuration{0.0};
+
+    /// <summary>
+    /// 最新的播放请求序号，播放和停止都会递增，用于丢弃过期的请求
+    /// </summary>
+    std::atomic<uint64_t> m_playRequestId{0};
+
+    /// <summary>
+    /// 播放请求互斥锁，线程池中的播放请求和取消任务串行执行
+    /// </summary>
+    std::mutex m_playRequestMutex;
+
+    /// <summary>
+    /// 是否有正在准备的异步播放请求（仅UI线程访问）
+    /// </summary>
+    bool m_bLoading{false};
+
+    /// <summary>
+    /// seek合并间隔（毫秒），间隔内的多个请求只执行最后一个
+    /// </summary>
+    static const int SEEK_COALESCE_INTERVAL_MS{50};
+
+    /// <summary>
+    /// seek合并定时器
+    /// </summary>
+    QTimer* m_seekTimer{nullptr};
+
+    /// <summary>
+    /// 尚未执行的最新seek目标（秒）
+    /// </summary>
+    double m_pendingSeekSeconds{0.0};
+
+    /// <summary>
+    /// 是否有尚未执行的seek请求
+    /// </summary>
+    bool m_bSeekPending{false};
+
+    /// <summary>
+    /// 最近一次执行的是预览定位，拖动结束后需要精确定位
+    /// </summary>
+    bool m_bPreviewSeeked{false};
+
+    /// <summary>
+    /// 进度条滑块是否按下（由滑块的按下和松开信号维护）
+    /// </summary>
+    bool m_bSeekDragging{false};
 }; 
\ No newline at end of file
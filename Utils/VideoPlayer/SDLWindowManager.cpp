@@ -1,9 +1,14 @@
 #include "SDLWindowManager.h"
+#include <cmath>
+#include <QTimer>
 #include "LogSystem/LogSystem.h"
 
 SDLWindowManager::SDLWindowManager(QObject* parent)
-    : QObject(parent)
+    : QObject(parent), m_eventTimer(new QTimer(this))
 {
+    // SDL事件在初始化SDL视频子系统的Qt线程中处理
+    m_eventTimer->setInterval(EVENT_POLL_INTERVAL_MS);
+    connect(m_eventTimer, &QTimer::timeout, this, &SDLWindowManager::ProcessEvents);
 }
 
 SDLWindowManager::~SDLWindowManager()
@@ -20,6 +25,9 @@ bool SDLWindowManager::CreateWindow(int width, int height, const QString& title)
         return true;
     }
 
+    // Win32消息由Qt事件循环分发，SDL_PollEvent只取SDL自己的事件队列，避免在定时器槽内重入Qt的消息循环
+    SDL_SetHint(SDL_HINT_WINDOWS_ENABLE_MESSAGELOOP, "0");
+
     // 创建SDL窗口
     m_window = SDL_CreateWindow(title.toUtf8().constData(), width, height, SDL_WINDOW_RESIZABLE);
     if (!m_window)
@@ -43,12 +51,15 @@ bool SDLWindowManager::CreateWindow(int width, int height, const QString& title)
         return false;
     }
 
-    // 启用垂直同步
-    SDL_SetRenderVSync(m_renderer, 1);
+    // 呈现在Qt线程执行，不等待垂直同步以免阻塞Qt事件循环；呈现节奏由视频呈现线程按时间戳控制
+    SDL_SetRenderVSync(m_renderer, 0);
 
     m_windowValid = true;
     m_windowVisible = true;
 
+    // 窗口、渲染器和事件处理都留在当前线程
+    m_eventTimer->start();
+
     LOG_INFO("SDL window created successfully: " + std::to_string(width) + "x" + std::to_string(height));
     return true;
 }
@@ -61,6 +72,9 @@ bool SDLWindowManager::CreateEmbeddedWindow(int width, int height, WId parentWin
         return true;
     }
 
+    // 包装的是Qt控件的HWND，窗口操作和消息都必须留在Qt线程
+    SDL_SetHint(SDL_HINT_WINDOWS_ENABLE_MESSAGELOOP, "0");
+
     // 使用SDL3的新API创建嵌入父窗口的SDL窗口
     SDL_PropertiesID props = SDL_CreateProperties();
     if (!props)
@@ -103,17 +117,29 @@ bool SDLWindowManager::CreateEmbeddedWindow(int width, int height, WId parentWin
         return false;
     }
 
-    // 启用垂直同步
-    SDL_SetRenderVSync(m_renderer, 1);
+    // 呈现在Qt线程执行，不等待垂直同步以免阻塞Qt事件循环
+    SDL_SetRenderVSync(m_renderer, 0);
 
     m_windowValid = true;
     m_windowVisible = true;
 
+    m_eventTimer->start();
+
     LOG_INFO("SDL embedded window created successfully: " + std::to_string(width) + "x" + std::to_string(height));
     return true;
 }
 
 void SDLWindowManager::DestroyWindow()
+{
+    // 已排队的呈现请求在渲染器销毁后执行时直接返回
+    m_eventTimer->stop();
+    DestroyWindowResources();
+
+    LOG_INFO("SDL window destroyed");
+    emit WindowClosed();
+}
+
+void SDLWindowManager::DestroyWindowResources()
 {
     if (m_texture)
     {
@@ -135,9 +161,85 @@ void SDLWindowManager::DestroyWindow()
 
     m_windowValid = false;
     m_windowVisible = false;
+}
 
-    LOG_INFO("SDL window destroyed");
-    emit WindowClosed();
+void SDLWindowManager::SetFrameSource(ST_VideoFramePool* framePool)
+{
+    // 上传期间持有该锁，返回后旧帧池的缓冲区已归还，调用方可以安全释放旧帧池
+    std::lock_guard<std::mutex> lock(m_frameSourceMutex);
+    m_pFramePool = framePool;
+}
+
+void SDLWindowManager::NotifyFrameReady()
+{
+    m_bFrameReady = true;
+    SchedulePresent();
+}
+
+void SDLWindowManager::SchedulePresent()
+{
+    // 已有排队的呈现时不再投递，期间发布的帧在帧池中被更新的帧替换，Qt事件队列中最多只有一次呈现
+    if (m_bPresentScheduled.exchange(true))
+    {
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        PresentPendingFrame();
+    }, Qt::QueuedConnection);
+}
+
+void SDLWindowManager::PresentPendingFrame()
+{
+    // 先清除排队标记，之后到达的通知会再投递一次，不会丢帧
+    m_bPresentScheduled = false;
+    if (!m_renderer)
+    {
+        return;
+    }
+
+    // 隐藏时不上传不呈现，帧池中的帧由更新的帧替换；重新显示后重绘
+    if (!m_windowVisible.load())
+    {
+        return;
+    }
+
+    bool bUploaded = m_bFrameReady.exchange(false) && UploadLatestFrame();
+    if (m_bRedrawRequested.exchange(false) || bUploaded)
+    {
+        RenderFrame();
+    }
+}
+
+bool SDLWindowManager::UploadLatestFrame()
+{
+    std::lock_guard<std::mutex> lock(m_frameSourceMutex);
+    if (!m_pFramePool)
+    {
+        return false;
+    }
+
+    const ST_VideoFrameBuffer* frame = m_pFramePool->AcquireRead();
+    if (!frame)
+    {
+        return false;
+    }
+
+    ST_VideoPlanes planes;
+    for (int i = 0; i < 3; ++i)
+    {
+        planes.m_data[i] = frame->m_data[i];
+        planes.m_pitch[i] = frame->m_linesize[i];
+    }
+    planes.m_width = static_cast<float>(frame->m_width);
+    planes.m_height = static_cast<float>(frame->m_height);
+    planes.m_format = m_textureFormat.load();
+    bool bUpdated = UpdateTextureFromPlanes(planes);
+
+    // 数据已拷贝进纹理，缓冲区归还给写入方
+    m_pFramePool->ReleaseRead(frame);
+    return bUpdated;
 }
 
 void SDLWindowManager::ShowWindow(bool show)
@@ -150,6 +252,7 @@ void SDLWindowManager::ShowWindow(bool show)
     if (show)
     {
         SDL_ShowWindow(m_window);
+        m_bRedrawRequested = true;
     }
     else
     {
@@ -157,6 +260,10 @@ void SDLWindowManager::ShowWindow(bool show)
     }
 
     m_windowVisible = show;
+    if (show)
+    {
+        SchedulePresent();
+    }
 }
 
 void SDLWindowManager::SetWindowTitle(const QString& title)
@@ -167,7 +274,18 @@ void SDLWindowManager::SetWindowTitle(const QString& title)
     }
 }
 
-bool SDLWindowManager::CreateVideoTexture(float width, float height)
+bool SDLWindowManager::CreateVideoTexture(float width, float height, SDL_PixelFormat format, SDL_Colorspace colorspace)
+{
+    if (!m_renderer)
+    {
+        LOG_ERROR("Cannot create texture: renderer not initialized");
+        return false;
+    }
+
+    return CreateVideoTextureInternal(width, height, format, colorspace);
+}
+
+bool SDLWindowManager::CreateVideoTextureInternal(float width, float height, SDL_PixelFormat format, SDL_Colorspace colorspace)
 {
     if (!m_renderer)
     {
@@ -181,7 +299,25 @@ bool SDLWindowManager::CreateVideoTexture(float width, float height)
         m_texture = nullptr;
     }
 
-    m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGB24, SDL_TEXTUREACCESS_STREAMING, width, height);
+    SDL_PropertiesID props = SDL_CreateProperties();
+    if (!props)
+    {
+        QString error = QString("Failed to create SDL properties: %1").arg(SDL_GetError());
+        LOG_ERROR(error.toStdString());
+        return false;
+    }
+
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, format);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STREAMING);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, static_cast<Sint64>(width));
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, static_cast<Sint64>(height));
+    if (colorspace != SDL_COLORSPACE_UNKNOWN)
+    {
+        SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, colorspace);
+    }
+
+    m_texture = SDL_CreateTextureWithProperties(m_renderer, props);
+    SDL_DestroyProperties(props);
     if (!m_texture)
     {
         QString error = QString("Failed to create SDL texture: %1").arg(SDL_GetError());
@@ -189,10 +325,36 @@ bool SDLWindowManager::CreateVideoTexture(float width, float height)
         return false;
     }
 
-    LOG_INFO("SDL texture created successfully: " + std::to_string(width) + "x" + std::to_string(height));
+    m_textureFormat = format;
+    m_textureColorspace = colorspace;
+    LOG_INFO("SDL texture created successfully: " + std::to_string(width) + "x" + std::to_string(height) + " format=" + std::string(SDL_GetPixelFormatName(format)));
     return true;
 }
 
+bool SDLWindowManager::IsTextureFormatSupported(SDL_PixelFormat format) const
+{
+    if (!m_renderer)
+    {
+        return false;
+    }
+
+    // 渲染器支持的纹理格式列表以SDL_PIXELFORMAT_UNKNOWN结尾
+    auto* formats = static_cast<const SDL_PixelFormat*>(SDL_GetPointerProperty(SDL_GetRendererProperties(m_renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+    if (!formats)
+    {
+        return false;
+    }
+
+    for (; *formats != SDL_PIXELFORMAT_UNKNOWN; ++formats)
+    {
+        if (*formats == format)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool SDLWindowManager::UpdateTexture(const void* data, int pitch)
 {
     if (!m_texture || !data)
@@ -200,7 +362,7 @@ bool SDLWindowManager::UpdateTexture(const void* data, int pitch)
         return false;
     }
 
-    if (SDL_UpdateTexture(m_texture, nullptr, data, pitch) != 0)
+    if (!SDL_UpdateTexture(m_texture, nullptr, data, pitch))
     {
         QString error = QString("Failed to update SDL texture: %1").arg(SDL_GetError());
         LOG_WARN(error.toStdString());
@@ -235,7 +397,7 @@ bool SDLWindowManager::UpdateTextureFromRGBData(const uint8_t* rgbData, int pitc
     if (std::abs(width - textureWidth) > 1e-3 || std::abs(height - textureHeight) > 1e-3)
     {
         LOG_WARN("Texture size mismatch, recreating texture: " + std::to_string(width) + "x" + std::to_string(height));
-        if (!CreateVideoTexture(width, height))
+        if (!CreateVideoTextureInternal(width, height, SDL_PIXELFORMAT_RGB24, SDL_COLORSPACE_UNKNOWN))
         {
             return false;
         }
@@ -244,6 +406,50 @@ bool SDLWindowManager::UpdateTextureFromRGBData(const uint8_t* rgbData, int pitc
     return UpdateTexture(rgbData, pitch);
 }
 
+bool SDLWindowManager::UpdateTextureFromPlanes(const ST_VideoPlanes& planes)
+{
+    if (!m_renderer || !planes.m_data[0] || planes.m_width <= 0 || planes.m_height <= 0)
+    {
+        return false;
+    }
+
+    float textureWidth = 0.0f;
+    float textureHeight = 0.0f;
+    if (m_texture)
+    {
+        SDL_GetTextureSize(m_texture, &textureWidth, &textureHeight);
+    }
+
+    if (!m_texture || planes.m_format != m_textureFormat || std::abs(planes.m_width - textureWidth) > 1e-3 || std::abs(planes.m_height - textureHeight) > 1e-3)
+    {
+        LOG_WARN("Texture size or format mismatch, recreating texture: " + std::to_string(planes.m_width) + "x" + std::to_string(planes.m_height));
+        if (!CreateVideoTextureInternal(planes.m_width, planes.m_height, planes.m_format, m_textureColorspace.load()))
+        {
+            return false;
+        }
+    }
+
+    bool bUpdated = false;
+    switch (planes.m_format)
+    {
+        case SDL_PIXELFORMAT_IYUV:
+            bUpdated = SDL_UpdateYUVTexture(m_texture, nullptr, planes.m_data[0], planes.m_pitch[0], planes.m_data[1], planes.m_pitch[1], planes.m_data[2], planes.m_pitch[2]);
+            break;
+        case SDL_PIXELFORMAT_NV12:
+            bUpdated = SDL_UpdateNVTexture(m_texture, nullptr, planes.m_data[0], planes.m_pitch[0], planes.m_data[1], planes.m_pitch[1]);
+            break;
+        default:
+            return UpdateTexture(planes.m_data[0], planes.m_pitch[0]);
+    }
+
+    if (!bUpdated)
+    {
+        QString error = QString("Failed to update SDL YUV texture: %1").arg(SDL_GetError());
+        LOG_WARN(error.toStdString());
+    }
+    return bUpdated;
+}
+
 void SDLWindowManager::ProcessEvents()
 {
     SDL_Event event;
@@ -254,7 +460,12 @@ void SDLWindowManager::ProcessEvents()
             case SDL_EVENT_QUIT: emit WindowClosed();
                 break;
             case SDL_EVENT_WINDOW_RESIZED:
-            case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: emit WindowResized(event.window.data1, event.window.data2);
+            case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: m_bRedrawRequested = true;
+                SchedulePresent();
+                emit WindowResized(event.window.data1, event.window.data2);
+                break;
+            case SDL_EVENT_WINDOW_EXPOSED: m_bRedrawRequested = true;
+                SchedulePresent();
                 break;
             case SDL_EVENT_WINDOW_CLOSE_REQUESTED: emit WindowClosed();
                 break;
@@ -321,25 +532,12 @@ bool SDLWindowManager::ResizeWindow(int width, int height)
         return false;
     }
 
-
     // 设置窗口大小
     SDL_SetWindowSize(m_window, width, height);
 
-    // 重新创建纹理以适应新的大小
-    if (m_texture)
-    {
-        SDL_DestroyTexture(m_texture);
-        m_texture = nullptr;
-    }
-
-    // 创建新的纹理
-    m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGB24, SDL_TEXTUREACCESS_STREAMING, width, height);
-    if (!m_texture)
-    {
-        QString error = QString("Failed to create texture after resize: %1").arg(SDL_GetError());
-        LOG_ERROR(error.toStdString());
-        return false;
-    }
+    // 纹理尺寸跟随转换后的帧尺寸，由下一帧的UpdateTextureFromPlanes按新尺寸重建，保留旧纹理使画面不会闪黑；当前纹理先按新窗口尺寸重绘
+    m_bRedrawRequested = true;
+    SchedulePresent();
 
     LOG_INFO("Window resized successfully to: " + std::to_string(width) + "x" + std::to_string(height));
     emit WindowResized(width, height);
@@ -348,15 +546,9 @@ bool SDLWindowManager::ResizeWindow(int width, int height)
 
 bool SDLWindowManager::RecreateTexture(int width, int height)
 {
-    if (!m_renderer)
-    {
-        LOG_ERROR("Cannot recreate texture: renderer not initialized");
-        return false;
-    }
-
-    if (width <= 0 || height <= 0)
+    if (!m_renderer || width <= 0 || height <= 0)
     {
-        LOG_ERROR("Invalid texture dimensions: " + std::to_string(width) + "x" + std::to_string(height));
+        LOG_ERROR("Cannot recreate texture: " + std::to_string(width) + "x" + std::to_string(height));
         return false;
     }
 
@@ -367,12 +559,10 @@ bool SDLWindowManager::RecreateTexture(int width, int height)
         m_texture = nullptr;
     }
 
-    // 创建新的纹理
-    m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGB24, SDL_TEXTUREACCESS_STREAMING, width, height);
-    if (!m_texture)
+    // 创建新的纹理，保持当前纹理格式
+    if (!CreateVideoTextureInternal(width, height, m_textureFormat.load(), m_textureColorspace.load()))
     {
-        QString error = QString("Failed to recreate texture: %1").arg(SDL_GetError());
-        LOG_ERROR(error.toStdString());
+        LOG_ERROR("Failed to recreate texture");
         return false;
     }
 
@@ -4,17 +4,36 @@
 #include <QString>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <qwindowdefs.h>
+#include "BaseDataDefine/ST_VideoFramePool.h"
 #include "DataDefine/ST_SDL_Renderer.h"
 #include "DataDefine/ST_SDL_Texture.h"
 
+class QTimer;
+
 extern "C" {
 #include <SDL3/SDL.h>
 }
 
+/// <summary>
+/// 待上传到视频纹理的图像平面
+/// RGB24只使用第0个平面，IYUV依次为Y、U、V平面，NV12依次为Y、UV平面
+/// </summary>
+struct ST_VideoPlanes
+{
+    const uint8_t* m_data[3]{nullptr, nullptr, nullptr}; /// 各平面数据
+    int m_pitch[3]{0, 0, 0};                             /// 各平面行间距
+    float m_width{0.0f};                                 /// 图像宽度
+    float m_height{0.0f};                                /// 图像高度
+    SDL_PixelFormat m_format{SDL_PIXELFORMAT_RGB24};     /// 像素格式
+};
+
 /// <summary>
 /// SDL3窗口管理器
 /// 负责SDL窗口的创建、销毁和事件处理
+/// 窗口、渲染器、纹理和SDL事件都留在创建窗口的Qt线程：SDL3的渲染接口只能在主线程调用，渲染器的窗口事件回调也在处理事件的线程中修改渲染器状态；
+/// 呈现线程只向帧池发布帧并通知，Qt线程合并通知，同一时刻最多排队一次呈现，每次只上传帧池中最新的帧
 /// </summary>
 class SDLWindowManager : public QObject
 {
@@ -32,7 +51,7 @@ public:
     /// </summary>
     ~SDLWindowManager() override;
     /// <summary>
-    /// 创建SDL窗口
+    /// 在调用线程创建SDL窗口和渲染器，之后启动SDL事件处理定时器
     /// </summary>
     /// <param name="width">窗口宽度</param>
     /// <param name="height">窗口高度</param>
@@ -41,7 +60,7 @@ public:
     bool CreateWindow(int width, int height, const QString& title = "SDL Window");
 
     /// <summary>
-    /// 创建嵌入Qt控件的SDL窗口
+    /// 在调用线程创建嵌入Qt控件的SDL窗口和渲染器，之后启动SDL事件处理定时器
     /// </summary>
     /// <param name="width">窗口宽度</param>
     /// <param name="height">窗口高度</param>
@@ -54,6 +73,17 @@ public:
     /// </summary>
     void DestroyWindow();
 
+    /// <summary>
+    /// 设置呈现时取帧的帧池，传入nullptr解除；返回时已不再访问旧帧池（最多等待一次纹理上传）
+    /// </summary>
+    /// <param name="framePool">帧池</param>
+    void SetFrameSource(ST_VideoFramePool* framePool);
+
+    /// <summary>
+    /// 通知帧池中有新帧（任意线程调用），尚未执行的呈现请求会合并，不会堆积Qt事件
+    /// </summary>
+    void NotifyFrameReady();
+
     /// <summary>
     /// 显示/隐藏窗口
     /// </summary>
@@ -89,11 +119,26 @@ public:
     /// </summary>
     /// <param name="width">纹理宽度</param>
     /// <param name="height">纹理高度</param>
+    /// <param name="format">纹理像素格式，YUV格式由渲染器完成颜色转换</param>
+    /// <param name="colorspace">YUV纹理的色彩空间，SDL_COLORSPACE_UNKNOWN表示使用SDL默认值</param>
     /// <returns>是否创建成功</returns>
-    bool CreateVideoTexture(float width, float height);
+    /// <remarks>仅窗口所在线程调用</remarks>
+    bool CreateVideoTexture(float width, float height, SDL_PixelFormat format = SDL_PIXELFORMAT_RGB24, SDL_Colorspace colorspace = SDL_COLORSPACE_UNKNOWN);
+
+    /// <summary>
+    /// 检查渲染器是否支持指定的纹理像素格式
+    /// </summary>
+    /// <param name="format">像素格式</param>
+    /// <returns>是否支持</returns>
+    bool IsTextureFormatSupported(SDL_PixelFormat format) const;
+
+    /// <summary>
+    /// 获取当前视频纹理的像素格式
+    /// </summary>
+    SDL_PixelFormat GetTextureFormat() const { return m_textureFormat.load(); }
 
     /// <summary>
-    /// 更新纹理数据
+    /// 更新纹理数据（仅窗口所在线程调用）
     /// </summary>
     /// <param name="data">图像数据</param>
     /// <param name="pitch">行间距</param>
@@ -101,20 +146,33 @@ public:
     bool UpdateTexture(const void* data, int pitch);
 
     /// <summary>
-    /// 从RGB数据更新纹理
+    /// 从RGB数据更新纹理（仅窗口所在线程调用）
     /// </summary>
     /// <param name="rgbData">RGB24格式图像数据</param>
     /// <param name="width">图像宽度</param>
     /// <param name="height">图像高度</param>
     /// <returns>是否更新成功</returns>
     bool UpdateTextureFromRGBData(const uint8_t* rgbData, int pitch, float width, float height);
+
     /// <summary>
-    /// 渲染当前帧
+    /// 按平面格式更新纹理：RGB24使用SDL_UpdateTexture，IYUV使用SDL_UpdateYUVTexture，NV12使用SDL_UpdateNVTexture
+    /// 尺寸或格式与当前纹理不一致时重新创建纹理（仅窗口所在线程调用）
+    /// </summary>
+    /// <param name="planes">图像平面</param>
+    /// <returns>是否更新成功</returns>
+    bool UpdateTextureFromPlanes(const ST_VideoPlanes& planes);
+    /// <summary>
+    /// 渲染当前帧（仅窗口所在线程调用）
     /// </summary>
     void RenderFrame();
 
     /// <summary>
-    /// 处理SDL事件
+    /// 上传帧池中最新的帧并呈现，有重绘请求时重绘当前纹理（仅窗口所在线程调用）
+    /// </summary>
+    void PresentPendingFrame();
+
+    /// <summary>
+    /// 处理SDL事件（由Qt线程的定时器调用）
     /// </summary>
     void ProcessEvents();
 
@@ -149,7 +207,7 @@ public:
     void GetWindowSize(int& width, int& height);
     
     /// <summary>
-    /// 调整窗口大小（不中断视频播放）
+    /// 调整窗口大小（不中断视频播放），纹理在下一帧按转换后的尺寸重建
     /// </summary>
     /// <param name="width">新宽度</param>
     /// <param name="height">新高度</param>
@@ -177,9 +235,45 @@ signals:
     /// <param name="height">新高度</param>
     void WindowResized(int width, int height);
 private:
+    /// <summary>
+    /// 尚未排队呈现时向窗口所在线程投递一次呈现（任意线程调用）
+    /// </summary>
+    void SchedulePresent();
+
+    /// <summary>
+    /// 从帧池取最新的帧上传到纹理（仅窗口所在线程调用）
+    /// </summary>
+    /// <returns>是否上传了新帧</returns>
+    bool UploadLatestFrame();
+
+    /// <summary>
+    /// 创建视频纹理（仅窗口所在线程调用）
+    /// </summary>
+    bool CreateVideoTextureInternal(float width, float height, SDL_PixelFormat format, SDL_Colorspace colorspace);
+
+    /// <summary>
+    /// 销毁纹理、渲染器和窗口
+    /// </summary>
+    void DestroyWindowResources();
+
+    /// <summary>
+    /// Qt线程处理SDL事件的间隔（毫秒）
+    /// </summary>
+    static constexpr int EVENT_POLL_INTERVAL_MS = 10;
+
     SDL_Window* m_window{nullptr};           /// SDL窗口
     SDL_Renderer* m_renderer{nullptr};       /// SDL渲染器
     SDL_Texture* m_texture{nullptr};       /// SDL纹理
+    std::atomic<SDL_PixelFormat> m_textureFormat{SDL_PIXELFORMAT_RGB24};        /// 视频纹理像素格式
+    std::atomic<SDL_Colorspace> m_textureColorspace{SDL_COLORSPACE_UNKNOWN};    /// 视频纹理色彩空间
     std::atomic<bool> m_windowVisible{false}; /// 窗口是否可见
     std::atomic<bool> m_windowValid{false};   /// 窗口是否有效
+
+    // 呈现（窗口所在线程）
+    std::atomic<bool> m_bPresentScheduled{false};           /// 是否已有排队的呈现请求，用于合并通知
+    std::atomic<bool> m_bFrameReady{false};                 /// 帧池是否有新帧
+    std::atomic<bool> m_bRedrawRequested{false};            /// 是否需要重绘当前纹理（窗口尺寸、可见性或曝光变化时设置）
+    std::mutex m_frameSourceMutex;                          /// 保护m_pFramePool，上传期间持有
+    ST_VideoFramePool* m_pFramePool{nullptr};               /// 取帧的帧池
+    QTimer* m_eventTimer{nullptr};                          /// Qt线程处理SDL事件的定时器
 };
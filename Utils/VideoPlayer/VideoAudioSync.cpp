@@ -122,7 +122,8 @@ double VideoAudioSync::GetAudioPosition() const
         return -1.0;
     }
 
-    return m_audioPlayer->GetCurrentPosition();
+    // 使用按设备已消费样本计算的音频时钟，无锁读取
+    return m_audioPlayer->GetAudioClock();
 }
 
 void VideoAudioSync::PreciseWait(double seconds)
@@ -54,10 +54,27 @@ void VideoFFmpegPlayer::StartPlay(const QString& videoPath, bool bStart, double
         return;
     }
 
+    StartPlayWithOpenedFile(videoPath, std::move(openFileResult), startPosition);
+}
+
+bool VideoFFmpegPlayer::StartPlayWithOpenedFile(const QString& videoPath, std::unique_ptr<ST_OpenFileResult> openFileResult, double startPosition)
+{
+    if (!openFileResult || !openFileResult->m_formatCtx)
+    {
+        LOG_WARN("VideoFFmpegPlayer::StartPlayWithOpenedFile() : Invalid open file result: " + videoPath.toStdString());
+        return false;
+    }
+
     // 创建播放线程和工作对象
     m_pPlayWorker = std::make_unique<VideoPlayWorker>();
 
     connect(this, &VideoFFmpegPlayer::destroyed, m_pPlayWorker.get(), &VideoPlayWorker::deleteLater);
+    if (m_packetQueueDepth > 0 && m_frameQueueDepth > 0)
+    {
+        m_pPlayWorker->SetQueueDepths(m_packetQueueDepth, m_frameQueueDepth);
+    }
+    m_pPlayWorker->SetDecodeThreadPolicy(m_decodeThreadPolicy);
+    m_pPlayWorker->SetDecodeQualityHints(m_decodeQualityHints);
 
     // 获取父窗口句柄（用于嵌入Qt控件）
     WId parentWindowId = 0;
@@ -72,7 +89,7 @@ void VideoFFmpegPlayer::StartPlay(const QString& videoPath, bool bStart, double
         LOG_WARN("VideoFFmpegPlayer::StartPlay() : Failed to initialize player");
         // 清理资源
         m_pPlayWorker.reset();
-        return;
+        return false;
     }
     ResizeSDLWindows(m_pVideoDisplayWidget->width(), m_pVideoDisplayWidget->height());
     // 设置音频播放器用于音视频同步
@@ -96,6 +113,7 @@ void VideoFFmpegPlayer::StartPlay(const QString& videoPath, bool bStart, double
     m_pPlayWorker->SlotStartPlay();
 
     LOG_INFO("Video playback started successfully: " + videoPath.toStdString());
+    return true;
 }
 
 void VideoFFmpegPlayer::PausePlay()
@@ -196,6 +214,16 @@ void VideoFFmpegPlayer::SeekPlay(double seconds)
     }
 }
 
+void VideoFFmpegPlayer::PreviewSeek(double seconds)
+{
+    if (m_pPlayWorker && (IsPlaying() || IsPaused()))
+    {
+        m_pPlayWorker->SlotSeekPlay(seconds, false);
+        m_pauseTime = seconds;
+        LOG_INFO("Video preview seek to: " + std::to_string(seconds) + " seconds");
+    }
+}
+
 double VideoFFmpegPlayer::GetCurrentPosition()
 {
     // 使用基类的计算方法
@@ -273,3 +301,40 @@ void VideoFFmpegPlayer::ResizeSDLWindows(int width, int height)
         emit m_pPlayWorker.get()->SigSDLWindowsResize(width, height);
     }
 }
+
+void VideoFFmpegPlayer::ShowSDLWindows(bool bShow)
+{
+    if (m_pPlayWorker)
+    {
+        emit m_pPlayWorker.get()->SigSDLWindowsShow(bShow);
+    }
+}
+
+void VideoFFmpegPlayer::SetQueueDepths(size_t packetQueueDepth, size_t frameQueueDepth)
+{
+    m_packetQueueDepth = packetQueueDepth;
+    m_frameQueueDepth = frameQueueDepth;
+    if (m_pPlayWorker)
+    {
+        m_pPlayWorker->SetQueueDepths(packetQueueDepth, frameQueueDepth);
+    }
+}
+
+void VideoFFmpegPlayer::SetDecodeThreadPolicy(const ST_DecodeThreadPolicy& policy)
+{
+    m_decodeThreadPolicy = policy;
+}
+
+void VideoFFmpegPlayer::SetDecodeQualityHints(const ST_DecodeQualityHints& hints)
+{
+    m_decodeQualityHints = hints;
+}
+
+ST_VideoPipelineMetrics VideoFFmpegPlayer::GetPipelineMetrics() const
+{
+    if (m_pPlayWorker)
+    {
+        return m_pPlayWorker->GetPipelineMetrics();
+    }
+    return ST_VideoPipelineMetrics();
+}
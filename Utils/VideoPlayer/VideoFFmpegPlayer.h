@@ -49,6 +49,15 @@ class VideoFFmpegPlayer : public BaseFFmpegPlayer
     /// <param name="args">参数列表</param>
     void StartPlay(const QString& videoPath, bool bStart, double startPosition = 0.0, const QStringList& args = QStringList()) override;
 
+    /// <summary>
+    /// 使用已在其他线程打开的文件开始播放视频，需在UI线程调用
+    /// </summary>
+    /// <param name="videoPath">视频文件路径</param>
+    /// <param name="openFileResult">已打开的文件（转移所有权）</param>
+    /// <param name="startPosition">开始位置（秒）</param>
+    /// <returns>是否成功开始播放</returns>
+    bool StartPlayWithOpenedFile(const QString& videoPath, std::unique_ptr<ST_OpenFileResult> openFileResult, double startPosition = 0.0);
+
     /// <summary>
     /// 暂停视频播放
     /// </summary>
@@ -81,6 +90,12 @@ class VideoFFmpegPlayer : public BaseFFmpegPlayer
     /// <param name="seconds">目标时间（秒）</param>
     void SeekPlay(double seconds) override;
 
+    /// <summary>
+    /// 快速预览定位：显示目标前的关键帧，不逐帧解码到目标（拖动进度条时使用）
+    /// </summary>
+    /// <param name="seconds">目标时间（秒）</param>
+    void PreviewSeek(double seconds);
+
     /// <summary>
     /// 获取当前播放位置
     /// </summary>
@@ -114,6 +129,37 @@ class VideoFFmpegPlayer : public BaseFFmpegPlayer
     /// <param name="width"></param>
     /// <param name="height"></param>
     void ResizeSDLWindows(int width, int height);
+
+    /// <summary>
+    /// 显示/隐藏播放窗口，隐藏期间不上传和呈现视频帧
+    /// </summary>
+    /// <param name="bShow">是否显示</param>
+    void ShowSDLWindows(bool bShow);
+
+    /// <summary>
+    /// 设置视频流水线队列深度，对当前和之后的播放生效
+    /// </summary>
+    /// <param name="packetQueueDepth">数据包队列深度（个）</param>
+    /// <param name="frameQueueDepth">视频帧队列深度（帧）</param>
+    void SetQueueDepths(size_t packetQueueDepth, size_t frameQueueDepth);
+
+    /// <summary>
+    /// 获取视频流水线统计，未在播放时返回空统计
+    /// </summary>
+    /// <returns>流水线统计</returns>
+    ST_VideoPipelineMetrics GetPipelineMetrics() const;
+
+    /// <summary>
+    /// 设置视频解码线程策略，对之后打开的视频生效
+    /// </summary>
+    /// <param name="policy">线程策略</param>
+    void SetDecodeThreadPolicy(const ST_DecodeThreadPolicy& policy);
+
+    /// <summary>
+    /// 设置视频解码降质选项（用于预览），对之后打开的视频生效
+    /// </summary>
+    /// <param name="hints">降质选项</param>
+    void SetDecodeQualityHints(const ST_DecodeQualityHints& hints);
 private:
     /// <summary>
     /// 视频播放工作对象
@@ -134,4 +180,24 @@ private:
     /// 视频显示控件指针
     /// </summary>
     PlayerVideoModuleWidget* m_pVideoDisplayWidget{nullptr};
+
+    /// <summary>
+    /// 数据包队列深度，0表示使用默认值
+    /// </summary>
+    size_t m_packetQueueDepth{0};
+
+    /// <summary>
+    /// 视频帧队列深度，0表示使用默认值
+    /// </summary>
+    size_t m_frameQueueDepth{0};
+
+    /// <summary>
+    /// 视频解码线程策略
+    /// </summary>
+    ST_DecodeThreadPolicy m_decodeThreadPolicy;
+
+    /// <summary>
+    /// 视频解码降质选项
+    /// </summary>
+    ST_DecodeQualityHints m_decodeQualityHints;
 };
@@ -15,17 +15,10 @@
 VideoPlayWorker::VideoPlayWorker(QObject* parent)
     : QObject(parent), m_sdlManager(std::make_unique<SDLWindowManager>()), m_videoAudioSync(std::make_unique<VideoAudioSync>())
 {
-    // 例如在 VideoFFmpegPlayer.cpp
-    connect(this, &VideoPlayWorker::SigRenderFrameOnMainThread, this, [this](const uint8_t* rgbData, int pitch, float width, float height)
-    {
-        // 这里一定在主线程
-        if (m_sdlManager)
-        {
-            m_sdlManager->UpdateTextureFromRGBData(rgbData, pitch, width, height);
-            m_sdlManager->RenderFrame();
-        }
-    });
+    // 帧上传和呈现由SDLWindowManager在Qt线程中合并执行，呈现线程只发布帧
     connect(this, &VideoPlayWorker::SigSDLWindowsResize, m_sdlManager.get(), &SDLWindowManager::ResizeWindow);
+    connect(this, &VideoPlayWorker::SigSDLWindowsShow, m_sdlManager.get(), &SDLWindowManager::ShowWindow);
+    connect(this, &VideoPlayWorker::SigSDLWindowsResize, this, &VideoPlayWorker::RequestDisplaySize);
 }
 
 VideoPlayWorker::~VideoPlayWorker()
@@ -38,6 +31,10 @@ void VideoPlayWorker::Cleanup()
 {
     LOG_INFO("Cleaning up video player resources");
 
+    // 先停止流水线线程，避免其访问即将释放的资源
+    StopPipelineThreads();
+    m_packetQueue.Reset();
+    m_frameQueue.Reset();
 
     // 清理视频相关资源
     if (m_pSwsCtx)
@@ -50,16 +47,22 @@ void VideoPlayWorker::Cleanup()
     m_pFormatCtx.reset();
 
     // 清理帧和缓冲区
-    m_pRGBFrame = ST_AVFrame();   // 重置RGB帧
     m_pVideoFrame = ST_AVFrame(); // 重置视频帧
-    m_rgbBuffer.clear();
-    m_rgbBuffer.shrink_to_fit();
+    // 先解除帧池，等待正在进行的纹理上传归还缓冲区，再释放帧池
+    m_sdlManager->SetFrameSource(nullptr);
+    m_framePool.Reset();
+    m_displayPixelFormat = AV_PIX_FMT_RGB24;
+    m_textureFormat = SDL_PIXELFORMAT_RGB24;
+    m_displayWidth = 0;
+    m_displayHeight = 0;
+    m_bDisplaySizeChanged.store(false);
 
     m_videoInfo = ST_VideoFrameInfo();
     m_currentTime = 0.0;
     m_videoStreamIndex = -1;
     m_audioStreamIndex = -1;
     m_bSeekRequested.store(false);
+    m_skipUntilPTS = -1.0;
     m_bNeedStop.store(false);
 
     LOG_INFO("Video player cleanup completed");
@@ -74,33 +77,84 @@ void VideoPlayWorker::SlotStartPlay()
     }
 
     LOG_INFO("VideoPlayWorker::SlotStartPlay: 开始播放");
+    StopPipelineThreads();
     m_playState.TransitionTo(AVPlayState::Playing);
     m_bNeedStop.store(false);
-    m_startTime = av_gettime();
-    m_totalPauseTime = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_clockMutex);
+        m_startTime = av_gettime();
+        m_totalPauseTime = 0;
+        m_pauseStartTime = 0;
+    }
     m_currentTime = 0.0;
     m_bSeekRequested.store(false);
-    m_threadId = CoreServerGlobal::Instance().GetThreadPool().CreateDedicatedThread("VideoPlayerThread", [this]()
+    m_skipUntilPTS = -1.0;
+    m_estimatedPTS = 0.0;
+    m_serial.store(0);
+    m_presentSerial = -1;
+    m_bPresentEOF = false;
+    m_packetQueue.Reset();
+    m_frameQueue.Reset();
+    m_decodedFrames.store(0);
+    m_presentedFrames.store(0);
+    m_droppedFrames.store(0);
+    m_packetQueueUnderruns.store(0);
+    m_frameQueueUnderruns.store(0);
+
+    // 解复用、解码和呈现分别运行在独立线程，通过有界队列衔接，慢速读取或单帧解码耗时不会阻塞显示
+    auto& threadPool = CoreServerGlobal::Instance().GetThreadPool();
+    m_demuxThreadId = threadPool.CreateDedicatedThread("VideoDemuxThread", [this]()
+    {
+        DemuxLoop();
+    });
+    m_decodeThreadId = threadPool.CreateDedicatedThread("VideoDecodeThread", [this]()
+    {
+        DecodeLoop();
+    });
+    m_threadId = threadPool.CreateDedicatedThread("VideoPlayerThread", [this]()
     {
         PlayLoop();
     });
-    LOG_INFO("Play thread started");
+    m_bHasPipelineThreads = true;
+    LOG_INFO("Play threads started");
 }
 
 void VideoPlayWorker::SlotStopPlay()
 {
     LOG_INFO("Stop play requested");
     m_playState.TransitionTo(AVPlayState::Stopped);
-    m_bNeedStop.store(true);
-    CoreServerGlobal::Instance().GetThreadPool().StopDedicatedThread(m_threadId);
+    StopPipelineThreads();
     SDL_Delay(20);
 }
 
+void VideoPlayWorker::StopPipelineThreads()
+{
+    if (!m_bHasPipelineThreads)
+    {
+        return;
+    }
+
+    // 中止队列唤醒在队列上等待的线程
+    m_bNeedStop.store(true);
+    m_packetQueue.Abort();
+    m_frameQueue.Abort();
+
+    auto& threadPool = CoreServerGlobal::Instance().GetThreadPool();
+    threadPool.StopDedicatedThread(m_demuxThreadId);
+    threadPool.StopDedicatedThread(m_decodeThreadId);
+    threadPool.StopDedicatedThread(m_threadId);
+    m_bHasPipelineThreads = false;
+
+    ST_VideoPipelineMetrics metrics = GetPipelineMetrics();
+    LOG_INFO("Video pipeline stopped - decoded: " + std::to_string(metrics.m_decodedFrames) + ", presented: " + std::to_string(metrics.m_presentedFrames) + ", dropped: " + std::to_string(metrics.m_droppedFrames) + ", replaced: " + std::to_string(metrics.m_replacedFrames) + ", packet queue underruns: " + std::to_string(metrics.m_packetQueueUnderruns) + ", frame queue underruns: " + std::to_string(metrics.m_frameQueueUnderruns));
+}
+
 void VideoPlayWorker::SlotPausePlay()
 {
     if (m_playState.GetCurrentState() == AVPlayState::Playing)
     {
         m_playState.TransitionTo(AVPlayState::Paused);
+        std::lock_guard<std::mutex> lock(m_clockMutex);
         m_pauseStartTime = av_gettime();
         LOG_INFO("Video playback paused");
     }
@@ -113,6 +167,7 @@ void VideoPlayWorker::SlotResumePlay()
         m_playState.TransitionTo(AVPlayState::Playing);
 
         // 累计暂停时间
+        std::lock_guard<std::mutex> lock(m_clockMutex);
         if (m_pauseStartTime > 0)
         {
             m_totalPauseTime += (av_gettime() - m_pauseStartTime);
@@ -122,7 +177,7 @@ void VideoPlayWorker::SlotResumePlay()
     }
 }
 
-void VideoPlayWorker::SlotSeekPlay(double seconds)
+void VideoPlayWorker::SlotSeekPlay(double seconds, bool bAccurate)
 {
     LOG_INFO("Video seek requested to: " + std::to_string(seconds) + " seconds");
 
@@ -131,132 +186,354 @@ void VideoPlayWorker::SlotSeekPlay(double seconds)
 
     if (seconds >= 0.0 && seconds <= duration)
     {
+        // 播放线程只处理最新的目标，尚未处理的旧请求被覆盖
         m_seekTarget.store(seconds);
+        m_bSeekAccurate.store(bAccurate);
         m_bSeekRequested.store(true);
     }
 }
 
 
-void VideoPlayWorker::PlayLoop()
+void VideoPlayWorker::DemuxLoop()
 {
-    LOG_INFO("Video playback loop started");
+    LOG_INFO("Video demux loop started");
 
-    const int MAX_CONSECUTIVE_ERRORS = 10;
-    int consecutiveErrors = 0;
+    bool bInputEOF = false;
     while (!m_bNeedStop.load())
     {
-        // 处理SDL事件
-        m_sdlManager->ProcessEvents();
+        if (m_bSeekRequested.load())
+        {
+            ProcessSeekRequest();
+            bInputEOF = false;
+            continue;
+        }
 
-        // 如果处于暂停状态，等待恢复
-        if (m_playState.GetCurrentState() == AVPlayState::Paused)
+        // 文件读完后等待seek或停止
+        if (bInputEOF)
         {
-            SDL_Delay(10); // 10ms延迟避免CPU占用过高
+            SDL_Delay(QUEUE_WAIT_TIMEOUT_MS);
             continue;
         }
 
-        bool frameProcessed = false;
+        ST_VideoPacketItem item;
+        item.m_serial = m_serial.load();
+        if (!item.m_packet.ReadPacket(m_pFormatCtx->GetRawContext()))
+        {
+            // 文件结束（读取出错同样视为结束），通知解码线程取出剩余的帧
+            LOG_INFO("End of file reached");
+            bInputEOF = true;
+            item.m_bEOF = true;
+            PushPacket(item);
+            continue;
+        }
 
-        // 处理跳转请求
-        static bool bSeekFirstFrame = false;
-        static double seekTargetTime = 0.0;
-        
-        if (m_bSeekRequested.load())
+        // 音频包跳过（由AudioFFmpegPlayer处理）
+        if (item.m_packet.GetStreamIndex() != m_videoStreamIndex)
         {
-            if (!m_pFormatCtx || !m_pVideoCodecCtx)
-            {
-                m_bSeekRequested.store(false);
-                bSeekFirstFrame = false;
-                continue;
-            }
+            continue;
+        }
 
-            seekTargetTime = m_seekTarget.load();
-            int64_t timestamp = static_cast<int64_t>(seekTargetTime * AV_TIME_BASE);
+        PushPacket(item);
+    }
 
-            LOG_INFO("VideoPlayWorker::PlayLoop - Processing seek request to: " + std::to_string(seekTargetTime) + " seconds");
-            
-            if (m_pFormatCtx->SeekFrame(-1, timestamp, AVSEEK_FLAG_BACKWARD))
-            {
-                // 清空解码器缓冲
-                if (m_pVideoCodecCtx)
-                {
-                    m_pVideoCodecCtx->FlushBuffer();
-                }
-                m_currentTime = seekTargetTime;
-                m_startTime = av_gettime();
-                m_totalPauseTime = 0;
-                bSeekFirstFrame = true; // 标记需要跳过早期帧
-
-                // 重置音视频同步器状态
-                if (m_videoAudioSync)
-                {
-                    m_videoAudioSync->Reset();
-                }
-
-                LOG_INFO("VideoPlayWorker::PlayLoop - Seek completed, time reset to: " + std::to_string(seekTargetTime) + " seconds");
-            }
-            else
+    LOG_INFO("Video demux loop stopped");
+}
+
+void VideoPlayWorker::ProcessSeekRequest()
+{
+    // 先清除请求标记，处理期间到达的新请求会在下一轮处理，旧目标被覆盖
+    m_bSeekRequested.store(false);
+    double seekTargetTime = m_seekTarget.load();
+    bool bAccurate = m_bSeekAccurate.load();
+    int64_t timestamp = static_cast<int64_t>(seekTargetTime * AV_TIME_BASE);
+
+    LOG_INFO("VideoPlayWorker::ProcessSeekRequest - Processing seek request to: " + std::to_string(seekTargetTime) + " seconds");
+
+    if (!m_pFormatCtx->SeekFrame(-1, timestamp, AVSEEK_FLAG_BACKWARD))
+    {
+        LOG_WARN("VideoPlayWorker::ProcessSeekRequest - Seek failed for target: " + std::to_string(seekTargetTime) + " seconds");
+        return;
+    }
+
+    // 递增播放序号后清空队列，解码线程和呈现线程丢弃旧序号的数据
+    int serial = m_serial.load() + 1;
+    m_serial.store(serial);
+    m_packetQueue.Clear();
+    m_frameQueue.Clear();
+
+    ST_VideoPacketItem flushItem;
+    flushItem.m_serial = serial;
+    flushItem.m_bFlush = true;
+    flushItem.m_skipUntilPTS = bAccurate ? seekTargetTime : -1.0;
+    PushPacket(flushItem);
+
+    LOG_INFO("VideoPlayWorker::ProcessSeekRequest - Seek completed, target: " + std::to_string(seekTargetTime) + " seconds");
+}
+
+bool VideoPlayWorker::PushPacket(ST_VideoPacketItem& item)
+{
+    while (!m_packetQueue.Push(item, QUEUE_WAIT_TIMEOUT_MS))
+    {
+        // 刷新标记必须送达，否则解码器不会清空旧数据
+        if (m_bNeedStop.load() || (m_bSeekRequested.load() && !item.m_bFlush))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VideoPlayWorker::DecodeLoop()
+{
+    LOG_INFO("Video decode loop started");
+
+    int decodeSerial = m_serial.load();
+    int consecutiveErrors = 0;
+    bool bInputEnded = false; // 已到文件结尾或解码失败过多，等待seek
+    while (!m_bNeedStop.load())
+    {
+        ST_VideoPacketItem item;
+        if (!m_packetQueue.Pop(item, QUEUE_WAIT_TIMEOUT_MS))
+        {
+            if (!bInputEnded && !m_bNeedStop.load())
             {
-                LOG_WARN("VideoPlayWorker::PlayLoop - Seek failed for target: " + std::to_string(seekTargetTime) + " seconds");
+                m_packetQueueUnderruns.fetch_add(1, std::memory_order_relaxed);
             }
-            m_bSeekRequested.store(false);
+            continue;
         }
 
-        // 读取数据包
+        if (item.m_bFlush)
         {
-            if (!m_pFormatCtx || !m_pVideoCodecCtx)
+            // 清空解码器缓冲，精确seek时从关键帧解码到目标位置
+            m_pVideoCodecCtx->FlushBuffer();
+            decodeSerial = item.m_serial;
+            m_skipUntilPTS = item.m_skipUntilPTS;
+            m_estimatedPTS = item.m_skipUntilPTS >= 0.0 ? item.m_skipUntilPTS : 0.0;
+            consecutiveErrors = 0;
+            bInputEnded = false;
+            continue;
+        }
+
+        if (item.m_serial != decodeSerial || bInputEnded)
+        {
+            continue;
+        }
+
+        if (item.m_bEOF)
+        {
+            // 取出解码器中剩余的帧，然后通知呈现线程播放结束
+            avcodec_send_packet(m_pVideoCodecCtx->GetRawContext(), nullptr);
+            ReceiveFrames(decodeSerial);
+            bInputEnded = true;
+        }
+        else if (item.m_packet.SendPacket(m_pVideoCodecCtx->GetRawContext()))
+        {
+            consecutiveErrors = 0;
+            ReceiveFrames(decodeSerial);
+            continue;
+        }
+        else
+        {
+            consecutiveErrors++;
+            if (consecutiveErrors < MAX_CONSECUTIVE_ERRORS)
             {
-                SDL_Delay(10);
                 continue;
             }
+            LOG_WARN("Too many consecutive errors, stopping playback");
+            bInputEnded = true;
+        }
+
+        ST_VideoFrameItem eofItem;
+        eofItem.m_serial = decodeSerial;
+        eofItem.m_bEOF = true;
+        PushFrame(eofItem);
+    }
+
+    LOG_INFO("Video decode loop stopped");
+}
+
+void VideoPlayWorker::ReceiveFrames(int serial)
+{
+    AVStream* videoStream = m_pFormatCtx->GetRawContext()->streams[m_videoStreamIndex];
+    double frameDuration = (m_videoInfo.m_frameRate > 0) ? 1.0 / m_videoInfo.m_frameRate : 0.0;
+
+    while (!m_bNeedStop.load() && m_pVideoFrame.GetCodecFrame(m_pVideoCodecCtx->GetRawContext()))
+    {
+        AVFrame* frame = m_pVideoFrame.GetRawFrame();
+
+        // 获取视频帧时间戳
+        int64_t timestamp = (frame->pts != AV_NOPTS_VALUE) ? frame->pts : frame->best_effort_timestamp;
+        double videoPTS = 0.0;
+        if (timestamp != AV_NOPTS_VALUE)
+        {
+            videoPTS = timestamp * av_q2d(videoStream->time_base);
+            m_estimatedPTS = videoPTS;
+        }
+        else
+        {
+            // 如果PTS无效，根据帧率估算
+            m_estimatedPTS += frameDuration;
+            videoPTS = m_estimatedPTS;
+        }
 
-            if (!m_pPacket.ReadPacket(m_pFormatCtx->GetRawContext()))
+        // 精确seek：从关键帧解码到目标位置，目标之前的帧不显示
+        if (m_skipUntilPTS >= 0.0)
+        {
+            if (videoPTS + frameDuration <= m_skipUntilPTS)
             {
-                // 文件结束
-                LOG_INFO("End of file reached");
-                break;
+                continue;
             }
+            LOG_INFO("First video frame after accurate seek: " + std::to_string(videoPTS) + " seconds, target: " + std::to_string(m_skipUntilPTS) + " seconds");
+            m_skipUntilPTS = -1.0;
         }
 
-        // 处理视频包
-        if (m_pPacket.GetStreamIndex() == m_videoStreamIndex)
+        m_decodedFrames.fetch_add(1, std::memory_order_relaxed);
+
+        ST_VideoFrameItem item;
+        item.m_pts = videoPTS;
+        item.m_duration = frameDuration;
+        item.m_serial = serial;
+        item.m_bKeyFrame = (frame->flags & AV_FRAME_FLAG_KEY) != 0;
+        av_frame_move_ref(item.m_frame.GetRawFrame(), frame);
+        if (!PushFrame(item))
+        {
+            return;
+        }
+    }
+}
+
+bool VideoPlayWorker::PushFrame(ST_VideoFrameItem& item)
+{
+    while (!m_frameQueue.Push(item, QUEUE_WAIT_TIMEOUT_MS))
+    {
+        if (m_bNeedStop.load() || item.m_serial != m_serial.load())
         {
-            if (DecodeVideoFrame())
+            return false;
+        }
+    }
+    return true;
+}
+
+void VideoPlayWorker::PlayLoop()
+{
+    LOG_INFO("Video playback loop started");
+
+    while (!m_bNeedStop.load())
+    {
+        // 暂停时不取帧；暂停中seek后只显示目标位置的一帧作为预览
+        bool bPaused = m_playState.GetCurrentState() == AVPlayState::Paused;
+        if (bPaused && m_presentSerial == m_serial.load())
+        {
+            SDL_Delay(QUEUE_WAIT_TIMEOUT_MS);
+            continue;
+        }
+
+        ST_VideoFrameItem item;
+        if (!m_frameQueue.Pop(item, QUEUE_WAIT_TIMEOUT_MS))
+        {
+            if (!m_bPresentEOF && !bPaused && !m_bNeedStop.load())
             {
-                frameProcessed = true;
-                consecutiveErrors = 0; // 重置错误计数
+                m_frameQueueUnderruns.fetch_add(1, std::memory_order_relaxed);
             }
+            continue;
         }
-        // 音频包跳过（由AudioFFmpegPlayer处理）
-        else if (m_pPacket.GetStreamIndex() == m_audioStreamIndex)
+
+        // 丢弃seek之前解码的帧
+        if (item.m_serial != m_serial.load())
         {
-            // 跳过音频包，因为音频播放由其他组件处理
-            frameProcessed = true; // 标记已处理避免错误计数
+            continue;
         }
 
-        m_pPacket.UnrefPacket();
+        if (item.m_serial != m_presentSerial)
+        {
+            ResetPresentClock(item);
+            if (bPaused && !item.m_bEOF)
+            {
+                RenderFrame(item.m_frame.GetRawFrame(), item.m_pts);
+                continue;
+            }
+        }
 
-        // 如果没有处理任何帧，增加错误计数
-        if (!frameProcessed)
+        if (item.m_bEOF)
         {
-            consecutiveErrors++;
-            if (consecutiveErrors >= MAX_CONSECUTIVE_ERRORS)
+            // 播放结束，等待seek或停止
+            if (!m_bPresentEOF)
             {
-                LOG_WARN("Too many consecutive errors, stopping playback");
-                break;
+                m_bPresentEOF = true;
+                m_bIsPlaying.store(false);
+                LOG_INFO("Video playback completed");
             }
+            continue;
+        }
+
+        PresentFrame(item);
+    }
 
-            // 短暂延迟避免CPU占用过高
-            SDL_Delay(1);
+    LOG_INFO("Video playback loop stopped");
+}
+
+void VideoPlayWorker::ResetPresentClock(const ST_VideoFrameItem& item)
+{
+    m_presentSerial = item.m_serial;
+    m_bPresentEOF = false;
+    m_clockBasePTS = item.m_pts;
+    {
+        std::lock_guard<std::mutex> lock(m_clockMutex);
+        m_startTime = av_gettime();
+        m_totalPauseTime = 0;
+        if (m_pauseStartTime > 0)
+        {
+            // 暂停中seek：暂停时间从新起点开始累计
+            m_pauseStartTime = m_startTime;
         }
     }
 
-    // 播放结束，设置状态，没有中途结束时
-    if (!m_bNeedStop.load())
+    // 重置音视频同步器状态
+    if (m_videoAudioSync)
     {
-        m_bIsPlaying.store(false);
+        m_videoAudioSync->Reset();
     }
-    LOG_INFO("Video playback completed");
+}
+
+void VideoPlayWorker::PresentFrame(ST_VideoFrameItem& item)
+{
+    AVFrame* frame = item.m_frame.GetRawFrame();
+
+    // 音视频同步处理
+    if (m_videoAudioSync && m_audioPlayer)
+    {
+        int syncResult = m_videoAudioSync->SyncVideoFrame(item.m_pts, item.m_bKeyFrame);
+        if (syncResult == 1)
+        {
+            // 跳过渲染，继续处理下一帧
+            LOG_DEBUG("The SyncResult is 1 ---------------------> Drop frame to display");
+            m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    else
+    {
+        // 无音频同步，按系统时钟等待；落后超过一帧且后续帧已就绪时丢弃
+        double delay = CalculateFrameDelay(item.m_pts);
+        if (delay < -item.m_duration && m_frameQueue.GetSize() > 0)
+        {
+            m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        double maxDelay = item.m_duration > 0.0 ? item.m_duration * 2.0 : 0.08; // 最大等待为2帧时间
+        if (delay > maxDelay)
+        {
+            delay = maxDelay;
+        }
+        if (delay > 0.0)
+        {
+            SDL_Delay(static_cast<Uint32>(delay * 1000));
+        }
+    }
+
+    RenderFrame(frame, item.m_pts);
+    m_presentedFrames.fetch_add(1, std::memory_order_relaxed);
 }
 
 ST_VideoFrameInfo VideoPlayWorker::GetVideoInfo()
@@ -273,6 +550,105 @@ void VideoPlayWorker::SetAudioPlayer(AudioFFmpegPlayer* audioPlayer)
     }
 }
 
+void VideoPlayWorker::SetQueueDepths(size_t packetQueueDepth, size_t frameQueueDepth)
+{
+    size_t packetDepth = packetQueueDepth;
+    if (packetDepth < MIN_PACKET_QUEUE_DEPTH)
+    {
+        packetDepth = MIN_PACKET_QUEUE_DEPTH;
+    }
+    else if (packetDepth > MAX_PACKET_QUEUE_DEPTH)
+    {
+        packetDepth = MAX_PACKET_QUEUE_DEPTH;
+    }
+
+    size_t frameDepth = frameQueueDepth;
+    if (frameDepth < MIN_FRAME_QUEUE_DEPTH)
+    {
+        frameDepth = MIN_FRAME_QUEUE_DEPTH;
+    }
+    else if (frameDepth > MAX_FRAME_QUEUE_DEPTH)
+    {
+        frameDepth = MAX_FRAME_QUEUE_DEPTH;
+    }
+
+    m_packetQueue.SetCapacity(packetDepth);
+    m_frameQueue.SetCapacity(frameDepth);
+    LOG_INFO("Video pipeline queue depths set - packets: " + std::to_string(packetDepth) + ", frames: " + std::to_string(frameDepth));
+}
+
+void VideoPlayWorker::SetDecodeThreadPolicy(const ST_DecodeThreadPolicy& policy)
+{
+    m_decodeThreadPolicy = policy;
+}
+
+void VideoPlayWorker::SetDecodeQualityHints(const ST_DecodeQualityHints& hints)
+{
+    m_decodeQualityHints = hints;
+}
+
+void VideoPlayWorker::RequestDisplaySize(int width, int height)
+{
+    m_requestedDisplayWidth.store(width);
+    m_requestedDisplayHeight.store(height);
+    m_bDisplaySizeChanged.store(true);
+}
+
+void VideoPlayWorker::ApplyDisplaySize()
+{
+    if (!m_bDisplaySizeChanged.exchange(false) || m_displayWidth <= 0 || m_displayHeight <= 0)
+    {
+        return;
+    }
+
+    // 转换目标取窗口尺寸，不超过视频源尺寸（放大交给渲染器）
+    int sourceWidth = static_cast<int>(m_videoInfo.m_width);
+    int sourceHeight = static_cast<int>(m_videoInfo.m_height);
+    int requestedWidth = m_requestedDisplayWidth.load();
+    int requestedHeight = m_requestedDisplayHeight.load();
+    int targetWidth = (requestedWidth > 0 && requestedWidth < sourceWidth) ? requestedWidth : sourceWidth;
+    int targetHeight = (requestedHeight > 0 && requestedHeight < sourceHeight) ? requestedHeight : sourceHeight;
+
+    // YUV420P/NV12色度平面宽高减半，缩放后的尺寸取偶数
+    if (m_displayPixelFormat != AV_PIX_FMT_RGB24)
+    {
+        if (targetWidth < sourceWidth)
+        {
+            targetWidth = (targetWidth & ~1) > 2 ? (targetWidth & ~1) : 2;
+        }
+        if (targetHeight < sourceHeight)
+        {
+            targetHeight = (targetHeight & ~1) > 2 ? (targetHeight & ~1) : 2;
+        }
+    }
+
+    if (targetWidth == m_displayWidth && targetHeight == m_displayHeight)
+    {
+        return;
+    }
+
+    // 目标尺寸不超过视频源尺寸，帧池按源尺寸分配的缓冲区足够，写入时按新尺寸排布
+    m_displayWidth = targetWidth;
+    m_displayHeight = targetHeight;
+    LOG_INFO("Video conversion target set to " + std::to_string(targetWidth) + "x" + std::to_string(targetHeight) + " (source " + std::to_string(sourceWidth) + "x" + std::to_string(sourceHeight) + ")");
+}
+
+ST_VideoPipelineMetrics VideoPlayWorker::GetPipelineMetrics() const
+{
+    ST_VideoPipelineMetrics metrics;
+    metrics.m_packetQueueSize = m_packetQueue.GetSize();
+    metrics.m_packetQueueCapacity = m_packetQueue.GetCapacity();
+    metrics.m_frameQueueSize = m_frameQueue.GetSize();
+    metrics.m_frameQueueCapacity = m_frameQueue.GetCapacity();
+    metrics.m_decodedFrames = m_decodedFrames.load();
+    metrics.m_presentedFrames = m_presentedFrames.load();
+    metrics.m_droppedFrames = m_droppedFrames.load();
+    metrics.m_replacedFrames = m_framePool.GetReplacedCount();
+    metrics.m_packetQueueUnderruns = m_packetQueueUnderruns.load();
+    metrics.m_frameQueueUnderruns = m_frameQueueUnderruns.load();
+    return metrics;
+}
+
 AVPixelFormat VideoPlayWorker::GetSafePixelFormat(AVPixelFormat format)
 {
     // 检查格式是否有效
@@ -313,6 +689,67 @@ AVPixelFormat VideoPlayWorker::GetSafePixelFormat(AVPixelFormat format)
     }
 }
 
+void VideoPlayWorker::SelectDisplayFormat(const AVCodecParameters* codecPar)
+{
+    m_displayPixelFormat = AV_PIX_FMT_RGB24;
+    m_textureFormat = SDL_PIXELFORMAT_RGB24;
+
+    // YUVJ420P与YUV420P平面布局相同，仅色彩范围不同，由纹理色彩空间区分
+    switch (m_videoInfo.m_pixelFormat)
+    {
+        case AV_PIX_FMT_YUV420P:
+        case AV_PIX_FMT_YUVJ420P:
+            if (m_sdlManager->IsTextureFormatSupported(SDL_PIXELFORMAT_IYUV))
+            {
+                m_displayPixelFormat = AV_PIX_FMT_YUV420P;
+                m_textureFormat = SDL_PIXELFORMAT_IYUV;
+            }
+            break;
+        case AV_PIX_FMT_NV12:
+            if (m_sdlManager->IsTextureFormatSupported(SDL_PIXELFORMAT_NV12))
+            {
+                m_displayPixelFormat = AV_PIX_FMT_NV12;
+                m_textureFormat = SDL_PIXELFORMAT_NV12;
+            }
+            break;
+        default:
+            break;
+    }
+
+    const char* sourceName = av_get_pix_fmt_name(m_videoInfo.m_pixelFormat);
+    if (m_textureFormat == SDL_PIXELFORMAT_RGB24)
+    {
+        LOG_INFO("Video display format: RGB24 via swscale (source " + std::string(sourceName ? sourceName : "unknown") + ")");
+    }
+    else
+    {
+        LOG_INFO("Video display format: " + std::string(SDL_GetPixelFormatName(m_textureFormat)) + " texture, colour conversion on the renderer (source " + std::string(sourceName ? sourceName : "unknown") + ")");
+    }
+}
+
+SDL_Colorspace VideoPlayWorker::GetTextureColorspace(const AVCodecParameters* codecPar) const
+{
+    bool bFullRange = codecPar->color_range == AVCOL_RANGE_JPEG || m_videoInfo.m_pixelFormat == AV_PIX_FMT_YUVJ420P;
+
+    AVColorSpace colorSpace = codecPar->color_space;
+    if (colorSpace == AVCOL_SPC_UNSPECIFIED)
+    {
+        // 未标注时按常见约定：高清及以上为BT.709，其余为BT.601
+        colorSpace = (codecPar->height >= 720) ? AVCOL_SPC_BT709 : AVCOL_SPC_BT470BG;
+    }
+
+    switch (colorSpace)
+    {
+        case AVCOL_SPC_BT709:
+            return bFullRange ? SDL_COLORSPACE_BT709_FULL : SDL_COLORSPACE_BT709_LIMITED;
+        case AVCOL_SPC_BT2020_NCL:
+        case AVCOL_SPC_BT2020_CL:
+            return bFullRange ? SDL_COLORSPACE_BT2020_FULL : SDL_COLORSPACE_BT2020_LIMITED;
+        default:
+            return bFullRange ? SDL_COLORSPACE_BT601_FULL : SDL_COLORSPACE_BT601_LIMITED;
+    }
+}
+
 SwsContext* VideoPlayWorker::CreateSafeSwsContext(AVPixelFormat srcFormat, AVPixelFormat dstFormat)
 {
     // 验证输入参数
@@ -417,12 +854,22 @@ bool VideoPlayWorker::InitPlayer(std::unique_ptr<ST_OpenFileResult> openFileResu
         return false;
     }
 
-    // 打开解码器
+    // 按线程策略和降质选项打开解码器，默认按CPU核数自动选择线程数
+    m_pVideoCodecCtx->SetThreadPolicy(m_decodeThreadPolicy);
+    m_pVideoCodecCtx->SetQualityHints(decoder.GetRawCodec(), m_decodeQualityHints);
     if (!m_pVideoCodecCtx->OpenCodec(decoder.GetRawCodec()))
     {
         return false;
     }
 
+    const AVCodecContext* rawCodecCtx = m_pVideoCodecCtx->GetRawContext();
+    std::string activeThreadType = (rawCodecCtx->active_thread_type & FF_THREAD_FRAME) ? "frame" : ((rawCodecCtx->active_thread_type & FF_THREAD_SLICE) ? "slice" : "none");
+    LOG_INFO("Video decoder opened with " + std::to_string(rawCodecCtx->thread_count) + " threads, threading: " + activeThreadType + (m_decodeThreadPolicy.m_bLowLatency ? ", low latency" : ""));
+    if (rawCodecCtx->lowres > 0)
+    {
+        LOG_INFO("Video decoder lowres level: " + std::to_string(rawCodecCtx->lowres));
+    }
+
     TimeSystem::Instance().StopTimingWithLog("VideoCodecSetup", EM_TimingLogLevel::Info);
 
     // 初始化视频信息
@@ -464,35 +911,6 @@ bool VideoPlayWorker::InitPlayer(std::unique_ptr<ST_OpenFileResult> openFileResu
     // 计算总帧数
     m_videoInfo.m_totalFrames = static_cast<int64_t>(m_videoInfo.m_duration * m_videoInfo.m_frameRate);
 
-    // 创建安全的图像转换上下文
-    TIME_START("VideoSwsCtxCreate");
-    m_pSwsCtx = CreateSafeSwsContext(m_videoInfo.m_pixelFormat, AV_PIX_FMT_RGB24);
-    if (!m_pSwsCtx)
-    {
-        LOG_ERROR("Failed to create swscale context");
-        return false;
-    }
-    TimeSystem::Instance().StopTimingWithLog("VideoSwsCtxCreate", EM_TimingLogLevel::Info);
-
-    // 为RGB帧分配缓冲区（线程安全）
-    int bufferSize = av_image_get_buffer_size(AV_PIX_FMT_RGB24, m_videoInfo.m_width, m_videoInfo.m_height, 1);
-    if (bufferSize <= 0)
-    {
-        LOG_WARN("Invalid buffer size: " + std::to_string(bufferSize));
-        return false;
-    }
-
-    // 确保缓冲区足够大（加锁保护）
-    m_rgbBuffer.resize(bufferSize);
-    int ret = av_image_fill_arrays(m_pRGBFrame.GetRawFrame()->data, m_pRGBFrame.GetRawFrame()->linesize, m_rgbBuffer.data(), AV_PIX_FMT_RGB24, m_videoInfo.m_width, m_videoInfo.m_height, 1);
-    if (ret < 0)
-    {
-        char errbuf[AV_ERROR_MAX_STRING_SIZE] = {0};
-        av_strerror(ret, errbuf, sizeof(errbuf));
-        LOG_WARN("Failed to fill RGB frame arrays: " + std::string(errbuf));
-        return false;
-    }
-
     // 使用SDLWindowManager创建窗口和渲染器
     if (parentWindowId != 0)
     {
@@ -513,8 +931,35 @@ bool VideoPlayWorker::InitPlayer(std::unique_ptr<ST_OpenFileResult> openFileResu
         }
     }
 
-    // 创建视频纹理
-    if (!m_sdlManager->CreateVideoTexture(m_videoInfo.m_width, m_videoInfo.m_height))
+    // 根据源格式和渲染器支持的纹理格式选择显示格式
+    SelectDisplayFormat(codecPar);
+
+    // 渲染器无法直接接收源格式时，创建安全的图像转换上下文
+    if (m_displayPixelFormat == AV_PIX_FMT_RGB24)
+    {
+        TIME_START("VideoSwsCtxCreate");
+        m_pSwsCtx = CreateSafeSwsContext(m_videoInfo.m_pixelFormat, AV_PIX_FMT_RGB24);
+        if (!m_pSwsCtx)
+        {
+            LOG_ERROR("Failed to create swscale context");
+            return false;
+        }
+        TimeSystem::Instance().StopTimingWithLog("VideoSwsCtxCreate", EM_TimingLogLevel::Info);
+    }
+
+    // 为显示帧池分配三块缓冲区，按视频源尺寸分配，缩小显示尺寸时复用同一块内存
+    if (!m_framePool.Init(m_displayPixelFormat, m_videoInfo.m_width, m_videoInfo.m_height))
+    {
+        LOG_WARN("Failed to allocate display frame pool: " + std::to_string(m_videoInfo.m_width) + "x" + std::to_string(m_videoInfo.m_height));
+        return false;
+    }
+    m_sdlManager->SetFrameSource(&m_framePool);
+    m_displayWidth = static_cast<int>(m_videoInfo.m_width);
+    m_displayHeight = static_cast<int>(m_videoInfo.m_height);
+
+    // 创建视频纹理，YUV纹理按视频流的色彩空间由渲染器转换
+    SDL_Colorspace colorspace = (m_textureFormat == SDL_PIXELFORMAT_RGB24) ? SDL_COLORSPACE_UNKNOWN : GetTextureColorspace(codecPar);
+    if (!m_sdlManager->CreateVideoTexture(m_videoInfo.m_width, m_videoInfo.m_height, m_textureFormat, colorspace))
     {
         LOG_ERROR("Failed to create SDL texture for video rendering");
         return false;
@@ -557,119 +1002,57 @@ bool VideoPlayWorker::InitPlayer(std::unique_ptr<ST_OpenFileResult> openFileResu
     return true;
 }
 
-bool VideoPlayWorker::DecodeVideoFrame()
+void VideoPlayWorker::RenderFrame(AVFrame* frame, double pts)
 {
-    if (!m_pVideoCodecCtx || m_bNeedStop.load())
-    {
-        return false;
-    }
-
-    // 发送数据包到解码器
-    if (!m_pPacket.SendPacket(m_pVideoCodecCtx->GetRawContext()))
-    {
-        return false;
-    }
-
-    // 接收解码后的视频帧
-    while (m_pVideoFrame.GetCodecFrame(m_pVideoCodecCtx->GetRawContext()))
-    {
-        AVFrame* frame = m_pVideoFrame.GetRawFrame();
-
-        // 获取视频帧时间戳
-        double videoPTS = 0.0;
-        if (frame->pts != AV_NOPTS_VALUE)
-        {
-            AVStream* videoStream = m_pFormatCtx->GetRawContext()->streams[m_videoStreamIndex];
-            videoPTS = frame->pts * av_q2d(videoStream->time_base);
-        }
-        else
-        {
-            // 如果PTS无效，根据帧率估算
-            static double estimatedPTS = 0.0;
-            if (m_videoInfo.m_frameRate > 0)
-            {
-                estimatedPTS += 1.0 / m_videoInfo.m_frameRate;
-            }
-            videoPTS = estimatedPTS;
-        }
-
-        // 检查是否为关键帧
-        bool isKeyFrame = (frame->flags & AV_FRAME_FLAG_KEY) != 0;
-
-        // 音视频同步处理
-        if (m_videoAudioSync && m_audioPlayer)
-        {
-            int syncResult = m_videoAudioSync->SyncVideoFrame(videoPTS, isKeyFrame);
-            switch (syncResult)
-            {
-                case 0: // 正常显示
-                    LOG_DEBUG("The SyncResult is 0 ---------------------> Normal display");
-                    RenderFrame(frame);
-                    break;
-                case 1: // 丢弃帧
-                    // 跳过渲染，继续解码下一帧
-                    LOG_DEBUG("The SyncResult is 1 ---------------------> Drop frame to display");
-                    continue;
-                case 2: // 等待后显示
-                    LOG_DEBUG("The SyncResult is 1 ---------------------> Wait frame to display");
-                    RenderFrame(frame);
-                    break;
-            }
-        }
-        else
-        {
-            // 无音频同步，使用原始延迟计算
-            RenderFrame(frame);
-
-            // 计算时间延迟
-            int delay = CalculateFrameDelay(frame->pts);
-            if (delay > 0)
-            {
-                SDL_Delay(delay);
-            }
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
-void VideoPlayWorker::RenderFrame(AVFrame* frame)
-{
-    if (!frame || !m_pSwsCtx || !m_sdlManager)
+    if (!frame || !m_sdlManager)
     {
         return;
     }
 
-    // 转换图像格式到RGB24（SDL纹理格式）
-    int ret = sws_scale(m_pSwsCtx, frame->data, frame->linesize, 0, m_videoInfo.m_height, m_pRGBFrame.GetRawFrame()->data, m_pRGBFrame.GetRawFrame()->linesize);
+    ApplyDisplaySize();
 
-    if (ret <= 0)
+    // 三块缓冲区中至多一块上传中、一块待上传，写入方总能取到空闲缓冲区
+    ST_VideoFrameBuffer* displayFrame = m_framePool.AcquireWrite(m_displayWidth, m_displayHeight);
+    if (!displayFrame)
     {
-        LOG_WARN("Failed to scale video frame");
+        LOG_WARN("No free display buffer for video frame");
         return;
     }
 
-    // 获取RGB帧数据
-    uint8_t* rgbData = m_pRGBFrame.GetRawFrame()->data[0];
-    float width = m_videoInfo.m_width;
-    float height = m_videoInfo.m_height;
-    int pitch = m_pRGBFrame.GetRawFrame()->linesize[0];
-    emit SigRenderFrameOnMainThread(rgbData, pitch, width, height);
-    // 更新当前时间
-    if (frame->pts != AV_NOPTS_VALUE)
+    AVPixelFormat frameFormat = static_cast<AVPixelFormat>(frame->format);
+    bool bDirect = m_displayPixelFormat != AV_PIX_FMT_RGB24 && (frameFormat == m_displayPixelFormat || (frameFormat == AV_PIX_FMT_YUVJ420P && m_displayPixelFormat == AV_PIX_FMT_YUV420P));
+    if (bDirect && frame->width == m_displayWidth && frame->height == m_displayHeight)
     {
-        AVStream* videoStream = m_pFormatCtx->GetRawContext()->streams[m_videoStreamIndex];
-        m_currentTime = frame->pts * av_q2d(videoStream->time_base);
+        // 源格式即纹理格式且无需缩放：只拷贝平面，颜色转换由渲染器完成
+        av_image_copy(displayFrame->m_data, displayFrame->m_linesize, reinterpret_cast<const uint8_t**>(frame->data), frame->linesize, m_displayPixelFormat, frame->width, frame->height);
     }
     else
     {
-        // 如果pts无效，根据帧率估算时间
-        m_currentTime += (1.0 / m_videoInfo.m_frameRate);
+        // 转换并缩放到显示尺寸，窗口小于视频源时只转换和上传显示所需的像素；参数未变时复用已有上下文
+        m_pSwsCtx = sws_getCachedContext(m_pSwsCtx, frame->width, frame->height, GetSafePixelFormat(frameFormat), m_displayWidth, m_displayHeight, m_displayPixelFormat, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!m_pSwsCtx)
+        {
+            m_framePool.CancelWrite(displayFrame);
+            return;
+        }
+
+        // 转换图像格式到显示格式（SDL纹理格式）
+        int ret = sws_scale(m_pSwsCtx, frame->data, frame->linesize, 0, frame->height, displayFrame->m_data, displayFrame->m_linesize);
+        if (ret <= 0)
+        {
+            LOG_WARN("Failed to scale video frame");
+            m_framePool.CancelWrite(displayFrame);
+            return;
+        }
     }
 
-    // 限制当前时间在合理范围内
+    // 发布新帧，尚未上传的旧帧被直接替换
+    displayFrame->m_pts = pts;
+    m_framePool.CommitWrite(displayFrame);
+    m_sdlManager->NotifyFrameReady();
+
+    // 更新当前时间，限制在合理范围内
+    m_currentTime = pts;
     if (m_currentTime < 0.0)
     {
         m_currentTime = 0.0;
@@ -680,51 +1063,21 @@ void VideoPlayWorker::RenderFrame(AVFrame* frame)
     }
 }
 
-int VideoPlayWorker::CalculateFrameDelay(int64_t pts)
+double VideoPlayWorker::CalculateFrameDelay(double framePTS)
 {
-    double frameRate = m_videoInfo.m_frameRate;
-    if (frameRate <= 0.0)
-    {
-        frameRate = 25.0;
-    }
-
-    if (pts == AV_NOPTS_VALUE)
-    {
-        return static_cast<int>(1000.0 / frameRate);
-    }
-
-    // 计算当前帧的时间戳
-    if (!m_pFormatCtx || m_videoStreamIndex < 0)
+    // 限制frameTime在合理范围内，避免异常时间戳导致长时间等待
+    if (framePTS < 0.0 || framePTS > m_videoInfo.m_duration + 10.0)
     {
-        return static_cast<int>(1000.0 / frameRate);
+        return 0.0;
     }
 
-    AVStream* videoStream = m_pFormatCtx->GetRawContext()->streams[m_videoStreamIndex];
-    double frameTime = pts * av_q2d(videoStream->time_base);
-
-    // 限制frameTime在合理范围内，避免seek后的异常延迟
-    if (frameTime < 0.0 || frameTime > m_videoInfo.m_duration + 10.0)
-    {
-        return static_cast<int>(1000.0 / frameRate);
-    }
-
-    // 计算已播放时间
+    // 呈现时钟：seek后以第一帧的显示时间为起点，扣除暂停时间
     int64_t currentTime = av_gettime();
-    double playedTime = (currentTime - m_startTime - m_totalPauseTime) / 1000000.0;
-
-    // 限制延迟时间在合理范围内，避免过长的等待
-    double delay = frameTime - playedTime;
-    double maxDelay = 1.0 / frameRate * 2.0; // 最大延迟为2帧时间
-    double minDelay = -0.1;                  // 允许少量负延迟来追赶
-
-    if (delay > maxDelay)
+    int64_t elapsedTime = 0;
     {
-        delay = maxDelay;
+        std::lock_guard<std::mutex> lock(m_clockMutex);
+        elapsedTime = currentTime - m_startTime - m_totalPauseTime;
     }
-    else if (delay < minDelay)
-    {
-        delay = 0; // 如果落后太多，立即显示
-    }
-
-    return static_cast<int>(delay * 1000); // 转换为毫秒
+    double playedTime = m_clockBasePTS + elapsedTime / 1000000.0;
+    return framePTS - playedTime;
 }
@@ -8,9 +8,11 @@
 #include "SDLWindowManager.h"
 #include "VideoAudioSync.h"
 #include "BaseDataDefine/ST_AVCodecContext.h"
+#include "BaseDataDefine/ST_BoundedQueue.h"
 #include "BaseDataDefine/ST_AVFormatContext.h"
 #include "BaseDataDefine/ST_AVFrame.h"
 #include "BaseDataDefine/ST_AVPacket.h"
+#include "BaseDataDefine/ST_VideoFramePool.h"
 #include "DataDefine/ST_AVPlayState.h"
 #include "DataDefine/ST_OpenFileResult.h"
 #include "DataDefine/ST_SDL_Renderer.h"
@@ -73,6 +75,48 @@ struct ST_VideoFrameInfo
     std::string m_filePath;
 };
 
+/// <summary>
+/// 解复用线程交给解码线程的数据包
+/// </summary>
+struct ST_VideoPacketItem
+{
+    ST_AVPacket m_packet;         /// 视频数据包
+    int m_serial{0};              /// 播放序号，每次seek递增，用于丢弃过期数据
+    bool m_bFlush{false};         /// seek后的刷新标记：解码线程据此清空解码器缓冲
+    bool m_bEOF{false};           /// 文件结束标记：解码线程据此取出解码器中剩余的帧
+    double m_skipUntilPTS{-1.0};  /// 刷新标记携带的精确seek目标，之前的帧不显示，小于0表示不丢弃
+};
+
+/// <summary>
+/// 解码线程交给呈现线程的视频帧
+/// </summary>
+struct ST_VideoFrameItem
+{
+    ST_AVFrame m_frame;           /// 解码后的视频帧
+    double m_pts{0.0};            /// 显示时间（秒）
+    double m_duration{0.0};       /// 帧时长（秒）
+    int m_serial{0};              /// 播放序号
+    bool m_bKeyFrame{false};      /// 是否为关键帧
+    bool m_bEOF{false};           /// 播放结束标记
+};
+
+/// <summary>
+/// 视频播放流水线统计
+/// </summary>
+struct ST_VideoPipelineMetrics
+{
+    size_t m_packetQueueSize{0};          /// 数据包队列当前长度
+    size_t m_packetQueueCapacity{0};      /// 数据包队列容量
+    size_t m_frameQueueSize{0};           /// 视频帧队列当前长度
+    size_t m_frameQueueCapacity{0};       /// 视频帧队列容量
+    uint64_t m_decodedFrames{0};          /// 已解码的帧数
+    uint64_t m_presentedFrames{0};        /// 已呈现的帧数
+    uint64_t m_droppedFrames{0};          /// 因落后于时钟而丢弃的帧数
+    uint64_t m_replacedFrames{0};         /// 已转换但被更新的帧替换、未上传到纹理的帧数
+    uint64_t m_packetQueueUnderruns{0};   /// 解码线程等待数据包（队列为空）的次数
+    uint64_t m_frameQueueUnderruns{0};    /// 呈现线程等待视频帧（队列为空）的次数
+};
+
 /// <summary>
 /// 视频播放工作线程
 /// </summary>
@@ -117,6 +161,31 @@ class VideoPlayWorker : public QObject
     /// <param name="audioPlayer">音频播放器实例</param>
     void SetAudioPlayer(AudioFFmpegPlayer* audioPlayer);
 
+    /// <summary>
+    /// 设置流水线队列深度，超出范围时自动截断，播放中调用立即生效
+    /// </summary>
+    /// <param name="packetQueueDepth">数据包队列深度（个）</param>
+    /// <param name="frameQueueDepth">视频帧队列深度（帧）</param>
+    void SetQueueDepths(size_t packetQueueDepth, size_t frameQueueDepth);
+
+    /// <summary>
+    /// 获取流水线统计，可在任意线程调用
+    /// </summary>
+    /// <returns>流水线统计</returns>
+    ST_VideoPipelineMetrics GetPipelineMetrics() const;
+
+    /// <summary>
+    /// 设置视频解码线程策略，在下次InitPlayer打开解码器时生效
+    /// </summary>
+    /// <param name="policy">线程策略</param>
+    void SetDecodeThreadPolicy(const ST_DecodeThreadPolicy& policy);
+
+    /// <summary>
+    /// 设置解码降质选项（用于预览），在下次InitPlayer打开解码器时生效
+    /// </summary>
+    /// <param name="hints">降质选项</param>
+    void SetDecodeQualityHints(const ST_DecodeQualityHints& hints);
+
 public slots:
     /// <summary>
     /// 开始播放
@@ -142,7 +211,8 @@ public slots:
     /// 跳转播放位置
     /// </summary>
     /// <param name="seconds">目标时间（秒）</param>
-    void SlotSeekPlay(double seconds);
+    /// <param name="bAccurate">是否精确定位，否则显示目标前的关键帧（用于拖动预览）</param>
+    void SlotSeekPlay(double seconds, bool bAccurate = true);
 
 signals:
     /// <summary>
@@ -155,50 +225,94 @@ signals:
     /// </summary>
     void SigSDLWindowClosed();
     /// <summary>
-    /// 提交给主线程渲染帧信号
-    /// </summary>
-    /// <param name="rgbData"></param>
-    /// <param name="pitch"></param>
-    /// <param name="width"></param>
-    /// <param name="height"></param>
-    void SigRenderFrameOnMainThread(const uint8_t* rgbData, int pitch, float width, float height);
-    /// <summary>
     /// resize播放窗口
     /// </summary>
     /// <param name="width"></param>
     /// <param name="height"></param>
     void SigSDLWindowsResize(int width, int height);
+    /// <summary>
+    /// 显示/隐藏播放窗口
+    /// </summary>
+    /// <param name="bShow">是否显示</param>
+    void SigSDLWindowsShow(bool bShow);
 private:
     /// <summary>
-    /// 播放循环
+    /// 解复用循环：读取视频数据包写入数据包队列，处理seek请求
+    /// </summary>
+    void DemuxLoop();
+
+    /// <summary>
+    /// 解码循环：从数据包队列取包解码，解码后的帧写入视频帧队列
+    /// </summary>
+    void DecodeLoop();
+
+    /// <summary>
+    /// 播放循环（呈现线程）：按时钟从视频帧队列取帧显示，落后的帧丢弃
     /// </summary>
     void PlayLoop();
+
     /// <summary>
-    /// SDL窗口管理器
+    /// 在解复用线程中执行seek：定位文件、递增播放序号、清空队列并通知解码线程刷新
     /// </summary>
-    std::unique_ptr<SDLWindowManager> m_sdlManager;
+    void ProcessSeekRequest();
+
+    /// <summary>
+    /// 写入数据包队列，队列满时等待，停止或有新的seek请求时放弃
+    /// </summary>
+    /// <param name="item">数据包</param>
+    /// <returns>是否写入成功</returns>
+    bool PushPacket(ST_VideoPacketItem& item);
+
+    /// <summary>
+    /// 写入视频帧队列，队列满时等待，停止或播放序号已变化时放弃
+    /// </summary>
+    /// <param name="item">视频帧</param>
+    /// <returns>是否写入成功</returns>
+    bool PushFrame(ST_VideoFrameItem& item);
+
+    /// <summary>
+    /// 取出解码器中已解码的帧，丢弃精确seek目标之前的帧，其余写入视频帧队列
+    /// </summary>
+    /// <param name="serial">这些帧所属的播放序号</param>
+    void ReceiveFrames(int serial);
+
+    /// <summary>
+    /// 呈现一帧：与音频时钟同步或按系统时钟等待后渲染，落后太多时丢弃
+    /// </summary>
+    /// <param name="item">视频帧</param>
+    void PresentFrame(ST_VideoFrameItem& item);
 
+    /// <summary>
+    /// 以该帧为起点重新建立呈现时钟（seek后或首次播放）
+    /// </summary>
+    /// <param name="item">新播放序号的第一帧</param>
+    void ResetPresentClock(const ST_VideoFrameItem& item);
 
     /// <summary>
-    /// 解码视频帧
+    /// 停止解复用、解码和呈现线程
     /// </summary>
-    /// <returns>是否成功解码到帧</returns>
-    bool DecodeVideoFrame();
+    void StopPipelineThreads();
+
+    /// <summary>
+    /// SDL窗口管理器
+    /// </summary>
+    std::unique_ptr<SDLWindowManager> m_sdlManager;
 
     /// <summary>
     /// 渲染视频帧
     /// </summary>
-    /// <param name="frameInfo">视频帧信息</param>
-    void RenderFrame(AVFrame* frame);
+    /// <param name="frame">视频帧</param>
+    /// <param name="pts">显示时间（秒）</param>
+    void RenderFrame(AVFrame* frame, double pts);
 
     // 音频相关方法已移除，音频播放由AudioFFmpegPlayer处理
 
     /// <summary>
-    /// 计算帧时间延迟
+    /// 按系统时钟计算帧的等待时间
     /// </summary>
-    /// <param name="pts">帧的时间戳</param>
-    /// <returns>延迟时间（毫秒）</returns>
-    int CalculateFrameDelay(int64_t pts);
+    /// <param name="framePTS">帧的显示时间（秒）</param>
+    /// <returns>等待时间（秒），负值表示已落后于时钟</returns>
+    double CalculateFrameDelay(double framePTS);
 
     /// <summary>
     /// 创建安全的图像转换上下文
@@ -208,6 +322,31 @@ private:
     /// <returns>转换上下文指针，失败返回nullptr</returns>
     SwsContext* CreateSafeSwsContext(AVPixelFormat srcFormat, AVPixelFormat dstFormat);
 
+    /// <summary>
+    /// 记录新的显示尺寸，由呈现线程在下一帧转换前应用（主线程调用）
+    /// </summary>
+    /// <param name="width">窗口宽度</param>
+    /// <param name="height">窗口高度</param>
+    void RequestDisplaySize(int width, int height);
+
+    /// <summary>
+    /// 在呈现线程中应用新的显示尺寸：转换目标取窗口尺寸，不超过视频源尺寸
+    /// </summary>
+    void ApplyDisplaySize();
+
+    /// <summary>
+    /// 选择显示格式：YUV420P/NV12源且渲染器支持对应YUV纹理时直接上传，由渲染器完成颜色转换，否则用swscale转换为RGB24
+    /// </summary>
+    /// <param name="codecPar">视频流参数</param>
+    void SelectDisplayFormat(const AVCodecParameters* codecPar);
+
+    /// <summary>
+    /// 根据视频流的色彩空间和色彩范围得到YUV纹理的SDL色彩空间
+    /// </summary>
+    /// <param name="codecPar">视频流参数</param>
+    /// <returns>SDL色彩空间</returns>
+    SDL_Colorspace GetTextureColorspace(const AVCodecParameters* codecPar) const;
+
     /// <summary>
     /// 获取安全的像素格式
     /// </summary>
@@ -230,6 +369,16 @@ private:
     /// 视频解码器上下文
     /// </summary>
     std::unique_ptr<ST_AVCodecContext> m_pVideoCodecCtx = nullptr;
+    /// <summary>
+    /// 视频解码线程策略
+    /// </summary>
+    ST_DecodeThreadPolicy m_decodeThreadPolicy;
+
+    /// <summary>
+    /// 视频解码降质选项
+    /// </summary>
+    ST_DecodeQualityHints m_decodeQualityHints;
+
     /// <summary>
     /// 视频流索引
     /// </summary>
@@ -241,19 +390,44 @@ private:
     int m_audioStreamIndex = -1;
 
     /// <summary>
-    /// 数据包
+    /// 解码线程接收解码结果的视频帧
     /// </summary>
-    ST_AVPacket m_pPacket;
+    ST_AVFrame m_pVideoFrame;
 
     /// <summary>
-    /// 视频帧
+    /// 显示像素格式：RGB24需经swscale转换，YUV420P/NV12直接拷贝平面
     /// </summary>
-    ST_AVFrame m_pVideoFrame;
+    AVPixelFormat m_displayPixelFormat = AV_PIX_FMT_RGB24;
+
+    /// <summary>
+    /// 显示像素格式对应的SDL纹理格式
+    /// </summary>
+    SDL_PixelFormat m_textureFormat = SDL_PIXELFORMAT_RGB24;
+
+    /// <summary>
+    /// 转换目标宽度（仅呈现线程访问）
+    /// </summary>
+    int m_displayWidth = 0;
 
     /// <summary>
-    /// RGB帧
+    /// 转换目标高度（仅呈现线程访问）
     /// </summary>
-    ST_AVFrame m_pRGBFrame;
+    int m_displayHeight = 0;
+
+    /// <summary>
+    /// 主线程请求的显示宽度，0表示使用视频源尺寸
+    /// </summary>
+    std::atomic<int> m_requestedDisplayWidth = 0;
+
+    /// <summary>
+    /// 主线程请求的显示高度，0表示使用视频源尺寸
+    /// </summary>
+    std::atomic<int> m_requestedDisplayHeight = 0;
+
+    /// <summary>
+    /// 显示尺寸是否有待应用的变化
+    /// </summary>
+    std::atomic<bool> m_bDisplaySizeChanged = false;
 
     /// <summary>
     /// 图像转换上下文
@@ -297,6 +471,11 @@ private:
     /// </summary>
     int64_t m_totalPauseTime = 0;
 
+    /// <summary>
+    /// 保护m_startTime、m_pauseStartTime和m_totalPauseTime：暂停/恢复在Qt线程写入，seek后在呈现线程重置
+    /// </summary>
+    std::mutex m_clockMutex;
+
     /// <summary>
     /// 当前播放时间
     /// </summary>
@@ -308,9 +487,9 @@ private:
     bool m_bHasAudio = false;
 
     /// <summary>
-    /// RGB帧缓冲区
+    /// 显示帧池：呈现线程写入转换后的帧，SDL窗口所在的Qt线程上传纹理后归还
     /// </summary>
-    std::vector<uint8_t> m_rgbBuffer;
+    ST_VideoFramePool m_framePool;
 
     /// <summary>
     /// 是否请求seek操作
@@ -322,6 +501,67 @@ private:
     /// </summary>
     std::atomic<double> m_seekTarget = 0.0;
 
+    /// <summary>
+    /// 是否精确seek（丢弃目标之前的帧），否则从关键帧直接显示
+    /// </summary>
+    std::atomic<bool> m_bSeekAccurate = true;
+
+    /// <summary>
+    /// 精确seek后丢弃该时间之前的帧，小于0表示不丢弃（仅解码线程访问）
+    /// </summary>
+    double m_skipUntilPTS = -1.0;
+
+    /// <summary>
+    /// PTS无效时按帧率估算的显示时间（仅解码线程访问）
+    /// </summary>
+    double m_estimatedPTS = 0.0;
+
+    static const size_t DEFAULT_PACKET_QUEUE_DEPTH{64};   /// 默认数据包队列深度
+    static const size_t DEFAULT_FRAME_QUEUE_DEPTH{4};     /// 默认视频帧队列深度
+    static const size_t MIN_PACKET_QUEUE_DEPTH{8};        /// 数据包队列深度下限
+    static const size_t MAX_PACKET_QUEUE_DEPTH{1024};     /// 数据包队列深度上限
+    static const size_t MIN_FRAME_QUEUE_DEPTH{2};         /// 视频帧队列深度下限
+    static const size_t MAX_FRAME_QUEUE_DEPTH{32};        /// 视频帧队列深度上限
+    static const int QUEUE_WAIT_TIMEOUT_MS{10};           /// 队列等待超时（毫秒），超时后检查停止和seek请求
+    static const int MAX_CONSECUTIVE_ERRORS{10};          /// 连续解码失败次数上限，超过后视为播放结束
+
+    /// <summary>
+    /// 解复用线程到解码线程的数据包队列
+    /// </summary>
+    ST_BoundedQueue<ST_VideoPacketItem> m_packetQueue{DEFAULT_PACKET_QUEUE_DEPTH};
+
+    /// <summary>
+    /// 解码线程到呈现线程的视频帧队列
+    /// </summary>
+    ST_BoundedQueue<ST_VideoFrameItem> m_frameQueue{DEFAULT_FRAME_QUEUE_DEPTH};
+
+    /// <summary>
+    /// 当前播放序号，每次seek递增，序号不同的数据包和帧被丢弃
+    /// </summary>
+    std::atomic<int> m_serial = 0;
+
+    /// <summary>
+    /// 呈现线程当前时钟对应的播放序号（仅呈现线程访问）
+    /// </summary>
+    int m_presentSerial = -1;
+
+    /// <summary>
+    /// 呈现时钟起点对应的帧显示时间（秒，仅呈现线程访问）
+    /// </summary>
+    double m_clockBasePTS = 0.0;
+
+    /// <summary>
+    /// 当前播放序号是否已呈现到结尾（仅呈现线程访问）
+    /// </summary>
+    bool m_bPresentEOF = false;
+
+    // 流水线统计
+    std::atomic<uint64_t> m_decodedFrames{0};           /// 已解码的帧数
+    std::atomic<uint64_t> m_presentedFrames{0};         /// 已呈现的帧数
+    std::atomic<uint64_t> m_droppedFrames{0};           /// 丢弃的帧数
+    std::atomic<uint64_t> m_packetQueueUnderruns{0};    /// 数据包队列欠载次数
+    std::atomic<uint64_t> m_frameQueueUnderruns{0};     /// 视频帧队列欠载次数
+
     /// <summary>
     /// 播放状态管理器
     /// </summary>
@@ -346,7 +586,22 @@ private:
     AudioFFmpegPlayer* m_audioPlayer = nullptr;
 
     /// <summary>
-    /// 线程信息
+    /// 呈现线程ID
+    /// </summary>
+    size_t m_threadId{0};
+
+    /// <summary>
+    /// 解复用线程ID
+    /// </summary>
+    size_t m_demuxThreadId{0};
+
+    /// <summary>
+    /// 解码线程ID
+    /// </summary>
+    size_t m_decodeThreadId{0};
+
+    /// <summary>
+    /// 是否已创建流水线线程
     /// </summary>
-    size_t m_threadId;
+    bool m_bHasPipelineThreads{false};
 };